@@ -112,6 +112,130 @@ pub const TRTX_ERROR_RUNTIME_ERROR: i32 = 3;
 pub const TRTX_ERROR_CUDA_ERROR: i32 = 4;
 pub const TRTX_ERROR_UNKNOWN: i32 = 99;
 
+// CUDA stream creation flags
+pub const TRTX_CUDA_STREAM_DEFAULT: i32 = 0;
+pub const TRTX_CUDA_STREAM_NON_BLOCKING: i32 = 1;
+
+pub const TRTX_CUDA_EVENT_DEFAULT: i32 = 0;
+pub const TRTX_CUDA_EVENT_BLOCKING_SYNC: i32 = 1;
+pub const TRTX_CUDA_EVENT_DISABLE_TIMING: i32 = 2;
+
+// Pinned host allocation flags
+pub const TRTX_CUDA_HOST_ALLOC_DEFAULT: i32 = 0;
+pub const TRTX_CUDA_HOST_ALLOC_PORTABLE: i32 = 1;
+pub const TRTX_CUDA_HOST_ALLOC_MAPPED: i32 = 2;
+pub const TRTX_CUDA_HOST_ALLOC_WRITE_COMBINED: i32 = 4;
+
+// Host registration flags
+pub const TRTX_CUDA_HOST_REGISTER_DEFAULT: i32 = 0;
+pub const TRTX_CUDA_HOST_REGISTER_PORTABLE: i32 = 1;
+pub const TRTX_CUDA_HOST_REGISTER_MAPPED: i32 = 2;
+pub const TRTX_CUDA_HOST_REGISTER_READ_ONLY: i32 = 8;
+
+// Tensor data types
+pub const TRTX_DATA_TYPE_FLOAT: i32 = 0;
+pub const TRTX_DATA_TYPE_HALF: i32 = 1;
+pub const TRTX_DATA_TYPE_INT8: i32 = 2;
+pub const TRTX_DATA_TYPE_INT32: i32 = 3;
+pub const TRTX_DATA_TYPE_BOOL: i32 = 4;
+pub const TRTX_DATA_TYPE_UINT8: i32 = 5;
+pub const TRTX_DATA_TYPE_FP8: i32 = 6;
+pub const TRTX_DATA_TYPE_BF16: i32 = 7;
+pub const TRTX_DATA_TYPE_INT64: i32 = 8;
+pub const TRTX_DATA_TYPE_INT4: i32 = 9;
+pub const TRTX_DATA_TYPE_FP4: i32 = 10;
+pub const TRTX_DATA_TYPE_E8M0: i32 = 11;
+
+// Tensor IO modes
+pub const TRTX_TENSOR_IO_MODE_NONE: i32 = 0;
+pub const TRTX_TENSOR_IO_MODE_INPUT: i32 = 1;
+pub const TRTX_TENSOR_IO_MODE_OUTPUT: i32 = 2;
+
+// Tensor memory layouts
+pub const TRTX_TENSOR_FORMAT_LINEAR: i32 = 0;
+pub const TRTX_TENSOR_FORMAT_CHW2: i32 = 1;
+pub const TRTX_TENSOR_FORMAT_HWC8: i32 = 2;
+pub const TRTX_TENSOR_FORMAT_CHW4: i32 = 3;
+pub const TRTX_TENSOR_FORMAT_CHW16: i32 = 4;
+pub const TRTX_TENSOR_FORMAT_CHW32: i32 = 5;
+pub const TRTX_TENSOR_FORMAT_DHWC8: i32 = 6;
+pub const TRTX_TENSOR_FORMAT_CDHW32: i32 = 7;
+pub const TRTX_TENSOR_FORMAT_HWC: i32 = 8;
+pub const TRTX_TENSOR_FORMAT_DLA_LINEAR: i32 = 9;
+pub const TRTX_TENSOR_FORMAT_DLA_HWC4: i32 = 10;
+pub const TRTX_TENSOR_FORMAT_HWC16: i32 = 11;
+pub const TRTX_TENSOR_FORMAT_DHWC: i32 = 12;
+
+// Optimization profile shape selectors
+pub const TRTX_PROFILE_MIN: i32 = 0;
+pub const TRTX_PROFILE_OPT: i32 = 1;
+pub const TRTX_PROFILE_MAX: i32 = 2;
+
+pub const TRTX_ALLOCATION_STRATEGY_STATIC: i32 = 0;
+pub const TRTX_ALLOCATION_STRATEGY_ON_PROFILE_CHANGE: i32 = 1;
+pub const TRTX_ALLOCATION_STRATEGY_USER_MANAGED: i32 = 2;
+
+// Builder flags
+pub const TRTX_BUILDER_FLAG_FP16: i32 = 0;
+pub const TRTX_BUILDER_FLAG_INT8: i32 = 1;
+pub const TRTX_BUILDER_FLAG_DEBUG: i32 = 2;
+pub const TRTX_BUILDER_FLAG_GPU_FALLBACK: i32 = 3;
+pub const TRTX_BUILDER_FLAG_REFIT: i32 = 4;
+pub const TRTX_BUILDER_FLAG_DISABLE_TIMING_CACHE: i32 = 5;
+pub const TRTX_BUILDER_FLAG_TF32: i32 = 6;
+pub const TRTX_BUILDER_FLAG_SPARSE_WEIGHTS: i32 = 7;
+pub const TRTX_BUILDER_FLAG_OBEY_PRECISION_CONSTRAINTS: i32 = 9;
+pub const TRTX_BUILDER_FLAG_PREFER_PRECISION_CONSTRAINTS: i32 = 10;
+pub const TRTX_BUILDER_FLAG_DIRECT_IO: i32 = 11;
+pub const TRTX_BUILDER_FLAG_REJECT_EMPTY_ALGORITHMS: i32 = 12;
+pub const TRTX_BUILDER_FLAG_VERSION_COMPATIBLE: i32 = 13;
+pub const TRTX_BUILDER_FLAG_EXCLUDE_LEAN_RUNTIME: i32 = 14;
+pub const TRTX_BUILDER_FLAG_FP8: i32 = 15;
+pub const TRTX_BUILDER_FLAG_ERROR_ON_TIMING_CACHE_MISS: i32 = 16;
+pub const TRTX_BUILDER_FLAG_BF16: i32 = 17;
+pub const TRTX_BUILDER_FLAG_DISABLE_COMPILATION_CACHE: i32 = 18;
+pub const TRTX_BUILDER_FLAG_STRIP_PLAN: i32 = 19;
+pub const TRTX_BUILDER_FLAG_REFIT_IDENTICAL: i32 = 20;
+pub const TRTX_BUILDER_FLAG_WEIGHT_STREAMING: i32 = 21;
+pub const TRTX_BUILDER_FLAG_INT4: i32 = 22;
+pub const TRTX_BUILDER_FLAG_REFIT_INDIVIDUAL: i32 = 23;
+pub const TRTX_BUILDER_FLAG_STRICT_NANS: i32 = 24;
+pub const TRTX_BUILDER_FLAG_MONITOR_MEMORY: i32 = 25;
+pub const TRTX_BUILDER_FLAG_FP4: i32 = 26;
+pub const TRTX_BUILDER_FLAG_EDITABLE_TIMING_CACHE: i32 = 27;
+
+// Tactic source bit positions
+pub const TRTX_TACTIC_SOURCE_CUBLAS: i32 = 0;
+pub const TRTX_TACTIC_SOURCE_CUBLAS_LT: i32 = 1;
+pub const TRTX_TACTIC_SOURCE_CUDNN: i32 = 2;
+pub const TRTX_TACTIC_SOURCE_EDGE_MASK_CONVOLUTIONS: i32 = 3;
+pub const TRTX_TACTIC_SOURCE_JIT_CONVOLUTIONS: i32 = 4;
+
+// Hardware compatibility levels
+pub const TRTX_HARDWARE_COMPATIBILITY_NONE: i32 = 0;
+pub const TRTX_HARDWARE_COMPATIBILITY_AMPERE_PLUS: i32 = 1;
+pub const TRTX_HARDWARE_COMPATIBILITY_SAME_COMPUTE_CAPABILITY: i32 = 2;
+
+// Compute capabilities an RTX engine can target
+pub const TRTX_COMPUTE_CAPABILITY_NONE: i32 = 0;
+pub const TRTX_COMPUTE_CAPABILITY_CURRENT: i32 = 1;
+pub const TRTX_COMPUTE_CAPABILITY_SM75: i32 = 75;
+pub const TRTX_COMPUTE_CAPABILITY_SM80: i32 = 80;
+pub const TRTX_COMPUTE_CAPABILITY_SM86: i32 = 86;
+pub const TRTX_COMPUTE_CAPABILITY_SM89: i32 = 89;
+pub const TRTX_COMPUTE_CAPABILITY_SM120: i32 = 120;
+
+pub const TRTX_PROFILING_VERBOSITY_LAYER_NAMES_ONLY: i32 = 0;
+pub const TRTX_PROFILING_VERBOSITY_NONE: i32 = 1;
+pub const TRTX_PROFILING_VERBOSITY_DETAILED: i32 = 2;
+
+pub const TRTX_LAYER_INFORMATION_FORMAT_ONELINE: i32 = 0;
+pub const TRTX_LAYER_INFORMATION_FORMAT_JSON: i32 = 1;
+pub const TRTX_TENSOR_LOCATION_DEVICE: i32 = 0;
+pub const TRTX_TENSOR_LOCATION_HOST: i32 = 1;
+
+pub const TRTX_MAX_DIMS: i32 = 8;
+
 // Logger severity levels
 #[repr(u32)]
 #[derive(Debug, Copy, Clone, PartialEq, Eq, Hash, PartialOrd, Ord)]
@@ -159,11 +283,82 @@ pub struct TrtxExecutionContext {
     _unused: [u8; 0],
 }
 
+#[repr(C)]
+pub struct TrtxHostMemory {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxCudaStream {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxOptimizationProfile {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxCudaEvent {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxTimingCache {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxRuntimeCache {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxProfiler {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxEngineInspector {
+    _unused: [u8; 0],
+}
+
 #[repr(C)]
 pub struct TrtxOnnxParser {
     _unused: [u8; 0],
 }
 
+#[repr(C)]
+pub struct TrtxRefitter {
+    _unused: [u8; 0],
+}
+
+#[repr(C)]
+pub struct TrtxParserRefitter {
+    _unused: [u8; 0],
+}
+
+// Tensor dimensions
+#[repr(C)]
+#[derive(Debug, Default, Copy, Clone)]
+pub struct TrtxDims {
+    pub nb_dims: i32,
+    pub d: [i64; 8usize],
+}
+
+// One tensor of trtx_execution_context_bind_and_enqueue
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct TrtxTensorBinding {
+    pub index: i32,
+    pub address: *mut ::std::os::raw::c_void,
+    pub shape: TrtxDims,
+    pub host_input: *const ::std::os::raw::c_void,
+    pub host_input_size: usize,
+    pub host_output: *mut ::std::os::raw::c_void,
+    pub host_output_size: usize,
+}
+
 // Logger callback type
 pub type TrtxLoggerCallback = ::std::option::Option<
     unsafe extern "C" fn(
@@ -173,8 +368,24 @@ pub type TrtxLoggerCallback = ::std::option::Option<
     ),
 >;
 
+// Profiler callback type
+pub type TrtxProfilerCallback = ::std::option::Option<
+    unsafe extern "C" fn(
+        user_data: *mut ::std::os::raw::c_void,
+        layer_name: *const ::std::os::raw::c_char,
+        ms: f32,
+    ),
+>;
+
+// Host callback type
+pub type TrtxHostFunc =
+    ::std::option::Option<unsafe extern "C" fn(user_data: *mut ::std::os::raw::c_void)>;
+
 // Stub implementations that return success
 extern "C" {
+    pub fn trtx_get_last_error() -> *const ::std::os::raw::c_char;
+    pub fn trtx_clear_last_error();
+
     pub fn trtx_logger_create(
         callback: TrtxLoggerCallback,
         user_data: *mut ::std::os::raw::c_void,
@@ -185,6 +396,13 @@ extern "C" {
 
     pub fn trtx_logger_destroy(logger: *mut TrtxLogger);
 
+    pub fn trtx_logger_set_min_severity(
+        logger: *mut TrtxLogger,
+        min_severity: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_builder_create(
         logger: *mut TrtxLogger,
         out_builder: *mut *mut TrtxBuilder,
@@ -213,12 +431,132 @@ extern "C" {
         builder: *mut TrtxBuilder,
         network: *mut TrtxNetworkDefinition,
         config: *mut TrtxBuilderConfig,
-        out_data: *mut *mut ::std::os::raw::c_void,
-        out_size: *mut usize,
+        out_memory: *mut *mut TrtxHostMemory,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_create_optimization_profile(
+        builder: *mut TrtxBuilder,
+        out_profile: *mut *mut TrtxOptimizationProfile,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_optimization_profile_set_dimensions(
+        profile: *mut TrtxOptimizationProfile,
+        input_name: *const ::std::os::raw::c_char,
+        selector: i32,
+        dims: *const TrtxDims,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_add_optimization_profile(
+        config: *mut TrtxBuilderConfig,
+        profile: *mut TrtxOptimizationProfile,
+        out_index: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_flag(
+        config: *mut TrtxBuilderConfig,
+        flag: i32,
+        enabled: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_get_flag(config: *mut TrtxBuilderConfig, flag: i32) -> i32;
+
+    pub fn trtx_builder_config_set_builder_optimization_level(
+        config: *mut TrtxBuilderConfig,
+        level: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_tactic_sources(
+        config: *mut TrtxBuilderConfig,
+        sources: u32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_max_aux_streams(
+        config: *mut TrtxBuilderConfig,
+        nb_streams: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_profiling_verbosity(
+        config: *mut TrtxBuilderConfig,
+        verbosity: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_hardware_compatibility_level(
+        config: *mut TrtxBuilderConfig,
+        level: i32,
         error_msg: *mut ::std::os::raw::c_char,
         error_msg_len: usize,
     ) -> i32;
 
+    pub fn trtx_builder_config_set_compute_capabilities(
+        config: *mut TrtxBuilderConfig,
+        capabilities: *const i32,
+        count: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_create_timing_cache(
+        config: *mut TrtxBuilderConfig,
+        blob: *const ::std::os::raw::c_void,
+        blob_size: usize,
+        out_cache: *mut *mut TrtxTimingCache,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_set_timing_cache(
+        config: *mut TrtxBuilderConfig,
+        cache: *mut TrtxTimingCache,
+        ignore_mismatch: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_builder_config_get_timing_cache(
+        config: *mut TrtxBuilderConfig,
+    ) -> *const TrtxTimingCache;
+
+    pub fn trtx_timing_cache_destroy(cache: *mut TrtxTimingCache);
+
+    pub fn trtx_timing_cache_serialize(
+        cache: *const TrtxTimingCache,
+        out_memory: *mut *mut TrtxHostMemory,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_timing_cache_combine(
+        cache: *mut TrtxTimingCache,
+        other: *const TrtxTimingCache,
+        ignore_mismatch: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_host_memory_data(memory: *mut TrtxHostMemory) -> *const ::std::os::raw::c_void;
+
+    pub fn trtx_host_memory_size(memory: *mut TrtxHostMemory) -> usize;
+
+    pub fn trtx_host_memory_destroy(memory: *mut TrtxHostMemory);
+
     pub fn trtx_builder_config_destroy(config: *mut TrtxBuilderConfig);
 
     pub fn trtx_builder_config_set_memory_pool_limit(
@@ -249,6 +587,14 @@ extern "C" {
         error_msg_len: usize,
     ) -> i32;
 
+    pub fn trtx_runtime_deserialize_cuda_engine_from_file(
+        runtime: *mut TrtxRuntime,
+        path: *const ::std::os::raw::c_char,
+        out_engine: *mut *mut TrtxCudaEngine,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_cuda_engine_destroy(engine: *mut TrtxCudaEngine);
 
     pub fn trtx_cuda_engine_create_execution_context(
@@ -258,6 +604,69 @@ extern "C" {
         error_msg_len: usize,
     ) -> i32;
 
+    pub fn trtx_cuda_engine_create_execution_context_with_strategy(
+        engine: *mut TrtxCudaEngine,
+        strategy: i32,
+        out_context: *mut *mut TrtxExecutionContext,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_create_execution_context_with_cache(
+        engine: *mut TrtxCudaEngine,
+        strategy: i32,
+        cache: *mut TrtxRuntimeCache,
+        out_context: *mut *mut TrtxExecutionContext,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_runtime_cache_create(
+        engine: *mut TrtxCudaEngine,
+        blob: *const ::std::os::raw::c_void,
+        blob_size: usize,
+        out_cache: *mut *mut TrtxRuntimeCache,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_runtime_cache_destroy(cache: *mut TrtxRuntimeCache);
+
+    pub fn trtx_runtime_cache_serialize(
+        cache: *const TrtxRuntimeCache,
+        out_memory: *mut *mut TrtxHostMemory,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_device_memory_size(
+        engine: *mut TrtxCudaEngine,
+        out_size: *mut i64,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_weight_streaming(
+        engine: *mut TrtxCudaEngine,
+        out_streamable_weights_size: *mut i64,
+        out_budget: *mut i64,
+        out_automatic_budget: *mut i64,
+        out_scratch_memory_size: *mut i64,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_set_weight_streaming_budget(
+        engine: *mut TrtxCudaEngine,
+        budget: i64,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_device_memory_size_for_profile(
+        engine: *mut TrtxCudaEngine,
+        profile_index: i32,
+        out_size: *mut i64,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_cuda_engine_get_tensor_name(
         engine: *mut TrtxCudaEngine,
         index: i32,
@@ -271,8 +680,156 @@ extern "C" {
         out_count: *mut i32,
     ) -> i32;
 
+    pub fn trtx_cuda_engine_get_tensor_shape(
+        engine: *mut TrtxCudaEngine,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_dims: *mut TrtxDims,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_tensor_data_type(
+        engine: *mut TrtxCudaEngine,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_data_type: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_tensor_io_mode(
+        engine: *mut TrtxCudaEngine,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_io_mode: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_tensor_format(
+        engine: *mut TrtxCudaEngine,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_format: *mut i32,
+        out_vectorized_dim: *mut i32,
+        out_components_per_element: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_tensor_bytes_per_component(
+        engine: *mut TrtxCudaEngine,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_bytes: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_nb_optimization_profiles(
+        engine: *mut TrtxCudaEngine,
+        out_count: *mut i32,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_profile_shape(
+        engine: *mut TrtxCudaEngine,
+        input_name: *const ::std::os::raw::c_char,
+        profile_index: i32,
+        selector: i32,
+        out_dims: *mut TrtxDims,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_engine_get_nb_layers(engine: *mut TrtxCudaEngine, out_count: *mut i32) -> i32;
+
+    pub fn trtx_cuda_engine_create_engine_inspector(
+        engine: *mut TrtxCudaEngine,
+        out_inspector: *mut *mut TrtxEngineInspector,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_engine_inspector_destroy(inspector: *mut TrtxEngineInspector);
+
+    pub fn trtx_engine_inspector_set_execution_context(
+        inspector: *mut TrtxEngineInspector,
+        context: *mut TrtxExecutionContext,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_engine_inspector_get_layer_information(
+        inspector: *mut TrtxEngineInspector,
+        layer_index: i32,
+        format: i32,
+        out_info: *mut *const ::std::os::raw::c_char,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_engine_inspector_get_engine_information(
+        inspector: *mut TrtxEngineInspector,
+        format: i32,
+        out_info: *mut *const ::std::os::raw::c_char,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_profiler_create(
+        callback: TrtxProfilerCallback,
+        user_data: *mut ::std::os::raw::c_void,
+        out_profiler: *mut *mut TrtxProfiler,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_profiler_destroy(profiler: *mut TrtxProfiler);
+
     pub fn trtx_execution_context_destroy(context: *mut TrtxExecutionContext);
 
+    pub fn trtx_execution_context_set_profiler(
+        context: *mut TrtxExecutionContext,
+        profiler: *mut TrtxProfiler,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_set_input_shape(
+        context: *mut TrtxExecutionContext,
+        input_name: *const ::std::os::raw::c_char,
+        dims: *const TrtxDims,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_get_tensor_shape(
+        context: *mut TrtxExecutionContext,
+        tensor_name: *const ::std::os::raw::c_char,
+        out_dims: *mut TrtxDims,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_set_optimization_profile_async(
+        context: *mut TrtxExecutionContext,
+        profile_index: i32,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_set_device_memory(
+        context: *mut TrtxExecutionContext,
+        memory: *mut ::std::os::raw::c_void,
+        size: i64,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_update_device_memory_size_for_shapes(
+        context: *mut TrtxExecutionContext,
+        out_size: *mut i64,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_execution_context_set_tensor_address(
         context: *mut TrtxExecutionContext,
         tensor_name: *const ::std::os::raw::c_char,
@@ -288,8 +845,35 @@ extern "C" {
         error_msg_len: usize,
     ) -> i32;
 
+    pub fn trtx_execution_context_bind_and_enqueue(
+        context: *mut TrtxExecutionContext,
+        bindings: *const TrtxTensorBinding,
+        nb_bindings: usize,
+        cuda_stream: *mut ::std::os::raw::c_void,
+        synchronize: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_set_cuda_graphs(
+        context: *mut TrtxExecutionContext,
+        enabled: i32,
+        max_graphs: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_execution_context_get_cuda_graph_stats(
+        context: *mut TrtxExecutionContext,
+        out_cached_graphs: *mut i32,
+        out_captures: *mut i64,
+        out_replays: *mut i64,
+    );
+
     pub fn trtx_free_buffer(buffer: *mut ::std::os::raw::c_void);
 
+    pub fn trtx_get_tensorrt_version() -> i32;
+
     // ONNX Parser functions
     pub fn trtx_onnx_parser_create(
         network: *mut TrtxNetworkDefinition,
@@ -305,6 +889,100 @@ extern "C" {
         parser: *mut TrtxOnnxParser,
         model_data: *const ::std::os::raw::c_void,
         model_size: usize,
+        model_path: *const ::std::os::raw::c_char,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_onnx_parser_parse_from_file(
+        parser: *mut TrtxOnnxParser,
+        path: *const ::std::os::raw::c_char,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_onnx_parser_parse_mapped(
+        parser: *mut TrtxOnnxParser,
+        path: *const ::std::os::raw::c_char,
+        num_threads: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_onnx_parser_supports_model(
+        parser: *mut TrtxOnnxParser,
+        model_data: *const ::std::os::raw::c_void,
+        model_size: usize,
+        model_path: *const ::std::os::raw::c_char,
+        out_supported: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_onnx_parser_get_nb_subgraphs(
+        parser: *mut TrtxOnnxParser,
+        out_count: *mut i64,
+    ) -> i32;
+
+    pub fn trtx_onnx_parser_get_subgraph(
+        parser: *mut TrtxOnnxParser,
+        index: i64,
+        out_supported: *mut i32,
+        out_nodes: *mut *const i64,
+        out_nb_nodes: *mut i64,
+    ) -> i32;
+
+    // Refitting
+    pub fn trtx_refitter_create(
+        engine: *mut TrtxCudaEngine,
+        logger: *mut TrtxLogger,
+        out_refitter: *mut *mut TrtxRefitter,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_refitter_destroy(refitter: *mut TrtxRefitter);
+
+    pub fn trtx_refitter_set_named_weights(
+        refitter: *mut TrtxRefitter,
+        name: *const ::std::os::raw::c_char,
+        data_type: i32,
+        values: *const ::std::os::raw::c_void,
+        count: i64,
+        location: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_refitter_get_weight_names(
+        refitter: *mut TrtxRefitter,
+        missing_only: i32,
+        size: i32,
+        out_names: *mut *const ::std::os::raw::c_char,
+        out_count: *mut i32,
+    ) -> i32;
+
+    pub fn trtx_refitter_refit_cuda_engine_async(
+        refitter: *mut TrtxRefitter,
+        cuda_stream: *mut ::std::os::raw::c_void,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_parser_refitter_create(
+        refitter: *mut TrtxRefitter,
+        logger: *mut TrtxLogger,
+        out_parser_refitter: *mut *mut TrtxParserRefitter,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_parser_refitter_destroy(parser_refitter: *mut TrtxParserRefitter);
+
+    pub fn trtx_parser_refitter_refit_from_bytes(
+        parser_refitter: *mut TrtxParserRefitter,
+        model_data: *const ::std::os::raw::c_void,
+        model_size: usize,
         error_msg: *mut ::std::os::raw::c_char,
         error_msg_len: usize,
     ) -> i32;
@@ -323,6 +1001,64 @@ extern "C" {
         error_msg_len: usize,
     ) -> i32;
 
+    // Stream-ordered allocation functions
+    pub fn trtx_cuda_malloc_async(
+        ptr: *mut *mut ::std::os::raw::c_void,
+        size: usize,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_free_async(
+        ptr: *mut ::std::os::raw::c_void,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_mem_pool_set_release_threshold(
+        threshold: u64,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    // Pinned host memory functions
+    pub fn trtx_cuda_host_alloc(
+        ptr: *mut *mut ::std::os::raw::c_void,
+        size: usize,
+        flags: u32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_free_host(
+        ptr: *mut ::std::os::raw::c_void,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_host_register(
+        ptr: *mut ::std::os::raw::c_void,
+        size: usize,
+        flags: u32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_host_unregister(
+        ptr: *mut ::std::os::raw::c_void,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_host_get_device_pointer(
+        host_ptr: *mut ::std::os::raw::c_void,
+        out_device_ptr: *mut *mut ::std::os::raw::c_void,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_cuda_memcpy_host_to_device(
         dst: *mut ::std::os::raw::c_void,
         src: *const ::std::os::raw::c_void,
@@ -344,6 +1080,126 @@ extern "C" {
         error_msg_len: usize,
     ) -> i32;
 
+    pub fn trtx_cuda_memcpy_host_to_device_async(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        size: usize,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_memcpy_device_to_host_async(
+        dst: *mut ::std::os::raw::c_void,
+        src: *const ::std::os::raw::c_void,
+        size: usize,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    // CUDA stream functions
+    pub fn trtx_cuda_stream_create(
+        flags: u32,
+        priority: i32,
+        out_stream: *mut *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_stream_destroy(stream: *mut TrtxCudaStream);
+
+    pub fn trtx_cuda_stream_synchronize(
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_event_create(
+        flags: u32,
+        out_event: *mut *mut TrtxCudaEvent,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_event_destroy(event: *mut TrtxCudaEvent);
+
+    pub fn trtx_cuda_event_record(
+        event: *mut TrtxCudaEvent,
+        stream: *mut TrtxCudaStream,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_event_query(
+        event: *mut TrtxCudaEvent,
+        out_complete: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_event_synchronize(
+        event: *mut TrtxCudaEvent,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_event_elapsed_time(
+        start: *mut TrtxCudaEvent,
+        end: *mut TrtxCudaEvent,
+        out_ms: *mut f32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_stream_wait_event(
+        stream: *mut TrtxCudaStream,
+        event: *mut TrtxCudaEvent,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_launch_host_func(
+        stream: *mut TrtxCudaStream,
+        callback: TrtxHostFunc,
+        user_data: *mut ::std::os::raw::c_void,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_get_stream_priority_range(
+        out_least_priority: *mut i32,
+        out_greatest_priority: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_get_device_count(
+        out_count: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_get_device(
+        out_device: *mut i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_set_device(
+        device: i32,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
+    pub fn trtx_cuda_get_device_identity(
+        out_major: *mut i32,
+        out_minor: *mut i32,
+        out_uuid: *mut u8,
+        error_msg: *mut ::std::os::raw::c_char,
+        error_msg_len: usize,
+    ) -> i32;
+
     pub fn trtx_cuda_get_default_stream() -> *mut ::std::os::raw::c_void;
 }
 "#;
@@ -3,28 +3,117 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // Mock handles (just use integers)
-typedef struct { int dummy; } TrtxLogger;
+typedef void (*TrtxLoggerCallback)(void* user_data, int32_t severity, const char* msg);
+typedef struct { TrtxLoggerCallback callback; void* user_data; int32_t min_severity; } TrtxLogger;
 typedef struct { int dummy; } TrtxBuilder;
-typedef struct { int dummy; } TrtxBuilderConfig;
+// Mock timing cache: just counts the tactics it has "profiled"
+typedef struct { int64_t entries; } TrtxTimingCache;
+typedef struct {
+    int32_t nb_profiles;
+    TrtxTimingCache* timing_cache;
+    uint32_t flags;
+} TrtxBuilderConfig;
 typedef struct { int dummy; } TrtxNetworkDefinition;
 typedef struct { int dummy; } TrtxRuntime;
-typedef struct { int dummy; } TrtxCudaEngine;
-typedef struct { int dummy; } TrtxExecutionContext;
+// Mock weight streaming: budget < 0 means every streamable weight is resident
+typedef struct { int64_t weight_budget; } TrtxCudaEngine;
+// Mock runtime cache: one bit per batch size whose kernels were "compiled"
+typedef struct { uint64_t compiled; } TrtxRuntimeCache;
+typedef void (*TrtxProfilerCallback)(void* user_data, const char* layer_name, float ms);
+typedef struct { TrtxProfilerCallback callback; void* user_data; } TrtxProfiler;
+// Mirrors the graph bookkeeping of ExecutionContextImpl in wrapper.cpp
+#define MOCK_MAX_GRAPHS 16
+typedef struct {
+    TrtxProfiler* profiler;
+    int64_t batch;
+    int32_t profile;
+    void* addresses[2];
+    void* device_memory;
+    int32_t graphs_enabled;
+    int32_t max_graphs;
+    int32_t nb_graphs;
+    uint64_t graph_keys[MOCK_MAX_GRAPHS];
+    int32_t graph_captured[MOCK_MAX_GRAPHS];
+    int64_t captures;
+    int64_t replays;
+    TrtxRuntimeCache* runtime_cache;
+} TrtxExecutionContext;
+typedef struct { void* data; size_t size; } TrtxHostMemory;
+typedef struct { int dummy; } TrtxCudaStream;
+typedef struct { int32_t nb_dims; int64_t d[8]; } TrtxDims;
+typedef struct {
+    int32_t index;
+    void* address;
+    TrtxDims shape;
+    const void* host_input;
+    size_t host_input_size;
+    void* host_output;
+    size_t host_output_size;
+} TrtxTensorBinding;
+typedef struct { int dummy; } TrtxOptimizationProfile;
+typedef struct { int recorded; } TrtxCudaEvent;
+typedef struct { TrtxExecutionContext* context; char info[512]; } TrtxEngineInspector;
+
+// Mock batch range of the single optimization profile (min, opt, max)
+static const int64_t MOCK_BATCH[3] = {1, 4, 8};
+
+// Mock layers and the time each takes per batch item
+#define MOCK_NB_LAYERS 3
+static const char* const MOCK_LAYER_NAMES[MOCK_NB_LAYERS] = {"conv1", "relu1", "fc"};
+static const char* const MOCK_LAYER_TYPES[MOCK_NB_LAYERS] = {"Convolution", "PointWise", "Gemm"};
+static const float MOCK_LAYER_MS[MOCK_NB_LAYERS] = {0.5f, 0.125f, 0.25f};
+
+static const int64_t MOCK_STREAMABLE_WEIGHTS = 64 << 20;
+
+// Mock: two GPUs, current device tracked per thread like the CUDA runtime
+#define MOCK_DEVICE_COUNT 2
+static _Thread_local int32_t mock_current_device = 0;
+
+static TrtxCudaEngine* mock_engine_create(void) {
+    TrtxCudaEngine* engine = malloc(sizeof(TrtxCudaEngine));
+    engine->weight_budget = -1;
+    return engine;
+}
+
+// Thread-local last error, mirroring copy_error in wrapper.cpp
+static _Thread_local char mock_last_error[256];
+
+static void mock_error(const char* msg, char* error_msg, size_t error_msg_len) {
+    strncpy(mock_last_error, msg, sizeof(mock_last_error) - 1);
+    mock_last_error[sizeof(mock_last_error) - 1] = '\0';
+    if (error_msg && error_msg_len > 0) {
+        strncpy(error_msg, msg, error_msg_len - 1);
+        error_msg[error_msg_len - 1] = '\0';
+    }
+}
+
+const char* trtx_get_last_error(void) {
+    return mock_last_error;
+}
+
+void trtx_clear_last_error(void) {
+    mock_last_error[0] = '\0';
+}
 
 // Mock implementations - all return success
 
 int32_t trtx_logger_create(
-    void* callback,
+    TrtxLoggerCallback callback,
     void* user_data,
     TrtxLogger** out_logger,
     char* error_msg,
     size_t error_msg_len
 ) {
-    *out_logger = malloc(sizeof(TrtxLogger));
+    TrtxLogger* logger = malloc(sizeof(TrtxLogger));
+    logger->callback = callback;
+    logger->user_data = user_data;
+    logger->min_severity = 4;
+    *out_logger = logger;
     return 0; // TRTX_SUCCESS
 }
 
@@ -32,12 +121,34 @@ void trtx_logger_destroy(TrtxLogger* logger) {
     free(logger);
 }
 
+int32_t trtx_logger_set_min_severity(
+    TrtxLogger* logger,
+    int32_t min_severity,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (min_severity < 0 || min_severity > 4) {
+        return 1;
+    }
+    logger->min_severity = min_severity;
+    return 0;
+}
+
+// Filters like LoggerImpl::log in wrapper.cpp
+static void mock_log(TrtxLogger* logger, int32_t severity, const char* msg) {
+    if (logger && logger->callback && severity <= logger->min_severity) {
+        logger->callback(logger->user_data, severity, msg);
+    }
+}
+
 int32_t trtx_builder_create(
     TrtxLogger* logger,
     TrtxBuilder** out_builder,
     char* error_msg,
     size_t error_msg_len
 ) {
+    mock_log(logger, 3, "Mock builder created");
+    mock_log(logger, 4, "Mock builder uses no GPU");
     *out_builder = malloc(sizeof(TrtxBuilder));
     return 0;
 }
@@ -63,7 +174,7 @@ int32_t trtx_builder_create_builder_config(
     char* error_msg,
     size_t error_msg_len
 ) {
-    *out_config = malloc(sizeof(TrtxBuilderConfig));
+    *out_config = calloc(1, sizeof(TrtxBuilderConfig));
     return 0;
 }
 
@@ -71,18 +182,38 @@ int32_t trtx_builder_build_serialized_network(
     TrtxBuilder* builder,
     TrtxNetworkDefinition* network,
     TrtxBuilderConfig* config,
-    void** out_data,
-    size_t* out_size,
+    TrtxHostMemory** out_memory,
     char* error_msg,
     size_t error_msg_len
 ) {
-    // Return a small dummy buffer
-    *out_size = 16;
-    *out_data = malloc(16);
-    memset(*out_data, 0, 16);
+    // Each build profiles one new tactic into the attached cache
+    if (config->timing_cache) {
+        config->timing_cache->entries++;
+    }
+
+    // Return a small dummy plan
+    TrtxHostMemory* memory = malloc(sizeof(TrtxHostMemory));
+    memory->size = 16;
+    memory->data = calloc(1, 16);
+    *out_memory = memory;
     return 0;
 }
 
+const void* trtx_host_memory_data(TrtxHostMemory* memory) {
+    return memory ? memory->data : NULL;
+}
+
+size_t trtx_host_memory_size(TrtxHostMemory* memory) {
+    return memory ? memory->size : 0;
+}
+
+void trtx_host_memory_destroy(TrtxHostMemory* memory) {
+    if (memory) {
+        free(memory->data);
+        free(memory);
+    }
+}
+
 void trtx_builder_config_destroy(TrtxBuilderConfig* config) {
     free(config);
 }
@@ -97,6 +228,180 @@ int32_t trtx_builder_config_set_memory_pool_limit(
     return 0;
 }
 
+int32_t trtx_builder_create_optimization_profile(
+    TrtxBuilder* builder,
+    TrtxOptimizationProfile** out_profile,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: profiles are owned by the builder, share a single static one
+    static TrtxOptimizationProfile profile;
+    *out_profile = &profile;
+    return 0;
+}
+
+int32_t trtx_optimization_profile_set_dimensions(
+    TrtxOptimizationProfile* profile,
+    const char* input_name,
+    int32_t selector,
+    const TrtxDims* dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_builder_config_add_optimization_profile(
+    TrtxBuilderConfig* config,
+    TrtxOptimizationProfile* profile,
+    int32_t* out_index,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_index = config->nb_profiles++;
+    return 0;
+}
+
+int32_t trtx_builder_config_set_flag(
+    TrtxBuilderConfig* config,
+    int32_t flag,
+    int32_t enabled,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (flag < 0 || flag >= 32) {
+        return 1;
+    }
+    if (enabled) {
+        config->flags |= 1u << flag;
+    } else {
+        config->flags &= ~(1u << flag);
+    }
+    return 0;
+}
+
+int32_t trtx_builder_config_get_flag(TrtxBuilderConfig* config, int32_t flag) {
+    return config && flag >= 0 && flag < 32 ? (config->flags >> flag) & 1 : 0;
+}
+
+int32_t trtx_builder_config_set_builder_optimization_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (level < 0 || level > 5) {
+        return 1;
+    }
+    return 0;
+}
+
+int32_t trtx_builder_config_set_tactic_sources(
+    TrtxBuilderConfig* config,
+    uint32_t sources,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_builder_config_set_max_aux_streams(
+    TrtxBuilderConfig* config,
+    int32_t nb_streams,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_builder_config_set_profiling_verbosity(
+    TrtxBuilderConfig* config,
+    int32_t verbosity,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return verbosity < 0 || verbosity > 2 ? 1 : 0;
+}
+
+int32_t trtx_builder_config_set_hardware_compatibility_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_builder_config_set_compute_capabilities(
+    TrtxBuilderConfig* config,
+    const int32_t* capabilities,
+    int32_t count,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_builder_config_create_timing_cache(
+    TrtxBuilderConfig* config,
+    const void* blob,
+    size_t blob_size,
+    TrtxTimingCache** out_cache,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TrtxTimingCache* cache = calloc(1, sizeof(TrtxTimingCache));
+    if (blob && blob_size >= sizeof(int64_t)) {
+        memcpy(&cache->entries, blob, sizeof(int64_t));
+    }
+    *out_cache = cache;
+    return 0;
+}
+
+int32_t trtx_builder_config_set_timing_cache(
+    TrtxBuilderConfig* config,
+    TrtxTimingCache* cache,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    config->timing_cache = cache;
+    return 0;
+}
+
+const TrtxTimingCache* trtx_builder_config_get_timing_cache(TrtxBuilderConfig* config) {
+    return config ? config->timing_cache : NULL;
+}
+
+void trtx_timing_cache_destroy(TrtxTimingCache* cache) {
+    free(cache);
+}
+
+int32_t trtx_timing_cache_serialize(
+    const TrtxTimingCache* cache,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TrtxHostMemory* memory = malloc(sizeof(TrtxHostMemory));
+    memory->size = sizeof(int64_t);
+    memory->data = malloc(sizeof(int64_t));
+    memcpy(memory->data, &cache->entries, sizeof(int64_t));
+    *out_memory = memory;
+    return 0;
+}
+
+int32_t trtx_timing_cache_combine(
+    TrtxTimingCache* cache,
+    const TrtxTimingCache* other,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    cache->entries += other->entries;
+    return 0;
+}
+
 void trtx_network_destroy(TrtxNetworkDefinition* network) {
     free(network);
 }
@@ -123,7 +428,25 @@ int32_t trtx_runtime_deserialize_cuda_engine(
     char* error_msg,
     size_t error_msg_len
 ) {
-    *out_engine = malloc(sizeof(TrtxCudaEngine));
+    *out_engine = mock_engine_create();
+    return 0;
+}
+
+int32_t trtx_runtime_deserialize_cuda_engine_from_file(
+    TrtxRuntime* runtime,
+    const char* path,
+    TrtxCudaEngine** out_engine,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: only check that the plan file exists
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        mock_error("Cannot open plan file", error_msg, error_msg_len);
+        return 1;
+    }
+    fclose(file);
+    *out_engine = mock_engine_create();
     return 0;
 }
 
@@ -137,132 +460,981 @@ int32_t trtx_cuda_engine_create_execution_context(
     char* error_msg,
     size_t error_msg_len
 ) {
-    *out_context = malloc(sizeof(TrtxExecutionContext));
+    TrtxExecutionContext* context = calloc(1, sizeof(TrtxExecutionContext));
+    context->batch = 1;
+    *out_context = context;
     return 0;
 }
 
-int32_t trtx_cuda_engine_get_tensor_name(
+int32_t trtx_cuda_engine_create_execution_context_with_strategy(
     TrtxCudaEngine* engine,
-    int32_t index,
-    const char** out_name,
+    int32_t strategy,
+    TrtxExecutionContext** out_context,
     char* error_msg,
     size_t error_msg_len
 ) {
-    static const char* mock_names[] = {"input", "output"};
-    if (index < 0 || index >= 2) {
-        return 1; // TRTX_ERROR_INVALID_ARGUMENT
+    if (strategy < 0 || strategy > 2) {
+        return 1;
     }
-    *out_name = mock_names[index];
-    return 0;
+    return trtx_cuda_engine_create_execution_context(engine, out_context, error_msg, error_msg_len);
 }
 
-int32_t trtx_cuda_engine_get_nb_io_tensors(
+int32_t trtx_cuda_engine_create_execution_context_with_cache(
     TrtxCudaEngine* engine,
-    int32_t* out_count
-) {
-    *out_count = 2; // Mock: 1 input, 1 output
-    return 0;
-}
-
-void trtx_execution_context_destroy(TrtxExecutionContext* context) {
-    free(context);
-}
-
-int32_t trtx_execution_context_set_tensor_address(
-    TrtxExecutionContext* context,
-    const char* tensor_name,
-    void* data,
+    int32_t strategy,
+    TrtxRuntimeCache* cache,
+    TrtxExecutionContext** out_context,
     char* error_msg,
     size_t error_msg_len
 ) {
+    if (trtx_cuda_engine_create_execution_context_with_strategy(
+            engine, strategy, out_context, error_msg, error_msg_len) != 0) {
+        return 1;
+    }
+    (*out_context)->runtime_cache = cache;
     return 0;
 }
 
-int32_t trtx_execution_context_enqueue_v3(
-    TrtxExecutionContext* context,
-    void* cuda_stream,
+int32_t trtx_runtime_cache_create(
+    TrtxCudaEngine* engine,
+    const void* blob,
+    size_t blob_size,
+    TrtxRuntimeCache** out_cache,
     char* error_msg,
     size_t error_msg_len
 ) {
+    if (blob_size != 0 && blob_size != sizeof(uint64_t)) {
+        mock_error("Runtime cache is corrupt or was written for another GPU or version",
+                   error_msg, error_msg_len);
+        return 1;
+    }
+    TrtxRuntimeCache* cache = calloc(1, sizeof(TrtxRuntimeCache));
+    if (blob_size != 0) {
+        memcpy(&cache->compiled, blob, sizeof(uint64_t));
+    }
+    *out_cache = cache;
     return 0;
 }
 
-void trtx_free_buffer(void* buffer) {
-    free(buffer);
+void trtx_runtime_cache_destroy(TrtxRuntimeCache* cache) {
+    free(cache);
 }
 
-// ONNX Parser mock implementations
-typedef struct { int dummy; } TrtxOnnxParser;
-
-int32_t trtx_onnx_parser_create(
-    void* network,
-    void* logger,
-    TrtxOnnxParser** out_parser,
+int32_t trtx_runtime_cache_serialize(
+    const TrtxRuntimeCache* cache,
+    TrtxHostMemory** out_memory,
     char* error_msg,
     size_t error_msg_len
 ) {
-    *out_parser = malloc(sizeof(TrtxOnnxParser));
+    TrtxHostMemory* memory = malloc(sizeof(TrtxHostMemory));
+    memory->size = sizeof(uint64_t);
+    memory->data = malloc(sizeof(uint64_t));
+    memcpy(memory->data, &cache->compiled, sizeof(uint64_t));
+    *out_memory = memory;
     return 0;
 }
 
-void trtx_onnx_parser_destroy(TrtxOnnxParser* parser) {
-    free(parser);
+// Mock activation memory: 128 KiB per batch row
+static const int64_t MOCK_DEVICE_MEMORY_PER_ROW = 1 << 17;
+
+int32_t trtx_cuda_engine_get_device_memory_size(
+    TrtxCudaEngine* engine,
+    int64_t* out_size
+) {
+    *out_size = MOCK_BATCH[2] * MOCK_DEVICE_MEMORY_PER_ROW;
+    return 0;
 }
 
-int32_t trtx_onnx_parser_parse(
-    TrtxOnnxParser* parser,
-    const void* model_data,
-    size_t model_size,
-    char* error_msg,
-    size_t error_msg_len
+int32_t trtx_cuda_engine_get_weight_streaming(
+    TrtxCudaEngine* engine,
+    int64_t* out_streamable_weights_size,
+    int64_t* out_budget,
+    int64_t* out_automatic_budget,
+    int64_t* out_scratch_memory_size
 ) {
-    // Mock: always succeeds
+    int64_t budget = engine->weight_budget < 0 ? MOCK_STREAMABLE_WEIGHTS : engine->weight_budget;
+    if (out_streamable_weights_size) {
+        *out_streamable_weights_size = MOCK_STREAMABLE_WEIGHTS;
+    }
+    if (out_budget) {
+        *out_budget = budget;
+    }
+    if (out_automatic_budget) {
+        *out_automatic_budget = MOCK_STREAMABLE_WEIGHTS / 2;
+    }
+    if (out_scratch_memory_size) {
+        *out_scratch_memory_size = budget < MOCK_STREAMABLE_WEIGHTS ? 1 << 20 : 0;
+    }
     return 0;
 }
 
-// CUDA Memory Management mock implementations
-int32_t trtx_cuda_malloc(
-    void** ptr,
-    size_t size,
+int32_t trtx_cuda_engine_set_weight_streaming_budget(
+    TrtxCudaEngine* engine,
+    int64_t budget,
     char* error_msg,
     size_t error_msg_len
 ) {
-    *ptr = malloc(size);
-    return *ptr ? 0 : 2; // 0 = success, 2 = out of memory
+    if (budget < 0 || budget > MOCK_STREAMABLE_WEIGHTS) {
+        mock_error("Weight streaming budget out of range", error_msg, error_msg_len);
+        return 1;
+    }
+    engine->weight_budget = budget;
+    return 0;
 }
 
-int32_t trtx_cuda_free(
-    void* ptr,
+int32_t trtx_cuda_engine_get_device_memory_size_for_profile(
+    TrtxCudaEngine* engine,
+    int32_t profile_index,
+    int64_t* out_size,
     char* error_msg,
     size_t error_msg_len
 ) {
-    free(ptr);
+    if (profile_index != 0) {
+        return 1;
+    }
+    *out_size = MOCK_BATCH[2] * MOCK_DEVICE_MEMORY_PER_ROW;
     return 0;
 }
 
-int32_t trtx_cuda_memcpy_host_to_device(
-    void* dst,
-    const void* src,
-    size_t size,
+int32_t trtx_cuda_engine_get_tensor_name(
+    TrtxCudaEngine* engine,
+    int32_t index,
+    const char** out_name,
     char* error_msg,
     size_t error_msg_len
 ) {
-    memcpy(dst, src, size);
+    static const char* mock_names[] = {"input", "output"};
+    if (index < 0 || index >= 2) {
+        return 1; // TRTX_ERROR_INVALID_ARGUMENT
+    }
+    *out_name = mock_names[index];
     return 0;
 }
 
-int32_t trtx_cuda_memcpy_device_to_host(
-    void* dst,
-    const void* src,
-    size_t size,
-    char* error_msg,
-    size_t error_msg_len
+int32_t trtx_cuda_engine_get_nb_io_tensors(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
 ) {
-    memcpy(dst, src, size);
+    *out_count = 2; // Mock: 1 input, 1 output
     return 0;
 }
 
-int32_t trtx_cuda_synchronize(
+// Mock engine: "input" is float [-1, 3, 224, 224], "output" is float [-1, 1000]
+static int mock_tensor_index(const char* tensor_name, char* error_msg, size_t error_msg_len) {
+    if (tensor_name && strcmp(tensor_name, "input") == 0) {
+        return 0;
+    }
+    if (tensor_name && strcmp(tensor_name, "output") == 0) {
+        return 1;
+    }
+    mock_error("Unknown tensor", error_msg, error_msg_len);
+    return -1;
+}
+
+static void mock_tensor_dims(int index, int64_t batch, TrtxDims* out_dims) {
+    if (index == 0) {
+        out_dims->nb_dims = 4;
+        out_dims->d[0] = batch;
+        out_dims->d[1] = 3;
+        out_dims->d[2] = 224;
+        out_dims->d[3] = 224;
+    } else {
+        out_dims->nb_dims = 2;
+        out_dims->d[0] = batch;
+        out_dims->d[1] = 1000;
+    }
+}
+
+int32_t trtx_cuda_engine_get_tensor_shape(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int index = mock_tensor_index(tensor_name, error_msg, error_msg_len);
+    if (index < 0) {
+        return 1;
+    }
+    mock_tensor_dims(index, -1, out_dims);
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_tensor_data_type(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_data_type,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (mock_tensor_index(tensor_name, error_msg, error_msg_len) < 0) {
+        return 1;
+    }
+    *out_data_type = 0; // TRTX_DATA_TYPE_FLOAT
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_tensor_io_mode(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_io_mode,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int index = mock_tensor_index(tensor_name, error_msg, error_msg_len);
+    if (index < 0) {
+        return 1;
+    }
+    *out_io_mode = index == 0 ? 1 : 2; // TRTX_TENSOR_IO_MODE_INPUT / OUTPUT
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_tensor_format(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_format,
+    int32_t* out_vectorized_dim,
+    int32_t* out_components_per_element,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (mock_tensor_index(tensor_name, error_msg, error_msg_len) < 0) {
+        return 1;
+    }
+    *out_format = 0; // TRTX_TENSOR_FORMAT_LINEAR
+    *out_vectorized_dim = -1;
+    *out_components_per_element = 1;
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_tensor_bytes_per_component(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_bytes,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (mock_tensor_index(tensor_name, error_msg, error_msg_len) < 0) {
+        return 1;
+    }
+    *out_bytes = 4;
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_nb_optimization_profiles(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+) {
+    *out_count = 1;
+    return 0;
+}
+
+int32_t trtx_cuda_engine_get_nb_layers(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+) {
+    *out_count = MOCK_NB_LAYERS;
+    return 0;
+}
+
+int32_t trtx_cuda_engine_create_engine_inspector(
+    TrtxCudaEngine* engine,
+    TrtxEngineInspector** out_inspector,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_inspector = calloc(1, sizeof(TrtxEngineInspector));
+    return 0;
+}
+
+void trtx_engine_inspector_destroy(TrtxEngineInspector* inspector) {
+    free(inspector);
+}
+
+int32_t trtx_engine_inspector_set_execution_context(
+    TrtxEngineInspector* inspector,
+    TrtxExecutionContext* context,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    inspector->context = context;
+    return 0;
+}
+
+static void mock_layer_information(int32_t layer, int32_t format, char* out, size_t out_len) {
+    if (format == 1) {
+        snprintf(out, out_len,
+                 "{\"Name\":\"%s\",\"LayerType\":\"%s\",\"TacticName\":\"mock_%s\"}",
+                 MOCK_LAYER_NAMES[layer], MOCK_LAYER_TYPES[layer], MOCK_LAYER_NAMES[layer]);
+    } else {
+        snprintf(out, out_len, "%s", MOCK_LAYER_NAMES[layer]);
+    }
+}
+
+int32_t trtx_engine_inspector_get_layer_information(
+    TrtxEngineInspector* inspector,
+    int32_t layer_index,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (layer_index < 0 || layer_index >= MOCK_NB_LAYERS || format < 0 || format > 1) {
+        return 1;
+    }
+    mock_layer_information(layer_index, format, inspector->info, sizeof(inspector->info));
+    *out_info = inspector->info;
+    return 0;
+}
+
+int32_t trtx_engine_inspector_get_engine_information(
+    TrtxEngineInspector* inspector,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (format < 0 || format > 1) {
+        return 1;
+    }
+    size_t used = 0;
+    char layer[160];
+    const char* open = format == 1 ? "{\"Layers\":[" : "";
+    used += snprintf(inspector->info + used, sizeof(inspector->info) - used, "%s", open);
+    for (int32_t i = 0; i < MOCK_NB_LAYERS; ++i) {
+        mock_layer_information(i, format, layer, sizeof(layer));
+        const char* separator = i == 0 ? "" : (format == 1 ? "," : "\n");
+        used += snprintf(inspector->info + used, sizeof(inspector->info) - used, "%s%s",
+                         separator, layer);
+    }
+    if (format == 1) {
+        snprintf(inspector->info + used, sizeof(inspector->info) - used,
+                 "],\"Bindings\":[\"input\",\"output\"]}");
+    }
+    *out_info = inspector->info;
+    return 0;
+}
+
+// Mock profiler: calls back from enqueue with the mock layer times
+int32_t trtx_profiler_create(
+    TrtxProfilerCallback callback,
+    void* user_data,
+    TrtxProfiler** out_profiler,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TrtxProfiler* profiler = malloc(sizeof(TrtxProfiler));
+    profiler->callback = callback;
+    profiler->user_data = user_data;
+    *out_profiler = profiler;
+    return 0;
+}
+
+void trtx_profiler_destroy(TrtxProfiler* profiler) {
+    free(profiler);
+}
+
+int32_t trtx_cuda_engine_get_profile_shape(
+    TrtxCudaEngine* engine,
+    const char* input_name,
+    int32_t profile_index,
+    int32_t selector,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int index = mock_tensor_index(input_name, error_msg, error_msg_len);
+    if (index != 0 || profile_index != 0 || selector < 0 || selector > 2) {
+        return 1;
+    }
+    mock_tensor_dims(index, MOCK_BATCH[selector], out_dims);
+    return 0;
+}
+
+void trtx_execution_context_destroy(TrtxExecutionContext* context) {
+    free(context);
+}
+
+int32_t trtx_execution_context_set_device_memory(
+    TrtxExecutionContext* context,
+    void* memory,
+    int64_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!memory || size < 0) {
+        return 1;
+    }
+    context->device_memory = memory;
+    return 0;
+}
+
+int32_t trtx_execution_context_update_device_memory_size_for_shapes(
+    TrtxExecutionContext* context,
+    int64_t* out_size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_size = context->batch * MOCK_DEVICE_MEMORY_PER_ROW;
+    return 0;
+}
+
+int32_t trtx_execution_context_set_tensor_address(
+    TrtxExecutionContext* context,
+    const char* tensor_name,
+    void* data,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int index = mock_tensor_index(tensor_name, error_msg, error_msg_len);
+    if (index < 0) {
+        return 1;
+    }
+    context->addresses[index] = data;
+    return 0;
+}
+
+int32_t trtx_execution_context_enqueue_v3(
+    TrtxExecutionContext* context,
+    void* cuda_stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (context->runtime_cache && context->batch < 64) {
+        context->runtime_cache->compiled |= (uint64_t)1 << context->batch;
+    }
+    if (context->profiler) {
+        // Profiled runs are eager, as in wrapper.cpp
+        for (int32_t i = 0; i < MOCK_NB_LAYERS; ++i) {
+            context->profiler->callback(context->profiler->user_data, MOCK_LAYER_NAMES[i],
+                                        MOCK_LAYER_MS[i] * (float)context->batch);
+        }
+        return 0;
+    }
+    if (!context->graphs_enabled || !cuda_stream) {
+        return 0;
+    }
+
+    uint64_t key = (uint64_t)context->batch * 31u + (uint64_t)context->profile;
+    key = key * 1000003u + (uint64_t)(uintptr_t)context->addresses[0];
+    key = key * 1000003u + (uint64_t)(uintptr_t)context->addresses[1];
+    key = key * 1000003u + (uint64_t)(uintptr_t)context->device_memory;
+
+    for (int32_t i = 0; i < context->nb_graphs; ++i) {
+        if (context->graph_keys[i] == key) {
+            // First repeat captures, later ones replay
+            if (context->graph_captured[i]) {
+                context->replays++;
+            } else {
+                context->graph_captured[i] = 1;
+                context->captures++;
+            }
+            return 0;
+        }
+    }
+
+    // Warm-up run of a new configuration; the mock forgets the oldest when full
+    if (context->nb_graphs == context->max_graphs) {
+        memmove(&context->graph_keys[0], &context->graph_keys[1],
+                sizeof(uint64_t) * (context->nb_graphs - 1));
+        memmove(&context->graph_captured[0], &context->graph_captured[1],
+                sizeof(int32_t) * (context->nb_graphs - 1));
+        context->nb_graphs--;
+    }
+    context->graph_keys[context->nb_graphs] = key;
+    context->graph_captured[context->nb_graphs] = 0;
+    context->nb_graphs++;
+    return 0;
+}
+
+int32_t trtx_execution_context_set_profiler(
+    TrtxExecutionContext* context,
+    TrtxProfiler* profiler,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    context->profiler = profiler;
+    return 0;
+}
+
+int32_t trtx_execution_context_set_cuda_graphs(
+    TrtxExecutionContext* context,
+    int32_t enabled,
+    int32_t max_graphs,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (max_graphs < 1) {
+        return 1;
+    }
+    context->graphs_enabled = enabled;
+    context->max_graphs = max_graphs < MOCK_MAX_GRAPHS ? max_graphs : MOCK_MAX_GRAPHS;
+    if (!enabled) {
+        context->nb_graphs = 0;
+    }
+    return 0;
+}
+
+void trtx_execution_context_get_cuda_graph_stats(
+    TrtxExecutionContext* context,
+    int32_t* out_cached_graphs,
+    int64_t* out_captures,
+    int64_t* out_replays
+) {
+    if (out_cached_graphs) {
+        int32_t count = 0;
+        for (int32_t i = 0; i < context->nb_graphs; ++i) {
+            count += context->graph_captured[i];
+        }
+        *out_cached_graphs = count;
+    }
+    if (out_captures) {
+        *out_captures = context->captures;
+    }
+    if (out_replays) {
+        *out_replays = context->replays;
+    }
+}
+
+int32_t trtx_execution_context_set_input_shape(
+    TrtxExecutionContext* context,
+    const char* input_name,
+    const TrtxDims* dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (mock_tensor_index(input_name, error_msg, error_msg_len) != 0 || dims->nb_dims != 4 ||
+        dims->d[0] < MOCK_BATCH[0] || dims->d[0] > MOCK_BATCH[2]) {
+        return 1;
+    }
+    context->batch = dims->d[0];
+    return 0;
+}
+
+// Same order as wrapper.cpp: shapes, addresses, uploads, enqueue, readbacks
+int32_t trtx_execution_context_bind_and_enqueue(
+    TrtxExecutionContext* context,
+    const TrtxTensorBinding* bindings,
+    size_t nb_bindings,
+    void* cuda_stream,
+    int32_t synchronize,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    static const char* mock_names[] = {"input", "output"};
+    for (size_t i = 0; i < nb_bindings; ++i) {
+        if (bindings[i].index < 0 || bindings[i].index >= 2) {
+            mock_error("Tensor index out of range", error_msg, error_msg_len);
+            return 1;
+        }
+        if (bindings[i].shape.nb_dims >= 0 &&
+            trtx_execution_context_set_input_shape(context, mock_names[bindings[i].index],
+                                                   &bindings[i].shape, error_msg, error_msg_len) != 0) {
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < nb_bindings; ++i) {
+        if (bindings[i].address) {
+            context->addresses[bindings[i].index] = bindings[i].address;
+        }
+    }
+    for (size_t i = 0; i < nb_bindings; ++i) {
+        if (bindings[i].host_input) {
+            memcpy(context->addresses[bindings[i].index], bindings[i].host_input,
+                   bindings[i].host_input_size);
+        }
+    }
+    if (trtx_execution_context_enqueue_v3(context, cuda_stream, error_msg, error_msg_len) != 0) {
+        return 1;
+    }
+    for (size_t i = 0; i < nb_bindings; ++i) {
+        if (bindings[i].host_output) {
+            memcpy(bindings[i].host_output, context->addresses[bindings[i].index],
+                   bindings[i].host_output_size);
+        }
+    }
+    (void)synchronize;
+    return 0;
+}
+
+int32_t trtx_execution_context_get_tensor_shape(
+    TrtxExecutionContext* context,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int index = mock_tensor_index(tensor_name, error_msg, error_msg_len);
+    if (index < 0) {
+        return 1;
+    }
+    mock_tensor_dims(index, context->batch, out_dims);
+    return 0;
+}
+
+int32_t trtx_execution_context_set_optimization_profile_async(
+    TrtxExecutionContext* context,
+    int32_t profile_index,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (profile_index != 0) {
+        return 1;
+    }
+    context->profile = profile_index;
+    return 0;
+}
+
+void trtx_free_buffer(void* buffer) {
+    free(buffer);
+}
+
+int32_t trtx_get_tensorrt_version() {
+    // Mock: TensorRT-RTX 1.0.0
+    return 10000;
+}
+
+// ONNX Parser mock implementations
+typedef struct { int dummy; } TrtxOnnxParser;
+
+int32_t trtx_onnx_parser_create(
+    void* network,
+    void* logger,
+    TrtxOnnxParser** out_parser,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_parser = malloc(sizeof(TrtxOnnxParser));
+    return 0;
+}
+
+void trtx_onnx_parser_destroy(TrtxOnnxParser* parser) {
+    free(parser);
+}
+
+int32_t trtx_onnx_parser_parse(
+    TrtxOnnxParser* parser,
+    const void* model_data,
+    size_t model_size,
+    const char* model_path,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: always succeeds
+    return 0;
+}
+
+// Mock: any readable, non-empty file parses
+static int32_t mock_check_model_file(const char* path, char* error_msg, size_t error_msg_len) {
+    FILE* file = fopen(path, "rb");
+    int empty = 1;
+    if (file) {
+        empty = fgetc(file) == EOF;
+        fclose(file);
+    }
+    if (!file || empty) {
+        mock_error(file ? "ONNX model file is empty" : "Cannot open ONNX model file", error_msg, error_msg_len);
+        return 1;
+    }
+    return 0;
+}
+
+int32_t trtx_onnx_parser_parse_from_file(
+    TrtxOnnxParser* parser,
+    const char* path,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return mock_check_model_file(path, error_msg, error_msg_len);
+}
+
+int32_t trtx_onnx_parser_parse_mapped(
+    TrtxOnnxParser* parser,
+    const char* path,
+    int32_t num_threads,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return mock_check_model_file(path, error_msg, error_msg_len);
+}
+
+// Mock: models split into a supported subgraph (the first two nodes) and an unsupported one
+static const int64_t MOCK_SUBGRAPH_NODES[2][2] = {{0, 1}, {2, 0}};
+static const int64_t MOCK_SUBGRAPH_LENGTHS[2] = {2, 1};
+
+int32_t trtx_onnx_parser_supports_model(
+    TrtxOnnxParser* parser,
+    const void* model_data,
+    size_t model_size,
+    const char* model_path,
+    int32_t* out_supported,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_supported = 0;
+    return 0;
+}
+
+int32_t trtx_onnx_parser_get_nb_subgraphs(
+    TrtxOnnxParser* parser,
+    int64_t* out_count
+) {
+    *out_count = 2;
+    return 0;
+}
+
+int32_t trtx_onnx_parser_get_subgraph(
+    TrtxOnnxParser* parser,
+    int64_t index,
+    int32_t* out_supported,
+    const int64_t** out_nodes,
+    int64_t* out_nb_nodes
+) {
+    if (index < 0 || index >= 2) {
+        mock_error("Invalid subgraph index", NULL, 0);
+        return 1;
+    }
+    *out_supported = index == 0;
+    *out_nodes = MOCK_SUBGRAPH_NODES[index];
+    *out_nb_nodes = MOCK_SUBGRAPH_LENGTHS[index];
+    return 0;
+}
+
+// Mock refitter: the weights of the mock layers, tracked as a bitmask of staged names
+#define MOCK_NB_WEIGHTS 4
+static const char* const MOCK_WEIGHT_NAMES[MOCK_NB_WEIGHTS] = {
+    "conv1.weight", "conv1.bias", "fc.weight", "fc.bias"};
+typedef struct { uint32_t staged; int64_t refits; } TrtxRefitter;
+typedef struct { TrtxRefitter* refitter; } TrtxParserRefitter;
+
+int32_t trtx_refitter_create(
+    TrtxCudaEngine* engine,
+    TrtxLogger* logger,
+    TrtxRefitter** out_refitter,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_refitter = calloc(1, sizeof(TrtxRefitter));
+    return 0;
+}
+
+void trtx_refitter_destroy(TrtxRefitter* refitter) {
+    free(refitter);
+}
+
+int32_t trtx_refitter_set_named_weights(
+    TrtxRefitter* refitter,
+    const char* name,
+    int32_t data_type,
+    const void* values,
+    int64_t count,
+    int32_t location,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    for (int32_t i = 0; i < MOCK_NB_WEIGHTS; ++i) {
+        if (name && strcmp(name, MOCK_WEIGHT_NAMES[i]) == 0 && count > 0 && data_type == 0) {
+            refitter->staged |= 1u << i;
+            return 0;
+        }
+    }
+    mock_error("Cannot refit weights: unknown name, or wrong type or count", error_msg,
+               error_msg_len);
+    return 1;
+}
+
+int32_t trtx_refitter_get_weight_names(
+    TrtxRefitter* refitter,
+    int32_t missing_only,
+    int32_t size,
+    const char** out_names,
+    int32_t* out_count
+) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < MOCK_NB_WEIGHTS; ++i) {
+        if (missing_only && (refitter->staged & (1u << i))) {
+            continue;
+        }
+        if (count < size) {
+            out_names[count] = MOCK_WEIGHT_NAMES[i];
+        }
+        ++count;
+    }
+    *out_count = count;
+    return 0;
+}
+
+int32_t trtx_refitter_refit_cuda_engine_async(
+    TrtxRefitter* refitter,
+    void* cuda_stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (refitter->staged != (1u << MOCK_NB_WEIGHTS) - 1) {
+        mock_error("Refit failed; check for missing weights", error_msg, error_msg_len);
+        return 1;
+    }
+    // Like TensorRT, a later refit has to supply the weights again
+    refitter->staged = 0;
+    refitter->refits += 1;
+    return 0;
+}
+
+int32_t trtx_parser_refitter_create(
+    TrtxRefitter* refitter,
+    TrtxLogger* logger,
+    TrtxParserRefitter** out_parser_refitter,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_parser_refitter = malloc(sizeof(TrtxParserRefitter));
+    (*out_parser_refitter)->refitter = refitter;
+    return 0;
+}
+
+void trtx_parser_refitter_destroy(TrtxParserRefitter* parser_refitter) {
+    free(parser_refitter);
+}
+
+int32_t trtx_parser_refitter_refit_from_bytes(
+    TrtxParserRefitter* parser_refitter,
+    const void* model_data,
+    size_t model_size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: any non-empty model carries every initializer
+    if (model_size == 0) {
+        mock_error("Failed to read refit weights from ONNX model", error_msg, error_msg_len);
+        return 1;
+    }
+    parser_refitter->refitter->staged = (1u << MOCK_NB_WEIGHTS) - 1;
+    return 0;
+}
+
+// CUDA Memory Management mock implementations
+int32_t trtx_cuda_malloc(
+    void** ptr,
+    size_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *ptr = malloc(size);
+    return *ptr ? 0 : 2; // 0 = success, 2 = out of memory
+}
+
+int32_t trtx_cuda_free(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    free(ptr);
+    return 0;
+}
+
+int32_t trtx_cuda_malloc_async(
+    void** ptr,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *ptr = malloc(size);
+    return *ptr ? 0 : 2;
+}
+
+int32_t trtx_cuda_free_async(
+    void* ptr,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    free(ptr);
+    return 0;
+}
+
+int32_t trtx_cuda_mem_pool_set_release_threshold(
+    uint64_t threshold,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_cuda_host_alloc(
+    void** ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: pinned memory is plain heap memory
+    *ptr = malloc(size);
+    return *ptr ? 0 : 2;
+}
+
+int32_t trtx_cuda_free_host(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    free(ptr);
+    return 0;
+}
+
+int32_t trtx_cuda_host_register(
+    void* ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return ptr ? 0 : 1;
+}
+
+int32_t trtx_cuda_host_unregister(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return ptr ? 0 : 1;
+}
+
+int32_t trtx_cuda_host_get_device_pointer(
+    void* host_ptr,
+    void** out_device_ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: host and device share one address space
+    *out_device_ptr = host_ptr;
+    return host_ptr ? 0 : 1;
+}
+
+int32_t trtx_cuda_memcpy_host_to_device(
+    void* dst,
+    const void* src,
+    size_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    memcpy(dst, src, size);
+    return 0;
+}
+
+int32_t trtx_cuda_memcpy_device_to_host(
+    void* dst,
+    const void* src,
+    size_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    memcpy(dst, src, size);
+    return 0;
+}
+
+int32_t trtx_cuda_synchronize(
     char* error_msg,
     size_t error_msg_len
 ) {
@@ -270,6 +1442,188 @@ int32_t trtx_cuda_synchronize(
     return 0;
 }
 
+int32_t trtx_cuda_memcpy_host_to_device_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: copies complete immediately
+    memcpy(dst, src, size);
+    return 0;
+}
+
+int32_t trtx_cuda_memcpy_device_to_host_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    memcpy(dst, src, size);
+    return 0;
+}
+
+int32_t trtx_cuda_stream_create(
+    uint32_t flags,
+    int32_t priority,
+    TrtxCudaStream** out_stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_stream = malloc(sizeof(TrtxCudaStream));
+    return 0;
+}
+
+void trtx_cuda_stream_destroy(TrtxCudaStream* stream) {
+    free(stream);
+}
+
+int32_t trtx_cuda_stream_synchronize(
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+// Mock events: all work is complete as soon as it is queued
+int32_t trtx_cuda_event_create(
+    uint32_t flags,
+    TrtxCudaEvent** out_event,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_event = calloc(1, sizeof(TrtxCudaEvent));
+    return 0;
+}
+
+void trtx_cuda_event_destroy(TrtxCudaEvent* event) {
+    free(event);
+}
+
+int32_t trtx_cuda_event_record(
+    TrtxCudaEvent* event,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    event->recorded = 1;
+    return 0;
+}
+
+int32_t trtx_cuda_event_query(
+    TrtxCudaEvent* event,
+    int32_t* out_complete,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_complete = 1;
+    return 0;
+}
+
+int32_t trtx_cuda_event_synchronize(
+    TrtxCudaEvent* event,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_cuda_event_elapsed_time(
+    TrtxCudaEvent* start,
+    TrtxCudaEvent* end,
+    float* out_ms,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!start->recorded || !end->recorded) {
+        return 4;
+    }
+    *out_ms = 0.0f;
+    return 0;
+}
+
+int32_t trtx_cuda_stream_wait_event(
+    TrtxCudaStream* stream,
+    TrtxCudaEvent* event,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    return 0;
+}
+
+int32_t trtx_cuda_launch_host_func(
+    TrtxCudaStream* stream,
+    void (*callback)(void*),
+    void* user_data,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    callback(user_data);
+    return 0;
+}
+
+int32_t trtx_cuda_get_stream_priority_range(
+    int32_t* out_least_priority,
+    int32_t* out_greatest_priority,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: same range as current NVIDIA GPUs
+    *out_least_priority = 0;
+    *out_greatest_priority = -5;
+    return 0;
+}
+
+int32_t trtx_cuda_get_device_count(
+    int32_t* out_count,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_count = MOCK_DEVICE_COUNT;
+    return 0;
+}
+
+int32_t trtx_cuda_get_device(
+    int32_t* out_device,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    *out_device = mock_current_device;
+    return 0;
+}
+
+int32_t trtx_cuda_set_device(
+    int32_t device,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (device < 0 || device >= MOCK_DEVICE_COUNT) {
+        mock_error("invalid device ordinal", error_msg, error_msg_len);
+        return 1;
+    }
+    mock_current_device = device;
+    return 0;
+}
+
+int32_t trtx_cuda_get_device_identity(
+    int32_t* out_major,
+    int32_t* out_minor,
+    uint8_t* out_uuid,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    // Mock: an Ada (8.9) device with an all-zero UUID
+    *out_major = 8;
+    *out_minor = 9;
+    memset(out_uuid, 0, 16);
+    return 0;
+}
+
 void* trtx_cuda_get_default_stream() {
     return NULL;
 }
@@ -1,18 +1,60 @@
 #include "wrapper.hpp"
 #include <NvInfer.h>
 #include <NvOnnxParser.h>
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cstring>
 #include <exception>
+#include <map>
 #include <memory>
-
-// Helper to copy error messages
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// IStreamReaderV2 deserialization is available in TensorRT 10.7+ and TensorRT-RTX;
+// define TRTX_USE_STREAM_READER=0 to deserialize straight from the mapping instead
+#ifndef TRTX_USE_STREAM_READER
+#define TRTX_USE_STREAM_READER 1
+#endif
+
+// Message of the most recent failed call on this thread, read by trtx_get_last_error.
+// Only failures pay for it; the success path never touches it.
+static thread_local std::string last_error;
+
+// Record an error message; the caller buffer is optional and may be NULL
 static void copy_error(const char* msg, char* error_msg, size_t error_msg_len) {
+    try {
+        last_error.assign(msg);
+    } catch (...) {
+        // Keep whatever was there rather than letting bad_alloc cross the C boundary
+    }
     if (error_msg && error_msg_len > 0) {
         strncpy(error_msg, msg, error_msg_len - 1);
         error_msg[error_msg_len - 1] = '\0';
     }
 }
 
+const char* trtx_get_last_error(void) {
+    return last_error.c_str();
+}
+
+void trtx_clear_last_error(void) {
+    last_error.clear();
+}
+
 // Helper macro for exception handling
 #define TRTX_TRY_CATCH_BEGIN try {
 #define TRTX_TRY_CATCH_END(error_msg, error_msg_len) \
@@ -27,21 +69,377 @@ static void copy_error(const char* msg, char* error_msg, size_t error_msg_len) {
         return TRTX_ERROR_UNKNOWN; \
     }
 
+// Convert between the C dims struct and nvinfer1::Dims; false if the rank is out of range
+static bool to_trt_dims(const TrtxDims& in, nvinfer1::Dims& out) {
+    if (in.nb_dims < 0 || in.nb_dims > TRTX_MAX_DIMS) {
+        return false;
+    }
+    out.nbDims = in.nb_dims;
+    for (int32_t i = 0; i < in.nb_dims; ++i) {
+        out.d[i] = in.d[i];
+    }
+    return true;
+}
+
+static bool from_trt_dims(const nvinfer1::Dims& in, TrtxDims& out) {
+    if (in.nbDims < 0 || in.nbDims > TRTX_MAX_DIMS) {
+        return false;
+    }
+    out.nb_dims = in.nbDims;
+    for (int32_t i = 0; i < in.nbDims; ++i) {
+        out.d[i] = in.d[i];
+    }
+    return true;
+}
+
 // Logger wrapper that calls back into Rust
+//
+// Messages below the severity threshold are dropped here, so verbose build
+// and deserialization logs never pay for crossing into Rust.
 class LoggerImpl : public nvinfer1::ILogger {
 public:
     LoggerImpl(TrtxLoggerCallback callback, void* user_data)
         : callback_(callback), user_data_(user_data) {}
 
     void log(Severity severity, const char* msg) noexcept override {
+        if (static_cast<int32_t>(severity) > min_severity_.load(std::memory_order_relaxed)) {
+            return;
+        }
         if (callback_) {
             callback_(user_data_, static_cast<TrtxLoggerSeverity>(severity), msg);
         }
     }
 
+    void set_min_severity(int32_t severity) {
+        min_severity_.store(severity, std::memory_order_relaxed);
+    }
+
 private:
     TrtxLoggerCallback callback_;
     void* user_data_;
+    // Lower values are more severe, as in ILogger::Severity
+    std::atomic<int32_t> min_severity_{TRTX_SEVERITY_VERBOSE};
+};
+
+// Profiler wrapper that calls back into Rust
+class ProfilerImpl : public nvinfer1::IProfiler {
+public:
+    ProfilerImpl(TrtxProfilerCallback callback, void* user_data)
+        : callback_(callback), user_data_(user_data) {}
+
+    void reportLayerTime(const char* layer_name, float ms) noexcept override {
+        if (callback_) {
+            callback_(user_data_, layer_name, ms);
+        }
+    }
+
+private:
+    TrtxProfilerCallback callback_;
+    void* user_data_;
+};
+
+// Execution context plus the CUDA graphs captured for it
+//
+// TensorRT has no notion of graphs itself, so the wrapper tracks everything a
+// captured enqueueV3 bakes in (profile, input shapes, tensor addresses and
+// user-managed activation memory) and keys graphs on it. Changing any of them
+// selects, or later captures, another graph; the old one stays cached for
+// when the configuration comes back. Bindings are only tracked while graphs
+// are enabled, in arrays indexed like the engine's IO tensors, so binding
+// never allocates.
+class ExecutionContextImpl {
+public:
+    explicit ExecutionContextImpl(nvinfer1::IExecutionContext* context,
+                                  std::unique_ptr<nvinfer1::IRuntimeConfig> runtime_config = nullptr)
+        : context_(context), runtime_config_(std::move(runtime_config)) {
+        const nvinfer1::ICudaEngine& engine = context_->getEngine();
+        names_.resize(std::max<int32_t>(engine.getNbIOTensors(), 0));
+        for (size_t i = 0; i < names_.size(); ++i) {
+            names_[i] = engine.getIOTensorName(static_cast<int32_t>(i));
+        }
+        current_.addresses.resize(names_.size());
+        current_.shapes.resize(names_.size() * kShapeSlots);
+    }
+
+    ~ExecutionContextImpl() {
+        clear_graphs();
+        delete context_;
+    }
+
+    nvinfer1::IExecutionContext* get() const { return context_; }
+
+    int32_t nb_io_tensors() const { return static_cast<int32_t>(names_.size()); }
+
+    // Name of IO tensor `index`, owned by the engine; index must be in range
+    const char* name(int32_t index) const { return names_[index]; }
+
+    void set_graphs_enabled(bool enabled, int32_t max_graphs) {
+        if (enabled && !graphs_enabled_) {
+            // Bindings made while untracked are read back once here
+            for (size_t i = 0; i < names_.size(); ++i) {
+                current_.addresses[i] = const_cast<void*>(context_->getTensorAddress(names_[i]));
+                record_shape(static_cast<int32_t>(i), context_->getTensorShape(names_[i]));
+            }
+        }
+        graphs_enabled_ = enabled;
+        max_graphs_ = std::max<int32_t>(max_graphs, 1);
+        if (!enabled) {
+            clear_graphs();
+        } else {
+            evict_graphs(max_graphs_);
+        }
+    }
+
+    bool set_tensor_address(const char* name, void* data) {
+        if (!graphs_enabled_) {
+            return context_->setTensorAddress(name, data);
+        }
+        int32_t index = index_of(name);
+        return index >= 0 ? set_tensor_address_at(index, data) : context_->setTensorAddress(name, data);
+    }
+
+    bool set_input_shape(const char* name, const nvinfer1::Dims& dims) {
+        if (!graphs_enabled_) {
+            return context_->setInputShape(name, dims);
+        }
+        int32_t index = index_of(name);
+        return index >= 0 ? set_input_shape_at(index, dims) : context_->setInputShape(name, dims);
+    }
+
+    // Index-based binding; index must be in range
+    bool set_tensor_address_at(int32_t index, void* data) {
+        if (!context_->setTensorAddress(names_[index], data)) {
+            return false;
+        }
+        if (graphs_enabled_) {
+            current_.addresses[index] = data;
+        }
+        return true;
+    }
+
+    bool set_input_shape_at(int32_t index, const nvinfer1::Dims& dims) {
+        if (!context_->setInputShape(names_[index], dims)) {
+            return false;
+        }
+        if (graphs_enabled_) {
+            record_shape(index, dims);
+        }
+        return true;
+    }
+
+    // Current address of IO tensor `index`
+    void* tensor_address(int32_t index) const {
+        if (graphs_enabled_) {
+            return current_.addresses[index];
+        }
+        return const_cast<void*>(context_->getTensorAddress(names_[index]));
+    }
+
+    void set_profiler(nvinfer1::IProfiler* profiler) {
+        context_->setProfiler(profiler);
+        profiled_ = profiler != nullptr;
+    }
+
+    void set_device_memory(void* memory, int64_t size) {
+        context_->setDeviceMemoryV2(memory, size);
+        current_.device_memory = memory;
+    }
+
+    bool set_optimization_profile_async(int32_t profile, cudaStream_t stream) {
+        if (!context_->setOptimizationProfileAsync(profile, stream)) {
+            return false;
+        }
+        // Input shapes have to be set again for the new profile
+        current_.profile = profile;
+        std::fill(current_.shapes.begin(), current_.shapes.end(), 0);
+        return true;
+    }
+
+    // Enqueue through a cached graph when possible, falling back to enqueueV3
+    cudaError_t enqueue(cudaStream_t stream, bool& ok) {
+        ok = true;
+        // Capturing the legacy default stream is not allowed, and a graph
+        // replay would bypass the profiler's per-layer reports
+        if (!graphs_enabled_ || !stream || profiled_) {
+            ok = context_->enqueueV3(stream);
+            return cudaSuccess;
+        }
+
+        GraphEntry& entry = find_or_insert_entry();
+        entry.last_used = ++clock_;
+
+        if (entry.exec) {
+            ++replays_;
+            return cudaGraphLaunch(entry.exec, stream);
+        }
+
+        // The first enqueue of a configuration runs eagerly, so TensorRT can
+        // finish any lazy setup and allocation before it gets baked into a graph
+        if (entry.uncapturable || !entry.warmed_up) {
+            entry.warmed_up = true;
+            ok = context_->enqueueV3(stream);
+            return cudaSuccess;
+        }
+
+        cudaGraph_t graph = nullptr;
+        cudaError_t status = cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal);
+        if (status != cudaSuccess) {
+            return status;
+        }
+        bool captured = context_->enqueueV3(stream);
+        status = cudaStreamEndCapture(stream, &graph);
+        if (captured && status == cudaSuccess && graph) {
+            status = cudaGraphInstantiate(&entry.exec, graph, 0);
+        }
+        if (graph) {
+            cudaGraphDestroy(graph);
+        }
+
+        if (!captured || status != cudaSuccess || !entry.exec) {
+            // Some engines (e.g. with data-dependent shapes) cannot be
+            // captured; run them eagerly from now on
+            cudaGetLastError();
+            entry.exec = nullptr;
+            entry.uncapturable = true;
+            ok = context_->enqueueV3(stream);
+            return cudaSuccess;
+        }
+
+        ++captures_;
+        return cudaGraphLaunch(entry.exec, stream);
+    }
+
+    void stats(int32_t* cached, int64_t* captures, int64_t* replays) const {
+        if (cached) {
+            int32_t count = 0;
+            for (const auto& graph : graphs_) {
+                count += graph.exec ? 1 : 0;
+            }
+            *cached = count;
+        }
+        if (captures) {
+            *captures = captures_;
+        }
+        if (replays) {
+            *replays = replays_;
+        }
+    }
+
+    void clear_graphs() {
+        evict_graphs(0);
+    }
+
+private:
+    // Per-tensor shape slots: rank, then up to TRTX_MAX_DIMS extents
+    static constexpr size_t kShapeSlots = 1 + TRTX_MAX_DIMS;
+
+    // Everything a captured graph bakes in
+    struct Configuration {
+        int32_t profile = 0;
+        // Activation memory is baked into captured graphs like tensor addresses
+        void* device_memory = nullptr;
+        // Indexed like the engine's IO tensors; rank 0 and no extents if unset
+        std::vector<void*> addresses;
+        std::vector<int64_t> shapes;
+        uint64_t hash = 0;
+
+        bool operator==(const Configuration& other) const {
+            return hash == other.hash && profile == other.profile &&
+                   device_memory == other.device_memory && addresses == other.addresses &&
+                   shapes == other.shapes;
+        }
+    };
+
+    struct GraphEntry {
+        Configuration configuration;
+        cudaGraphExec_t exec = nullptr;
+        bool warmed_up = false;
+        bool uncapturable = false;
+        uint64_t last_used = 0;
+    };
+
+    int32_t index_of(const char* name) const {
+        for (size_t i = 0; i < names_.size(); ++i) {
+            if (std::strcmp(names_[i], name) == 0) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    void record_shape(int32_t index, const nvinfer1::Dims& dims) {
+        int64_t* slots = &current_.shapes[index * kShapeSlots];
+        std::fill(slots, slots + kShapeSlots, 0);
+        int32_t rank = std::clamp<int32_t>(dims.nbDims, 0, TRTX_MAX_DIMS);
+        slots[0] = dims.nbDims;
+        std::copy(dims.d, dims.d + rank, slots + 1);
+    }
+
+    // FNV-1a over the raw configuration; entries still compare in full
+    static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void rehash_current() {
+        uint64_t hash = 14695981039346656037ull;
+        hash = hash_bytes(hash, &current_.profile, sizeof(current_.profile));
+        hash = hash_bytes(hash, &current_.device_memory, sizeof(current_.device_memory));
+        hash = hash_bytes(hash, current_.addresses.data(), current_.addresses.size() * sizeof(void*));
+        hash = hash_bytes(hash, current_.shapes.data(), current_.shapes.size() * sizeof(int64_t));
+        current_.hash = hash;
+    }
+
+    // Entry of the current configuration; a new one replaces the least
+    // recently used entry once max_graphs_ exist, captured or not
+    GraphEntry& find_or_insert_entry() {
+        rehash_current();
+        for (auto& entry : graphs_) {
+            if (entry.configuration == current_) {
+                return entry;
+            }
+        }
+
+        evict_graphs(max_graphs_ - 1);
+        graphs_.emplace_back();
+        GraphEntry& entry = graphs_.back();
+        entry.configuration = current_;
+        return entry;
+    }
+
+    // Drop least recently used entries until at most `limit` remain
+    void evict_graphs(int32_t limit) {
+        while (graphs_.size() > static_cast<size_t>(std::max<int32_t>(limit, 0))) {
+            auto oldest = graphs_.begin();
+            for (auto it = graphs_.begin(); it != graphs_.end(); ++it) {
+                if (it->last_used < oldest->last_used) {
+                    oldest = it;
+                }
+            }
+            if (oldest->exec) {
+                cudaGraphExecDestroy(oldest->exec);
+            }
+            graphs_.erase(oldest);
+        }
+    }
+
+    nvinfer1::IExecutionContext* context_;
+    // Config the context was created with, if any; outlives the context
+    std::unique_ptr<nvinfer1::IRuntimeConfig> runtime_config_;
+    // IO tensor names owned by the engine, by index
+    std::vector<const char*> names_;
+    bool graphs_enabled_ = false;
+    bool profiled_ = false;
+    int32_t max_graphs_ = 1;
+    Configuration current_;
+    // At most max_graphs_ entries, so a linear search is cheap
+    std::vector<GraphEntry> graphs_;
+    uint64_t clock_ = 0;
+    int64_t captures_ = 0;
+    int64_t replays_ = 0;
 };
 
 // Logger functions
@@ -70,6 +468,22 @@ void trtx_logger_destroy(TrtxLogger* logger) {
     }
 }
 
+int32_t trtx_logger_set_min_severity(
+    TrtxLogger* logger,
+    int32_t min_severity,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!logger || min_severity < TRTX_SEVERITY_INTERNAL_ERROR ||
+        min_severity > TRTX_SEVERITY_VERBOSE) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    reinterpret_cast<LoggerImpl*>(logger)->set_min_severity(min_severity);
+    return TRTX_SUCCESS;
+}
+
 // Builder functions
 int32_t trtx_builder_create(
     TrtxLogger* logger,
@@ -152,12 +566,11 @@ int32_t trtx_builder_build_serialized_network(
     TrtxBuilder* builder,
     TrtxNetworkDefinition* network,
     TrtxBuilderConfig* config,
-    void** out_data,
-    size_t* out_size,
+    TrtxHostMemory** out_memory,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!builder || !network || !config || !out_data || !out_size) {
+    if (!builder || !network || !config || !out_memory) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
@@ -173,24 +586,84 @@ int32_t trtx_builder_build_serialized_network(
             return TRTX_ERROR_RUNTIME_ERROR;
         }
 
-        // Copy data to heap so Rust can manage it
-        size_t size = serialized->size();
-        void* data = malloc(size);
-        if (!data) {
-            delete serialized;
-            copy_error("Failed to allocate memory", error_msg, error_msg_len);
-            return TRTX_ERROR_OUT_OF_MEMORY;
+        // Hand the IHostMemory itself to Rust; the plan is never copied
+        *out_memory = reinterpret_cast<TrtxHostMemory*>(serialized);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// Optimization profile functions
+int32_t trtx_builder_create_optimization_profile(
+    TrtxBuilder* builder,
+    TrtxOptimizationProfile** out_profile,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!builder || !out_profile) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* builder_impl = reinterpret_cast<nvinfer1::IBuilder*>(builder);
+        auto* profile = builder_impl->createOptimizationProfile();
+        if (!profile) {
+            copy_error("Failed to create optimization profile", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
         }
+        *out_profile = reinterpret_cast<TrtxOptimizationProfile*>(profile);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
 
-        memcpy(data, serialized->data(), size);
-        delete serialized;
+int32_t trtx_optimization_profile_set_dimensions(
+    TrtxOptimizationProfile* profile,
+    const char* input_name,
+    int32_t selector,
+    const TrtxDims* dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    nvinfer1::Dims trt_dims{};
+    if (!profile || !input_name || !dims || !to_trt_dims(*dims, trt_dims)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
 
-        *out_data = data;
-        *out_size = size;
+    TRTX_TRY_CATCH_BEGIN
+        auto* profile_impl = reinterpret_cast<nvinfer1::IOptimizationProfile*>(profile);
+        bool ok = profile_impl->setDimensions(
+            input_name, static_cast<nvinfer1::OptProfileSelector>(selector), trt_dims);
+        if (!ok) {
+            copy_error("Invalid profile dimensions", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
         return TRTX_SUCCESS;
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
+// HostMemory functions
+const void* trtx_host_memory_data(TrtxHostMemory* memory) {
+    if (!memory) {
+        return nullptr;
+    }
+    return reinterpret_cast<nvinfer1::IHostMemory*>(memory)->data();
+}
+
+size_t trtx_host_memory_size(TrtxHostMemory* memory) {
+    if (!memory) {
+        return 0;
+    }
+    return reinterpret_cast<nvinfer1::IHostMemory*>(memory)->size();
+}
+
+void trtx_host_memory_destroy(TrtxHostMemory* memory) {
+    if (memory) {
+        auto* impl = reinterpret_cast<nvinfer1::IHostMemory*>(memory);
+        delete impl;
+    }
+}
+
 // BuilderConfig functions
 void trtx_builder_config_destroy(TrtxBuilderConfig* config) {
     if (config) {
@@ -221,280 +694,2493 @@ int32_t trtx_builder_config_set_memory_pool_limit(
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-// NetworkDefinition functions
-void trtx_network_destroy(TrtxNetworkDefinition* network) {
-    if (network) {
-        auto* impl = reinterpret_cast<nvinfer1::INetworkDefinition*>(network);
-        delete impl;
-    }
-}
-
-// Runtime functions
-int32_t trtx_runtime_create(
-    TrtxLogger* logger,
-    TrtxRuntime** out_runtime,
+int32_t trtx_builder_config_add_optimization_profile(
+    TrtxBuilderConfig* config,
+    TrtxOptimizationProfile* profile,
+    int32_t* out_index,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!logger || !out_runtime) {
+    if (!config || !profile || !out_index) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
     TRTX_TRY_CATCH_BEGIN
-        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
-        auto* runtime = nvinfer1::createInferRuntime(*logger_impl);
-        if (!runtime) {
-            copy_error("Failed to create runtime", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        auto* profile_impl = reinterpret_cast<nvinfer1::IOptimizationProfile*>(profile);
+        int32_t index = config_impl->addOptimizationProfile(profile_impl);
+        if (index < 0) {
+            copy_error("Invalid optimization profile", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
         }
-        *out_runtime = reinterpret_cast<TrtxRuntime*>(runtime);
+        *out_index = index;
         return TRTX_SUCCESS;
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-void trtx_runtime_destroy(TrtxRuntime* runtime) {
-    if (runtime) {
-        auto* impl = reinterpret_cast<nvinfer1::IRuntime*>(runtime);
-        delete impl;
-    }
-}
-
-int32_t trtx_runtime_deserialize_cuda_engine(
-    TrtxRuntime* runtime,
-    const void* data,
-    size_t size,
-    TrtxCudaEngine** out_engine,
+int32_t trtx_builder_config_set_flag(
+    TrtxBuilderConfig* config,
+    int32_t flag,
+    int32_t enabled,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!runtime || !data || !out_engine) {
+    if (!config || flag < 0) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
     TRTX_TRY_CATCH_BEGIN
-        auto* runtime_impl = reinterpret_cast<nvinfer1::IRuntime*>(runtime);
-        auto* engine = runtime_impl->deserializeCudaEngine(data, size);
-        if (!engine) {
-            copy_error("Failed to deserialize engine", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        auto builder_flag = static_cast<nvinfer1::BuilderFlag>(flag);
+        if (enabled) {
+            config_impl->setFlag(builder_flag);
+        } else {
+            config_impl->clearFlag(builder_flag);
+        }
+        // setFlag has no status; flags this build does not support read back unchanged
+        if (config_impl->getFlag(builder_flag) != (enabled != 0)) {
+            copy_error("Builder flag not supported", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
         }
-        *out_engine = reinterpret_cast<TrtxCudaEngine*>(engine);
         return TRTX_SUCCESS;
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-// CudaEngine functions
-void trtx_cuda_engine_destroy(TrtxCudaEngine* engine) {
-    if (engine) {
-        auto* impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
-        delete impl;
+int32_t trtx_builder_config_get_flag(TrtxBuilderConfig* config, int32_t flag) {
+    if (!config || flag < 0) {
+        return 0;
     }
+    auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+    return config_impl->getFlag(static_cast<nvinfer1::BuilderFlag>(flag)) ? 1 : 0;
 }
 
-int32_t trtx_cuda_engine_create_execution_context(
-    TrtxCudaEngine* engine,
-    TrtxExecutionContext** out_context,
+int32_t trtx_builder_config_set_builder_optimization_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!engine || !out_context) {
+    if (!config) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
     TRTX_TRY_CATCH_BEGIN
-        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
-        auto* context = engine_impl->createExecutionContext();
-        if (!context) {
-            copy_error("Failed to create execution context", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        config_impl->setBuilderOptimizationLevel(level);
+        if (config_impl->getBuilderOptimizationLevel() != level) {
+            copy_error("Builder optimization level out of range", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
         }
-        *out_context = reinterpret_cast<TrtxExecutionContext*>(context);
         return TRTX_SUCCESS;
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-int32_t trtx_cuda_engine_get_tensor_name(
-    TrtxCudaEngine* engine,
-    int32_t index,
-    const char** out_name,
+int32_t trtx_builder_config_set_tactic_sources(
+    TrtxBuilderConfig* config,
+    uint32_t sources,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!engine || !out_name) {
+    if (!config) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
     TRTX_TRY_CATCH_BEGIN
-        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
-        const char* name = engine_impl->getIOTensorName(index);
-        if (!name) {
-            copy_error("Invalid tensor index", error_msg, error_msg_len);
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        if (!config_impl->setTacticSources(static_cast<nvinfer1::TacticSources>(sources))) {
+            copy_error("Unsupported tactic sources", error_msg, error_msg_len);
             return TRTX_ERROR_INVALID_ARGUMENT;
         }
-        *out_name = name;
         return TRTX_SUCCESS;
     TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-int32_t trtx_cuda_engine_get_nb_io_tensors(
-    TrtxCudaEngine* engine,
-    int32_t* out_count
+int32_t trtx_builder_config_set_max_aux_streams(
+    TrtxBuilderConfig* config,
+    int32_t nb_streams,
+    char* error_msg,
+    size_t error_msg_len
 ) {
-    if (!engine || !out_count) {
+    if (!config || nb_streams < 0) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
     TRTX_TRY_CATCH_BEGIN
-        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
-        *out_count = engine_impl->getNbIOTensors();
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        config_impl->setMaxAuxStreams(nb_streams);
         return TRTX_SUCCESS;
-    TRTX_TRY_CATCH_END(nullptr, 0)
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
 }
 
-// ExecutionContext functions
-void trtx_execution_context_destroy(TrtxExecutionContext* context) {
-    if (context) {
-        auto* impl = reinterpret_cast<nvinfer1::IExecutionContext*>(context);
-        delete impl;
+int32_t trtx_builder_config_set_profiling_verbosity(
+    TrtxBuilderConfig* config,
+    int32_t verbosity,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!config || verbosity < TRTX_PROFILING_VERBOSITY_LAYER_NAMES_ONLY ||
+        verbosity > TRTX_PROFILING_VERBOSITY_DETAILED) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        config_impl->setProfilingVerbosity(static_cast<nvinfer1::ProfilingVerbosity>(verbosity));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_builder_config_set_hardware_compatibility_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!config) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        auto compatibility = static_cast<nvinfer1::HardwareCompatibilityLevel>(level);
+        config_impl->setHardwareCompatibilityLevel(compatibility);
+        if (config_impl->getHardwareCompatibilityLevel() != compatibility) {
+            copy_error("Hardware compatibility level not supported", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_builder_config_set_compute_capabilities(
+    TrtxBuilderConfig* config,
+    const int32_t* capabilities,
+    int32_t count,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!config || count < 0 || (!capabilities && count > 0)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        if (!config_impl->setNbComputeCapabilities(count)) {
+            copy_error("Too many compute capabilities", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        for (int32_t i = 0; i < count; ++i) {
+            auto capability = static_cast<nvinfer1::ComputeCapability>(capabilities[i]);
+            if (!config_impl->setComputeCapability(capability, i)) {
+                copy_error("Unsupported compute capability", error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_builder_config_create_timing_cache(
+    TrtxBuilderConfig* config,
+    const void* blob,
+    size_t blob_size,
+    TrtxTimingCache** out_cache,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!config || !out_cache || (!blob && blob_size > 0)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        auto* cache = config_impl->createTimingCache(blob, blob_size);
+        if (!cache) {
+            copy_error("Failed to create timing cache", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_cache = reinterpret_cast<TrtxTimingCache*>(cache);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_builder_config_set_timing_cache(
+    TrtxBuilderConfig* config,
+    TrtxTimingCache* cache,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!config || !cache) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+        auto* cache_impl = reinterpret_cast<nvinfer1::ITimingCache*>(cache);
+        if (!config_impl->setTimingCache(*cache_impl, ignore_mismatch != 0)) {
+            copy_error("Timing cache does not match this device or TensorRT version",
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+const TrtxTimingCache* trtx_builder_config_get_timing_cache(TrtxBuilderConfig* config) {
+    if (!config) {
+        return nullptr;
+    }
+    auto* config_impl = reinterpret_cast<nvinfer1::IBuilderConfig*>(config);
+    return reinterpret_cast<const TrtxTimingCache*>(config_impl->getTimingCache());
+}
+
+// TimingCache functions
+void trtx_timing_cache_destroy(TrtxTimingCache* cache) {
+    if (cache) {
+        auto* impl = reinterpret_cast<nvinfer1::ITimingCache*>(cache);
+        delete impl;
+    }
+}
+
+int32_t trtx_timing_cache_serialize(
+    const TrtxTimingCache* cache,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!cache || !out_memory) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* cache_impl = reinterpret_cast<const nvinfer1::ITimingCache*>(cache);
+        auto* serialized = cache_impl->serialize();
+        if (!serialized) {
+            copy_error("Failed to serialize timing cache", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_memory = reinterpret_cast<TrtxHostMemory*>(serialized);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_timing_cache_combine(
+    TrtxTimingCache* cache,
+    const TrtxTimingCache* other,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!cache || !other) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* cache_impl = reinterpret_cast<nvinfer1::ITimingCache*>(cache);
+        auto* other_impl = reinterpret_cast<const nvinfer1::ITimingCache*>(other);
+        if (!cache_impl->combine(*other_impl, ignore_mismatch != 0)) {
+            copy_error("Failed to combine timing caches", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// NetworkDefinition functions
+void trtx_network_destroy(TrtxNetworkDefinition* network) {
+    if (network) {
+        auto* impl = reinterpret_cast<nvinfer1::INetworkDefinition*>(network);
+        delete impl;
+    }
+}
+
+// Runtime functions
+int32_t trtx_runtime_create(
+    TrtxLogger* logger,
+    TrtxRuntime** out_runtime,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!logger || !out_runtime) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
+        auto* runtime = nvinfer1::createInferRuntime(*logger_impl);
+        if (!runtime) {
+            copy_error("Failed to create runtime", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_runtime = reinterpret_cast<TrtxRuntime*>(runtime);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_runtime_destroy(TrtxRuntime* runtime) {
+    if (runtime) {
+        auto* impl = reinterpret_cast<nvinfer1::IRuntime*>(runtime);
+        delete impl;
+    }
+}
+
+int32_t trtx_runtime_deserialize_cuda_engine(
+    TrtxRuntime* runtime,
+    const void* data,
+    size_t size,
+    TrtxCudaEngine** out_engine,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!runtime || !data || !out_engine) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* runtime_impl = reinterpret_cast<nvinfer1::IRuntime*>(runtime);
+        auto* engine = runtime_impl->deserializeCudaEngine(data, size);
+        if (!engine) {
+            copy_error("Failed to deserialize engine", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_engine = reinterpret_cast<TrtxCudaEngine*>(engine);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// Read-only memory mapping of a whole file; pages are shared through the page cache
+class MappedFile {
+public:
+    explicit MappedFile(const char* path, const char* kind = "plan") {
+#ifdef _WIN32
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            error_ = std::string("Cannot open ") + kind + " file: " + path;
+            return;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            error_ = std::string("Cannot stat ") + kind + " file: " + path;
+            return;
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_) {
+            data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        }
+#else
+        fd_ = open(path, O_RDONLY);
+        if (fd_ < 0) {
+            error_ = std::string("Cannot open ") + kind + " file: " + path + ": " + strerror(errno);
+            return;
+        }
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            error_ = std::string("Cannot stat ") + kind + " file: " + path + ": " + strerror(errno);
+            return;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            return;
+        }
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (addr != MAP_FAILED) {
+            data_ = addr;
+            // Plans and weights are consumed front to back exactly once
+            madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+#endif
+        if (!data_) {
+            error_ = std::string("Cannot map ") + kind + " file: " + path;
+        }
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) munmap(data_, size_);
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return error_.empty() && size_ > 0; }
+    const std::string& error() const { return error_; }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(data_); }
+    size_t size() const { return size_; }
+
+private:
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    std::string error_;
+};
+
+#if TRTX_USE_STREAM_READER
+// Streams a mapped plan to TensorRT, which may ask for bytes to land in host or device memory
+class MappedFileReader : public nvinfer1::IStreamReaderV2 {
+public:
+    explicit MappedFileReader(const MappedFile& file) : file_(file) {}
+
+    int64_t read(void* destination, int64_t nbBytes, cudaStream_t stream) noexcept override {
+        if (!destination || nbBytes < 0 || offset_ >= file_.size()) {
+            return 0;
+        }
+        size_t count = std::min(static_cast<size_t>(nbBytes), file_.size() - offset_);
+        // cudaMemcpyDefault infers the direction, so this covers host and device destinations
+        if (cudaMemcpyAsync(destination, file_.data() + offset_, count, cudaMemcpyDefault, stream) != cudaSuccess) {
+            return -1;
+        }
+        offset_ += count;
+        return static_cast<int64_t>(count);
+    }
+
+    bool seek(int64_t offset, nvinfer1::SeekPosition where) noexcept override {
+        int64_t base = 0;
+        switch (where) {
+            case nvinfer1::SeekPosition::kSET: base = 0; break;
+            case nvinfer1::SeekPosition::kCUR: base = static_cast<int64_t>(offset_); break;
+            case nvinfer1::SeekPosition::kEND: base = static_cast<int64_t>(file_.size()); break;
+        }
+        int64_t target = base + offset;
+        if (target < 0 || target > static_cast<int64_t>(file_.size())) {
+            return false;
+        }
+        offset_ = static_cast<size_t>(target);
+        return true;
+    }
+
+private:
+    const MappedFile& file_;
+    size_t offset_ = 0;
+};
+#endif
+
+int32_t trtx_runtime_deserialize_cuda_engine_from_file(
+    TrtxRuntime* runtime,
+    const char* path,
+    TrtxCudaEngine** out_engine,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!runtime || !path || !out_engine) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        MappedFile file(path);
+        if (!file.ok()) {
+            copy_error(file.error().empty() ? "Plan file is empty" : file.error().c_str(),
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto* runtime_impl = reinterpret_cast<nvinfer1::IRuntime*>(runtime);
+#if TRTX_USE_STREAM_READER
+        MappedFileReader reader(file);
+        auto* engine = runtime_impl->deserializeCudaEngine(reader);
+#else
+        auto* engine = runtime_impl->deserializeCudaEngine(file.data(), file.size());
+#endif
+        if (!engine) {
+            copy_error("Failed to deserialize engine", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_engine = reinterpret_cast<TrtxCudaEngine*>(engine);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// CudaEngine functions
+void trtx_cuda_engine_destroy(TrtxCudaEngine* engine) {
+    if (engine) {
+        auto* impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        delete impl;
+    }
+}
+
+int32_t trtx_cuda_engine_create_execution_context(
+    TrtxCudaEngine* engine,
+    TrtxExecutionContext** out_context,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_context) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        auto* context = engine_impl->createExecutionContext();
+        if (!context) {
+            copy_error("Failed to create execution context", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_context = reinterpret_cast<TrtxExecutionContext*>(new ExecutionContextImpl(context));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_create_execution_context_with_strategy(
+    TrtxCudaEngine* engine,
+    int32_t strategy,
+    TrtxExecutionContext** out_context,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_context || strategy < TRTX_ALLOCATION_STRATEGY_STATIC ||
+        strategy > TRTX_ALLOCATION_STRATEGY_USER_MANAGED) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        auto* context = engine_impl->createExecutionContext(
+            static_cast<nvinfer1::ExecutionContextAllocationStrategy>(strategy));
+        if (!context) {
+            copy_error("Failed to create execution context", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_context = reinterpret_cast<TrtxExecutionContext*>(new ExecutionContextImpl(context));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// Runtime cache plus the config it was created from
+struct RuntimeCacheImpl {
+    std::unique_ptr<nvinfer1::IRuntimeConfig> config;
+    std::unique_ptr<nvinfer1::IRuntimeCache> cache;
+};
+
+int32_t trtx_cuda_engine_create_execution_context_with_cache(
+    TrtxCudaEngine* engine,
+    int32_t strategy,
+    TrtxRuntimeCache* cache,
+    TrtxExecutionContext** out_context,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_context || strategy < TRTX_ALLOCATION_STRATEGY_STATIC ||
+        strategy > TRTX_ALLOCATION_STRATEGY_USER_MANAGED) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        std::unique_ptr<nvinfer1::IRuntimeConfig> config(engine_impl->createRuntimeConfig());
+        if (!config) {
+            copy_error("Failed to create runtime config", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        config->setExecutionContextAllocationStrategy(
+            static_cast<nvinfer1::ExecutionContextAllocationStrategy>(strategy));
+        if (cache && !config->setRuntimeCache(*reinterpret_cast<RuntimeCacheImpl*>(cache)->cache)) {
+            copy_error("Failed to attach runtime cache", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        auto* context = engine_impl->createExecutionContext(config.get());
+        if (!context) {
+            copy_error("Failed to create execution context", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_context = reinterpret_cast<TrtxExecutionContext*>(
+            new ExecutionContextImpl(context, std::move(config)));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// RuntimeCache functions
+int32_t trtx_runtime_cache_create(
+    TrtxCudaEngine* engine,
+    const void* blob,
+    size_t blob_size,
+    TrtxRuntimeCache** out_cache,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_cache || (!blob && blob_size > 0)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        auto impl = std::make_unique<RuntimeCacheImpl>();
+        impl->config.reset(engine_impl->createRuntimeConfig());
+        if (!impl->config) {
+            copy_error("Failed to create runtime config", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        impl->cache.reset(impl->config->createRuntimeCache());
+        if (!impl->cache) {
+            copy_error("Failed to create runtime cache", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        if (blob_size > 0 && !impl->cache->deserialize(blob, blob_size)) {
+            copy_error("Runtime cache is corrupt or was written for another GPU or version",
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_cache = reinterpret_cast<TrtxRuntimeCache*>(impl.release());
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_runtime_cache_destroy(TrtxRuntimeCache* cache) {
+    delete reinterpret_cast<RuntimeCacheImpl*>(cache);
+}
+
+int32_t trtx_runtime_cache_serialize(
+    const TrtxRuntimeCache* cache,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!cache || !out_memory) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* impl = reinterpret_cast<const RuntimeCacheImpl*>(cache);
+        auto* memory = impl->cache->serialize();
+        if (!memory) {
+            copy_error("Failed to serialize runtime cache", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_memory = reinterpret_cast<TrtxHostMemory*>(memory);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_device_memory_size(
+    TrtxCudaEngine* engine,
+    int64_t* out_size
+) {
+    if (!engine || !out_size) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        *out_size = engine_impl->getDeviceMemorySizeV2();
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_cuda_engine_get_weight_streaming(
+    TrtxCudaEngine* engine,
+    int64_t* out_streamable_weights_size,
+    int64_t* out_budget,
+    int64_t* out_automatic_budget,
+    int64_t* out_scratch_memory_size
+) {
+    if (!engine) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        if (out_streamable_weights_size) {
+            *out_streamable_weights_size = engine_impl->getStreamableWeightsSize();
+        }
+        if (out_budget) {
+            *out_budget = engine_impl->getWeightStreamingBudgetV2();
+        }
+        if (out_automatic_budget) {
+            *out_automatic_budget = engine_impl->getWeightStreamingAutomaticBudget();
+        }
+        if (out_scratch_memory_size) {
+            *out_scratch_memory_size = engine_impl->getWeightStreamingScratchMemorySize();
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_cuda_engine_set_weight_streaming_budget(
+    TrtxCudaEngine* engine,
+    int64_t budget,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || budget < 0) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        if (!engine_impl->setWeightStreamingBudgetV2(budget)) {
+            copy_error("Failed to set the weight streaming budget; the engine must be built "
+                       "with weight streaming and have no execution contexts",
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_device_memory_size_for_profile(
+    TrtxCudaEngine* engine,
+    int32_t profile_index,
+    int64_t* out_size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_size) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        if (profile_index < 0 || profile_index >= engine_impl->getNbOptimizationProfiles()) {
+            copy_error("Invalid profile index", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_size = engine_impl->getDeviceMemorySizeForProfileV2(profile_index);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_tensor_name(
+    TrtxCudaEngine* engine,
+    int32_t index,
+    const char** out_name,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_name) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        const char* name = engine_impl->getIOTensorName(index);
+        if (!name) {
+            copy_error("Invalid tensor index", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_name = name;
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_nb_io_tensors(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+) {
+    if (!engine || !out_count) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        *out_count = engine_impl->getNbIOTensors();
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+// Resolve an IO tensor name, failing for names the engine does not know
+static nvinfer1::ICudaEngine* engine_with_tensor(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !tensor_name) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return nullptr;
+    }
+    auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+    if (engine_impl->getTensorIOMode(tensor_name) == nvinfer1::TensorIOMode::kNONE) {
+        copy_error((std::string("Unknown tensor: ") + tensor_name).c_str(), error_msg, error_msg_len);
+        return nullptr;
+    }
+    return engine_impl;
+}
+
+int32_t trtx_cuda_engine_get_tensor_shape(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, tensor_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_dims) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        if (!from_trt_dims(engine_impl->getTensorShape(tensor_name), *out_dims)) {
+            copy_error("Tensor has no valid shape", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_tensor_data_type(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_data_type,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, tensor_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_data_type) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_data_type = static_cast<int32_t>(engine_impl->getTensorDataType(tensor_name));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_tensor_io_mode(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_io_mode,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, tensor_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_io_mode) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_io_mode = static_cast<int32_t>(engine_impl->getTensorIOMode(tensor_name));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_tensor_format(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_format,
+    int32_t* out_vectorized_dim,
+    int32_t* out_components_per_element,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, tensor_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_format || !out_vectorized_dim || !out_components_per_element) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_format = static_cast<int32_t>(engine_impl->getTensorFormat(tensor_name));
+        *out_vectorized_dim = engine_impl->getTensorVectorizedDim(tensor_name);
+        *out_components_per_element = engine_impl->getTensorComponentsPerElement(tensor_name);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_tensor_bytes_per_component(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_bytes,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, tensor_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_bytes) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_bytes = engine_impl->getTensorBytesPerComponent(tensor_name);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_nb_optimization_profiles(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+) {
+    if (!engine || !out_count) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        *out_count = engine_impl->getNbOptimizationProfiles();
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_cuda_engine_get_profile_shape(
+    TrtxCudaEngine* engine,
+    const char* input_name,
+    int32_t profile_index,
+    int32_t selector,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = engine_with_tensor(engine, input_name, error_msg, error_msg_len);
+        if (!engine_impl || !out_dims) {
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        nvinfer1::Dims dims = engine_impl->getProfileShape(
+            input_name, profile_index, static_cast<nvinfer1::OptProfileSelector>(selector));
+        if (!from_trt_dims(dims, *out_dims)) {
+            copy_error("Invalid profile index or input", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_cuda_engine_get_nb_layers(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+) {
+    if (!engine || !out_count) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        *out_count = engine_impl->getNbLayers();
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_cuda_engine_create_engine_inspector(
+    TrtxCudaEngine* engine,
+    TrtxEngineInspector** out_inspector,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !out_inspector) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        auto* inspector = engine_impl->createEngineInspector();
+        if (!inspector) {
+            copy_error("Failed to create engine inspector", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_inspector = reinterpret_cast<TrtxEngineInspector*>(inspector);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// EngineInspector functions
+void trtx_engine_inspector_destroy(TrtxEngineInspector* inspector) {
+    if (inspector) {
+        delete reinterpret_cast<nvinfer1::IEngineInspector*>(inspector);
+    }
+}
+
+int32_t trtx_engine_inspector_set_execution_context(
+    TrtxEngineInspector* inspector,
+    TrtxExecutionContext* context,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!inspector) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* inspector_impl = reinterpret_cast<nvinfer1::IEngineInspector*>(inspector);
+        auto* context_impl =
+            context ? reinterpret_cast<ExecutionContextImpl*>(context)->get() : nullptr;
+        if (!inspector_impl->setExecutionContext(context_impl)) {
+            copy_error("Context does not belong to the inspected engine", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+static bool valid_layer_information_format(int32_t format) {
+    return format == TRTX_LAYER_INFORMATION_FORMAT_ONELINE ||
+           format == TRTX_LAYER_INFORMATION_FORMAT_JSON;
+}
+
+int32_t trtx_engine_inspector_get_layer_information(
+    TrtxEngineInspector* inspector,
+    int32_t layer_index,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!inspector || !out_info || !valid_layer_information_format(format)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* inspector_impl = reinterpret_cast<nvinfer1::IEngineInspector*>(inspector);
+        const char* info = inspector_impl->getLayerInformation(
+            layer_index, static_cast<nvinfer1::LayerInformationFormat>(format));
+        if (!info) {
+            copy_error("Layer index out of range", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        *out_info = info;
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_engine_inspector_get_engine_information(
+    TrtxEngineInspector* inspector,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!inspector || !out_info || !valid_layer_information_format(format)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* inspector_impl = reinterpret_cast<nvinfer1::IEngineInspector*>(inspector);
+        const char* info = inspector_impl->getEngineInformation(
+            static_cast<nvinfer1::LayerInformationFormat>(format));
+        if (!info) {
+            copy_error("Failed to get engine information", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        *out_info = info;
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// Profiler functions
+int32_t trtx_profiler_create(
+    TrtxProfilerCallback callback,
+    void* user_data,
+    TrtxProfiler** out_profiler,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!callback || !out_profiler) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto profiler = new ProfilerImpl(callback, user_data);
+        *out_profiler = reinterpret_cast<TrtxProfiler*>(profiler);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_profiler_destroy(TrtxProfiler* profiler) {
+    if (profiler) {
+        delete reinterpret_cast<ProfilerImpl*>(profiler);
+    }
+}
+
+// ExecutionContext functions
+void trtx_execution_context_destroy(TrtxExecutionContext* context) {
+    if (context) {
+        delete reinterpret_cast<ExecutionContextImpl*>(context);
+    }
+}
+
+int32_t trtx_execution_context_set_profiler(
+    TrtxExecutionContext* context,
+    TrtxProfiler* profiler,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        reinterpret_cast<ExecutionContextImpl*>(context)->set_profiler(
+            reinterpret_cast<ProfilerImpl*>(profiler));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_set_device_memory(
+    TrtxExecutionContext* context,
+    void* memory,
+    int64_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || !memory || size < 0) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        reinterpret_cast<ExecutionContextImpl*>(context)->set_device_memory(memory, size);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_update_device_memory_size_for_shapes(
+    TrtxExecutionContext* context,
+    int64_t* out_size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || !out_size) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context)->get();
+        *out_size = static_cast<int64_t>(context_impl->updateDeviceMemorySizeForShapes());
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_set_tensor_address(
+    TrtxExecutionContext* context,
+    const char* tensor_name,
+    void* data,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || !tensor_name) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context);
+        bool success = context_impl->set_tensor_address(tensor_name, data);
+        if (!success) {
+            copy_error("Failed to set tensor address", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_enqueue_v3(
+    TrtxExecutionContext* context,
+    void* cuda_stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context);
+        bool success = false;
+        cudaError_t status = context_impl->enqueue(static_cast<cudaStream_t>(cuda_stream), success);
+        if (status != cudaSuccess) {
+            copy_error(cudaGetErrorString(status), error_msg, error_msg_len);
+            return TRTX_ERROR_CUDA_ERROR;
+        }
+        if (!success) {
+            copy_error("Failed to enqueue inference", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_bind_and_enqueue(
+    TrtxExecutionContext* context,
+    const TrtxTensorBinding* bindings,
+    size_t nb_bindings,
+    void* cuda_stream,
+    int32_t synchronize,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || (!bindings && nb_bindings > 0)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context);
+        auto stream = static_cast<cudaStream_t>(cuda_stream);
+        int32_t nb_io = context_impl->nb_io_tensors();
+
+        // Shapes first: output shapes and device memory needs depend on them
+        for (size_t i = 0; i < nb_bindings; ++i) {
+            const TrtxTensorBinding& binding = bindings[i];
+            if (binding.index < 0 || binding.index >= nb_io) {
+                copy_error("Tensor index out of range", error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+            if (binding.shape.nb_dims < 0) {
+                continue;
+            }
+            nvinfer1::Dims trt_dims{};
+            if (!to_trt_dims(binding.shape, trt_dims)) {
+                copy_error("Invalid input shape", error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+            if (!context_impl->set_input_shape_at(binding.index, trt_dims)) {
+                copy_error("Input shape is outside the active optimization profile", error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+        }
+
+        for (size_t i = 0; i < nb_bindings; ++i) {
+            const TrtxTensorBinding& binding = bindings[i];
+            if (binding.address &&
+                !context_impl->set_tensor_address_at(binding.index, binding.address)) {
+                copy_error("Failed to set tensor address", error_msg, error_msg_len);
+                return TRTX_ERROR_RUNTIME_ERROR;
+            }
+        }
+
+        for (size_t i = 0; i < nb_bindings; ++i) {
+            const TrtxTensorBinding& binding = bindings[i];
+            if (!binding.host_input) {
+                continue;
+            }
+            void* device = context_impl->tensor_address(binding.index);
+            cudaError_t status = cudaMemcpyAsync(
+                device, binding.host_input, binding.host_input_size, cudaMemcpyHostToDevice, stream);
+            if (status != cudaSuccess) {
+                copy_error(cudaGetErrorString(status), error_msg, error_msg_len);
+                return TRTX_ERROR_CUDA_ERROR;
+            }
+        }
+
+        bool success = false;
+        cudaError_t status = context_impl->enqueue(stream, success);
+        if (status != cudaSuccess) {
+            copy_error(cudaGetErrorString(status), error_msg, error_msg_len);
+            return TRTX_ERROR_CUDA_ERROR;
+        }
+        if (!success) {
+            copy_error("Failed to enqueue inference", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        for (size_t i = 0; i < nb_bindings; ++i) {
+            const TrtxTensorBinding& binding = bindings[i];
+            if (!binding.host_output) {
+                continue;
+            }
+            const void* device = context_impl->tensor_address(binding.index);
+            status = cudaMemcpyAsync(
+                binding.host_output, device, binding.host_output_size, cudaMemcpyDeviceToHost, stream);
+            if (status != cudaSuccess) {
+                copy_error(cudaGetErrorString(status), error_msg, error_msg_len);
+                return TRTX_ERROR_CUDA_ERROR;
+            }
+        }
+
+        if (synchronize) {
+            status = cudaStreamSynchronize(stream);
+            if (status != cudaSuccess) {
+                copy_error(cudaGetErrorString(status), error_msg, error_msg_len);
+                return TRTX_ERROR_CUDA_ERROR;
+            }
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_set_input_shape(
+    TrtxExecutionContext* context,
+    const char* input_name,
+    const TrtxDims* dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    nvinfer1::Dims trt_dims{};
+    if (!context || !input_name || !dims || !to_trt_dims(*dims, trt_dims)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context);
+        if (!context_impl->set_input_shape(input_name, trt_dims)) {
+            copy_error("Input shape is outside the active optimization profile", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_get_tensor_shape(
+    TrtxExecutionContext* context,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || !tensor_name || !out_dims) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context)->get();
+        if (!from_trt_dims(context_impl->getTensorShape(tensor_name), *out_dims)) {
+            copy_error("Unknown tensor or unresolved shape", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_set_optimization_profile_async(
+    TrtxExecutionContext* context,
+    int32_t profile_index,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* context_impl = reinterpret_cast<ExecutionContextImpl*>(context);
+        bool ok = context_impl->set_optimization_profile_async(
+            profile_index, reinterpret_cast<cudaStream_t>(stream));
+        if (!ok) {
+            copy_error("Failed to switch optimization profile", error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_execution_context_set_cuda_graphs(
+    TrtxExecutionContext* context,
+    int32_t enabled,
+    int32_t max_graphs,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!context || max_graphs < 1) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        reinterpret_cast<ExecutionContextImpl*>(context)->set_graphs_enabled(enabled != 0, max_graphs);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_execution_context_get_cuda_graph_stats(
+    TrtxExecutionContext* context,
+    int32_t* out_cached_graphs,
+    int64_t* out_captures,
+    int64_t* out_replays
+) {
+    if (context) {
+        reinterpret_cast<ExecutionContextImpl*>(context)->stats(
+            out_cached_graphs, out_captures, out_replays);
+    }
+}
+
+// Utility functions
+void trtx_free_buffer(void* buffer) {
+    free(buffer);
+}
+
+int32_t trtx_get_tensorrt_version() {
+    return getInferLibVersion();
+}
+
+// ONNX Parser functions
+// Record every error of an IParser or IParserRefitter, not just the first:
+// a failing node often causes later ones
+template <typename Parser>
+static void copy_parser_errors(const Parser& parser, const char* fallback, char* error_msg, size_t error_msg_len) {
+    int32_t num_errors = parser.getNbErrors();
+    if (num_errors <= 0) {
+        copy_error(fallback, error_msg, error_msg_len);
+        return;
+    }
+    std::string message;
+    for (int32_t i = 0; i < num_errors; ++i) {
+        auto* error = parser.getError(i);
+        if (i > 0) {
+            message += '\n';
+        }
+        message += error->desc();
+        if (error->node() >= 0) {
+            message += " (node " + std::to_string(error->node());
+            if (error->nodeName() && *error->nodeName()) {
+                message += " '" + std::string(error->nodeName()) + "'";
+            }
+            if (error->nodeOperator() && *error->nodeOperator()) {
+                message += ", " + std::string(error->nodeOperator());
+            }
+            message += ")";
+        }
+    }
+    copy_error(message.c_str(), error_msg, error_msg_len);
+}
+
+// Parser plus the memory maps it was handed initializers from. The network
+// references that memory until it is built, so the maps live as long as the parser.
+class OnnxParserImpl {
+public:
+    explicit OnnxParserImpl(nvonnxparser::IParser* parser) : parser_(parser) {}
+
+    nvonnxparser::IParser* get() const { return parser_.get(); }
+
+    const MappedFile& map(const std::string& path, const char* kind) {
+        mapped_.push_back(std::make_unique<MappedFile>(path.c_str(), kind));
+        return *mapped_.back();
+    }
+
+private:
+    std::unique_ptr<nvonnxparser::IParser> parser_;
+    std::vector<std::unique_ptr<MappedFile>> mapped_;
+};
+
+// Just enough of the protobuf wire format to walk an ONNX ModelProto
+class ProtoReader {
+public:
+    ProtoReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+    // Read the next field; for length-delimited fields `value` is the length
+    // and `data` points at the payload. False at the end or on malformed input.
+    bool next(uint32_t& field, uint64_t& value, const uint8_t*& data) {
+        uint64_t key = 0;
+        if (p_ >= end_ || !varint(key)) {
+            return false;
+        }
+        field = static_cast<uint32_t>(key >> 3);
+        data = nullptr;
+        switch (key & 7) {
+            case 0: return varint(value);
+            case 1: return skip(8);
+            case 5: return skip(4);
+            case 2:
+                if (!varint(value) || value > static_cast<uint64_t>(end_ - p_)) {
+                    return false;
+                }
+                data = p_;
+                p_ += value;
+                return true;
+            default: return false;
+        }
+    }
+
+private:
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && p_ < end_; shift += 7) {
+            uint8_t byte = *p_++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool skip(size_t n) {
+        if (static_cast<size_t>(end_ - p_) < n) {
+            return false;
+        }
+        p_ += n;
+        return true;
+    }
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+};
+
+// An initializer of the main graph whose values live in an external data file
+struct ExternalInitializer {
+    std::string name;
+    std::string location;
+    uint64_t offset = 0;
+    int64_t length = -1;
+};
+
+// ModelProto.graph = 7, GraphProto.initializer = 5; TensorProto.name = 8,
+// external_data = 13 (key = 1, value = 2) and data_location = 14 (EXTERNAL = 1)
+static std::vector<ExternalInitializer> find_external_initializers(const uint8_t* data, size_t size) {
+    std::vector<ExternalInitializer> found;
+    uint32_t field;
+    uint64_t value;
+    const uint8_t* payload;
+
+    ProtoReader model(data, size);
+    while (model.next(field, value, payload)) {
+        if (field != 7 || !payload) continue;
+        ProtoReader graph(payload, value);
+        uint32_t graph_field;
+        uint64_t graph_value;
+        const uint8_t* graph_payload;
+        while (graph.next(graph_field, graph_value, graph_payload)) {
+            if (graph_field != 5 || !graph_payload) continue;
+            ExternalInitializer init;
+            bool external = false;
+            ProtoReader tensor(graph_payload, graph_value);
+            uint32_t tensor_field;
+            uint64_t tensor_value;
+            const uint8_t* tensor_payload;
+            while (tensor.next(tensor_field, tensor_value, tensor_payload)) {
+                if (tensor_field == 8 && tensor_payload) {
+                    init.name.assign(reinterpret_cast<const char*>(tensor_payload), tensor_value);
+                } else if (tensor_field == 14 && !tensor_payload) {
+                    external = tensor_value == 1;
+                } else if (tensor_field == 13 && tensor_payload) {
+                    std::string key, entry;
+                    ProtoReader kv(tensor_payload, tensor_value);
+                    uint32_t kv_field;
+                    uint64_t kv_value;
+                    const uint8_t* kv_payload;
+                    while (kv.next(kv_field, kv_value, kv_payload)) {
+                        if (!kv_payload) continue;
+                        std::string text(reinterpret_cast<const char*>(kv_payload), kv_value);
+                        if (kv_field == 1) key = std::move(text);
+                        else if (kv_field == 2) entry = std::move(text);
+                    }
+                    if (key == "location") init.location = entry;
+                    else if (key == "offset") init.offset = std::stoull(entry);
+                    else if (key == "length") init.length = std::stoll(entry);
+                }
+            }
+            if (external && !init.name.empty() && !init.location.empty()) {
+                found.push_back(std::move(init));
+            }
+        }
+    }
+    return found;
+}
+
+// Fault the given ranges of mapped files into memory on several threads, so
+// the disk reads overlap instead of happening one page fault at a time
+static void prefault_parallel(const std::vector<std::pair<const uint8_t*, size_t>>& ranges, int32_t num_threads) {
+    constexpr size_t kPage = 4096;
+    size_t total = 0;
+    for (const auto& range : ranges) total += range.second;
+    if (num_threads <= 0) {
+        num_threads = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    if (num_threads == 1 || total == 0) {
+        return;
+    }
+
+    // Byte range [begin, end) of the concatenated ranges handled by one thread
+    size_t share = (total + num_threads - 1) / num_threads;
+    std::vector<std::thread> threads;
+    for (size_t begin = 0; begin < total; begin += share) {
+        size_t end = std::min(total, begin + share);
+        threads.emplace_back([&ranges, begin, end] {
+            volatile uint8_t sink = 0;
+            size_t base = 0;
+            for (const auto& range : ranges) {
+                size_t lo = std::max(begin, base), hi = std::min(end, base + range.second);
+                for (size_t i = lo; i < hi; i += kPage) {
+                    sink = sink + range.first[i - base];
+                }
+                base += range.second;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+int32_t trtx_onnx_parser_create(
+    TrtxNetworkDefinition* network,
+    TrtxLogger* logger,
+    TrtxOnnxParser** out_parser,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!network || !logger || !out_parser) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* network_impl = reinterpret_cast<nvinfer1::INetworkDefinition*>(network);
+        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
+
+        auto* parser = nvonnxparser::createParser(*network_impl, *logger_impl);
+        if (!parser) {
+            copy_error("Failed to create ONNX parser", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        *out_parser = reinterpret_cast<TrtxOnnxParser*>(new OnnxParserImpl(parser));
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_onnx_parser_destroy(TrtxOnnxParser* parser) {
+    if (parser) {
+        delete reinterpret_cast<OnnxParserImpl*>(parser);
+    }
+}
+
+int32_t trtx_onnx_parser_parse(
+    TrtxOnnxParser* parser,
+    const void* model_data,
+    size_t model_size,
+    const char* model_path,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!parser || !model_data) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* parser_impl = reinterpret_cast<OnnxParserImpl*>(parser)->get();
+
+        bool success = parser_impl->parse(model_data, model_size, model_path);
+        if (!success) {
+            copy_parser_errors(*parser_impl, "Failed to parse ONNX model", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_onnx_parser_parse_from_file(
+    TrtxOnnxParser* parser,
+    const char* path,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!parser || !path) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* parser_impl = reinterpret_cast<OnnxParserImpl*>(parser)->get();
+
+        // The parser logs through the network's logger; let its filter decide
+        bool success = parser_impl->parseFromFile(
+            path, static_cast<int32_t>(nvinfer1::ILogger::Severity::kVERBOSE));
+        if (!success) {
+            copy_parser_errors(*parser_impl, "Failed to parse ONNX model file", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_onnx_parser_parse_mapped(
+    TrtxOnnxParser* parser,
+    const char* path,
+    int32_t num_threads,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!parser || !path) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* impl = reinterpret_cast<OnnxParserImpl*>(parser);
+        auto* parser_impl = impl->get();
+
+        const MappedFile& model = impl->map(path, "ONNX model");
+        if (!model.ok()) {
+            copy_error(model.error().empty() ? "ONNX model file is empty" : model.error().c_str(),
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        if (!parser_impl->loadModelProto(model.data(), model.size(), path)) {
+            copy_parser_errors(*parser_impl, "Failed to load ONNX model", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        // External data locations are relative to the directory of the model
+        std::string model_path(path);
+        size_t slash = model_path.find_last_of("/\\");
+        std::string directory = slash == std::string::npos ? "" : model_path.substr(0, slash + 1);
+
+        std::vector<ExternalInitializer> initializers = find_external_initializers(model.data(), model.size());
+        std::map<std::string, const MappedFile*> files;
+        std::vector<std::pair<const uint8_t*, size_t>> ranges;
+        for (const auto& init : initializers) {
+            auto it = files.find(init.location);
+            if (it == files.end()) {
+                it = files.emplace(init.location, &impl->map(directory + init.location, "external data")).first;
+            }
+            const MappedFile& file = *it->second;
+            if (!file.ok()) {
+                std::string message = file.error().empty()
+                    ? "External data file '" + init.location + "' is empty"
+                    : file.error();
+                copy_error(message.c_str(), error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+            size_t length = init.length < 0 ? file.size() - std::min<size_t>(init.offset, file.size())
+                                             : static_cast<size_t>(init.length);
+            if (init.offset > file.size() || length > file.size() - init.offset) {
+                std::string message = "Initializer '" + init.name + "' lies outside '" + init.location + "'";
+                copy_error(message.c_str(), error_msg, error_msg_len);
+                return TRTX_ERROR_INVALID_ARGUMENT;
+            }
+            ranges.emplace_back(file.data() + init.offset, length);
+        }
+
+        prefault_parallel(ranges, num_threads);
+        for (size_t i = 0; i < initializers.size(); ++i) {
+            if (!parser_impl->loadInitializer(initializers[i].name.c_str(), ranges[i].first, ranges[i].second)) {
+                copy_parser_errors(*parser_impl, "Failed to load ONNX initializer", error_msg, error_msg_len);
+                return TRTX_ERROR_RUNTIME_ERROR;
+            }
+        }
+
+        if (!parser_impl->parseModelProto()) {
+            copy_parser_errors(*parser_impl, "Failed to parse ONNX model", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_onnx_parser_supports_model(
+    TrtxOnnxParser* parser,
+    const void* model_data,
+    size_t model_size,
+    const char* model_path,
+    int32_t* out_supported,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!parser || !model_data || !out_supported) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* parser_impl = reinterpret_cast<OnnxParserImpl*>(parser)->get();
+
+        *out_supported = parser_impl->supportsModelV2(model_data, model_size, model_path) ? 1 : 0;
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_onnx_parser_get_nb_subgraphs(
+    TrtxOnnxParser* parser,
+    int64_t* out_count
+) {
+    if (!parser || !out_count) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        *out_count = reinterpret_cast<OnnxParserImpl*>(parser)->get()->getNbSubgraphs();
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_onnx_parser_get_subgraph(
+    TrtxOnnxParser* parser,
+    int64_t index,
+    int32_t* out_supported,
+    const int64_t** out_nodes,
+    int64_t* out_nb_nodes
+) {
+    if (!parser || !out_supported || !out_nodes || !out_nb_nodes) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* parser_impl = reinterpret_cast<OnnxParserImpl*>(parser)->get();
+        if (index < 0 || index >= parser_impl->getNbSubgraphs()) {
+            copy_error("Invalid subgraph index", nullptr, 0);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+
+        int64_t length = 0;
+        *out_nodes = parser_impl->getSubgraphNodes(index, length);
+        *out_nb_nodes = *out_nodes ? length : 0;
+        *out_supported = parser_impl->isSubgraphSupported(index) ? 1 : 0;
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+// Refitter functions
+int32_t trtx_refitter_create(
+    TrtxCudaEngine* engine,
+    TrtxLogger* logger,
+    TrtxRefitter** out_refitter,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!engine || !logger || !out_refitter) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* engine_impl = reinterpret_cast<nvinfer1::ICudaEngine*>(engine);
+        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
+
+        auto* refitter = nvinfer1::createInferRefitter(*engine_impl, *logger_impl);
+        if (!refitter) {
+            copy_error("Failed to create refitter; the engine must be built with a refit flag",
+                       error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        *out_refitter = reinterpret_cast<TrtxRefitter*>(refitter);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_refitter_destroy(TrtxRefitter* refitter) {
+    if (refitter) {
+        delete reinterpret_cast<nvinfer1::IRefitter*>(refitter);
+    }
+}
+
+int32_t trtx_refitter_set_named_weights(
+    TrtxRefitter* refitter,
+    const char* name,
+    int32_t data_type,
+    const void* values,
+    int64_t count,
+    int32_t location,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!refitter || !name || (!values && count > 0) || count < 0 ||
+        (location != TRTX_TENSOR_LOCATION_DEVICE && location != TRTX_TENSOR_LOCATION_HOST)) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* refitter_impl = reinterpret_cast<nvinfer1::IRefitter*>(refitter);
+        nvinfer1::Weights weights{static_cast<nvinfer1::DataType>(data_type), values, count};
+        if (!refitter_impl->setNamedWeights(name, weights, static_cast<nvinfer1::TensorLocation>(location))) {
+            std::string message = std::string("Cannot refit weights '") + name +
+                                  "': unknown name, or wrong type or count";
+            copy_error(message.c_str(), error_msg, error_msg_len);
+            return TRTX_ERROR_INVALID_ARGUMENT;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_refitter_get_weight_names(
+    TrtxRefitter* refitter,
+    int32_t missing_only,
+    int32_t size,
+    const char** out_names,
+    int32_t* out_count
+) {
+    if (!refitter || !out_count || size < 0 || (size > 0 && !out_names)) {
+        copy_error("Invalid arguments", nullptr, 0);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* refitter_impl = reinterpret_cast<nvinfer1::IRefitter*>(refitter);
+        *out_count = missing_only ? refitter_impl->getMissingWeights(size, out_names)
+                                  : refitter_impl->getAllWeights(size, out_names);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(nullptr, 0)
+}
+
+int32_t trtx_refitter_refit_cuda_engine_async(
+    TrtxRefitter* refitter,
+    void* cuda_stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!refitter) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* refitter_impl = reinterpret_cast<nvinfer1::IRefitter*>(refitter);
+        if (!refitter_impl->refitCudaEngineAsync(static_cast<cudaStream_t>(cuda_stream))) {
+            copy_error("Refit failed; check for missing weights", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+int32_t trtx_parser_refitter_create(
+    TrtxRefitter* refitter,
+    TrtxLogger* logger,
+    TrtxParserRefitter** out_parser_refitter,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!refitter || !logger || !out_parser_refitter) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* refitter_impl = reinterpret_cast<nvinfer1::IRefitter*>(refitter);
+        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
+
+        auto* parser_refitter = nvonnxparser::createParserRefitter(*refitter_impl, *logger_impl);
+        if (!parser_refitter) {
+            copy_error("Failed to create ONNX parser refitter", error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+
+        *out_parser_refitter = reinterpret_cast<TrtxParserRefitter*>(parser_refitter);
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+void trtx_parser_refitter_destroy(TrtxParserRefitter* parser_refitter) {
+    if (parser_refitter) {
+        delete reinterpret_cast<nvonnxparser::IParserRefitter*>(parser_refitter);
+    }
+}
+
+int32_t trtx_parser_refitter_refit_from_bytes(
+    TrtxParserRefitter* parser_refitter,
+    const void* model_data,
+    size_t model_size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!parser_refitter || !model_data) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    TRTX_TRY_CATCH_BEGIN
+        auto* parser_impl = reinterpret_cast<nvonnxparser::IParserRefitter*>(parser_refitter);
+        if (!parser_impl->refitFromBytes(model_data, model_size)) {
+            copy_parser_errors(*parser_impl, "Failed to read refit weights from ONNX model",
+                               error_msg, error_msg_len);
+            return TRTX_ERROR_RUNTIME_ERROR;
+        }
+        return TRTX_SUCCESS;
+    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+}
+
+// CUDA Memory Management functions
+
+int32_t trtx_cuda_malloc(
+    void** ptr,
+    size_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaMalloc(ptr, size);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_free(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        return TRTX_SUCCESS; // Freeing null is not an error
+    }
+
+    cudaError_t err = cudaFree(ptr);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+// Stream-ordered allocation
+int32_t trtx_cuda_malloc_async(
+    void** ptr,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaMallocAsync(ptr, size, reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_free_async(
+    void* ptr,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        return TRTX_SUCCESS; // Freeing null is not an error
+    }
+
+    cudaError_t err = cudaFreeAsync(ptr, reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_mem_pool_set_release_threshold(
+    uint64_t threshold,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    int device = 0;
+    cudaError_t err = cudaGetDevice(&device);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    cudaMemPool_t pool = nullptr;
+    err = cudaDeviceGetDefaultMemPool(&pool, device);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    err = cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold, &threshold);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+// Pinned (page-locked) host memory functions
+int32_t trtx_cuda_host_alloc(
+    void** ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaHostAlloc(ptr, size, flags);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_free_host(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        return TRTX_SUCCESS; // Freeing null is not an error
+    }
+
+    cudaError_t err = cudaFreeHost(ptr);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_host_register(
+    void* ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaHostRegister(ptr, size, flags);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_host_unregister(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaHostUnregister(ptr);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_host_get_device_pointer(
+    void* host_ptr,
+    void** out_device_ptr,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!host_ptr || !out_device_ptr) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaHostGetDevicePointer(out_device_ptr, host_ptr, 0);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_memcpy_host_to_device(
+    void* dst,
+    const void* src,
+    size_t size,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!dst || !src) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaMemcpy(dst, src, size, cudaMemcpyHostToDevice);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
     }
+
+    return TRTX_SUCCESS;
 }
 
-int32_t trtx_execution_context_set_tensor_address(
-    TrtxExecutionContext* context,
-    const char* tensor_name,
-    void* data,
+int32_t trtx_cuda_memcpy_device_to_host(
+    void* dst,
+    const void* src,
+    size_t size,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!context || !tensor_name) {
+    if (!dst || !src) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    TRTX_TRY_CATCH_BEGIN
-        auto* context_impl = reinterpret_cast<nvinfer1::IExecutionContext*>(context);
-        bool success = context_impl->setTensorAddress(tensor_name, data);
-        if (!success) {
-            copy_error("Failed to set tensor address", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
-        }
-        return TRTX_SUCCESS;
-    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+    cudaError_t err = cudaMemcpy(dst, src, size, cudaMemcpyDeviceToHost);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
 }
 
-int32_t trtx_execution_context_enqueue_v3(
-    TrtxExecutionContext* context,
-    void* cuda_stream,
+int32_t trtx_cuda_synchronize(
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!context) {
+    cudaError_t err = cudaDeviceSynchronize();
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_memcpy_host_to_device_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!dst || !src) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    TRTX_TRY_CATCH_BEGIN
-        auto* context_impl = reinterpret_cast<nvinfer1::IExecutionContext*>(context);
-        bool success = context_impl->enqueueV3(static_cast<cudaStream_t>(cuda_stream));
-        if (!success) {
-            copy_error("Failed to enqueue inference", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
-        }
-        return TRTX_SUCCESS;
-    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+    cudaError_t err = cudaMemcpyAsync(
+        dst, src, size, cudaMemcpyHostToDevice, reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
 }
 
-// Utility functions
-void trtx_free_buffer(void* buffer) {
-    free(buffer);
+int32_t trtx_cuda_memcpy_device_to_host_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!dst || !src) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaMemcpyAsync(
+        dst, src, size, cudaMemcpyDeviceToHost, reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
 }
 
-// ONNX Parser functions
-int32_t trtx_onnx_parser_create(
-    TrtxNetworkDefinition* network,
-    TrtxLogger* logger,
-    TrtxOnnxParser** out_parser,
+// CUDA stream functions
+int32_t trtx_cuda_stream_create(
+    uint32_t flags,
+    int32_t priority,
+    TrtxCudaStream** out_stream,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!network || !logger || !out_parser) {
+    if (!out_stream) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    TRTX_TRY_CATCH_BEGIN
-        auto* network_impl = reinterpret_cast<nvinfer1::INetworkDefinition*>(network);
-        auto* logger_impl = reinterpret_cast<LoggerImpl*>(logger);
+    cudaStream_t stream = nullptr;
+    cudaError_t err = cudaStreamCreateWithPriority(&stream, flags, priority);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
 
-        auto* parser = nvonnxparser::createParser(*network_impl, *logger_impl);
-        if (!parser) {
-            copy_error("Failed to create ONNX parser", error_msg, error_msg_len);
-            return TRTX_ERROR_RUNTIME_ERROR;
-        }
+    *out_stream = reinterpret_cast<TrtxCudaStream*>(stream);
+    return TRTX_SUCCESS;
+}
 
-        *out_parser = reinterpret_cast<TrtxOnnxParser*>(parser);
-        return TRTX_SUCCESS;
-    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+void trtx_cuda_stream_destroy(TrtxCudaStream* stream) {
+    if (stream) {
+        cudaStreamDestroy(reinterpret_cast<cudaStream_t>(stream));
+    }
 }
 
-void trtx_onnx_parser_destroy(TrtxOnnxParser* parser) {
-    if (parser) {
-        auto* impl = reinterpret_cast<nvonnxparser::IParser*>(parser);
-        delete impl;
+int32_t trtx_cuda_stream_synchronize(
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    cudaError_t err = cudaStreamSynchronize(reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
     }
+
+    return TRTX_SUCCESS;
 }
 
-int32_t trtx_onnx_parser_parse(
-    TrtxOnnxParser* parser,
-    const void* model_data,
-    size_t model_size,
+int32_t trtx_cuda_event_create(
+    uint32_t flags,
+    TrtxCudaEvent** out_event,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!parser || !model_data) {
+    if (!out_event) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    TRTX_TRY_CATCH_BEGIN
-        auto* parser_impl = reinterpret_cast<nvonnxparser::IParser*>(parser);
+    cudaEvent_t event = nullptr;
+    cudaError_t err = cudaEventCreateWithFlags(&event, flags);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
 
-        bool success = parser_impl->parse(model_data, model_size);
-        if (!success) {
-            // Get error from parser
-            int32_t num_errors = parser_impl->getNbErrors();
-            if (num_errors > 0) {
-                auto* first_error = parser_impl->getError(0);
-                copy_error(first_error->desc(), error_msg, error_msg_len);
-            } else {
-                copy_error("Failed to parse ONNX model", error_msg, error_msg_len);
-            }
-            return TRTX_ERROR_RUNTIME_ERROR;
-        }
+    *out_event = reinterpret_cast<TrtxCudaEvent*>(event);
+    return TRTX_SUCCESS;
+}
+
+void trtx_cuda_event_destroy(TrtxCudaEvent* event) {
+    if (event) {
+        cudaEventDestroy(reinterpret_cast<cudaEvent_t>(event));
+    }
+}
+
+int32_t trtx_cuda_event_record(
+    TrtxCudaEvent* event,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!event) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    cudaError_t err = cudaEventRecord(
+        reinterpret_cast<cudaEvent_t>(event), reinterpret_cast<cudaStream_t>(stream));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_event_query(
+    TrtxCudaEvent* event,
+    int32_t* out_complete,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!event || !out_complete) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
 
+    cudaError_t err = cudaEventQuery(reinterpret_cast<cudaEvent_t>(event));
+    if (err == cudaErrorNotReady) {
+        *out_complete = 0;
         return TRTX_SUCCESS;
-    TRTX_TRY_CATCH_END(error_msg, error_msg_len)
+    }
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    *out_complete = 1;
+    return TRTX_SUCCESS;
 }
 
-// CUDA Memory Management functions
-#include <cuda_runtime.h>
+int32_t trtx_cuda_event_synchronize(
+    TrtxCudaEvent* event,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!event) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
 
-int32_t trtx_cuda_malloc(
-    void** ptr,
-    size_t size,
+    cudaError_t err = cudaEventSynchronize(reinterpret_cast<cudaEvent_t>(event));
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_event_elapsed_time(
+    TrtxCudaEvent* start,
+    TrtxCudaEvent* end,
+    float* out_ms,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!ptr) {
+    if (!start || !end || !out_ms) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    cudaError_t err = cudaMalloc(ptr, size);
+    cudaError_t err = cudaEventElapsedTime(
+        out_ms, reinterpret_cast<cudaEvent_t>(start), reinterpret_cast<cudaEvent_t>(end));
     if (err != cudaSuccess) {
         copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
         return TRTX_ERROR_CUDA_ERROR;
@@ -503,16 +3189,19 @@ int32_t trtx_cuda_malloc(
     return TRTX_SUCCESS;
 }
 
-int32_t trtx_cuda_free(
-    void* ptr,
+int32_t trtx_cuda_stream_wait_event(
+    TrtxCudaStream* stream,
+    TrtxCudaEvent* event,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!ptr) {
-        return TRTX_SUCCESS; // Freeing null is not an error
+    if (!event) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    cudaError_t err = cudaFree(ptr);
+    cudaError_t err = cudaStreamWaitEvent(
+        reinterpret_cast<cudaStream_t>(stream), reinterpret_cast<cudaEvent_t>(event), 0);
     if (err != cudaSuccess) {
         copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
         return TRTX_ERROR_CUDA_ERROR;
@@ -521,19 +3210,20 @@ int32_t trtx_cuda_free(
     return TRTX_SUCCESS;
 }
 
-int32_t trtx_cuda_memcpy_host_to_device(
-    void* dst,
-    const void* src,
-    size_t size,
+int32_t trtx_cuda_launch_host_func(
+    TrtxCudaStream* stream,
+    TrtxHostFunc callback,
+    void* user_data,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!dst || !src) {
+    if (!callback) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    cudaError_t err = cudaMemcpy(dst, src, size, cudaMemcpyHostToDevice);
+    cudaError_t err = cudaLaunchHostFunc(
+        reinterpret_cast<cudaStream_t>(stream), callback, user_data);
     if (err != cudaSuccess) {
         copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
         return TRTX_ERROR_CUDA_ERROR;
@@ -542,32 +3232,109 @@ int32_t trtx_cuda_memcpy_host_to_device(
     return TRTX_SUCCESS;
 }
 
-int32_t trtx_cuda_memcpy_device_to_host(
-    void* dst,
-    const void* src,
-    size_t size,
+int32_t trtx_cuda_get_stream_priority_range(
+    int32_t* out_least_priority,
+    int32_t* out_greatest_priority,
     char* error_msg,
     size_t error_msg_len
 ) {
-    if (!dst || !src) {
+    if (!out_least_priority || !out_greatest_priority) {
         copy_error("Invalid arguments", error_msg, error_msg_len);
         return TRTX_ERROR_INVALID_ARGUMENT;
     }
 
-    cudaError_t err = cudaMemcpy(dst, src, size, cudaMemcpyDeviceToHost);
+    int least = 0;
+    int greatest = 0;
+    cudaError_t err = cudaDeviceGetStreamPriorityRange(&least, &greatest);
     if (err != cudaSuccess) {
         copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
         return TRTX_ERROR_CUDA_ERROR;
     }
 
+    *out_least_priority = least;
+    *out_greatest_priority = greatest;
     return TRTX_SUCCESS;
 }
 
-int32_t trtx_cuda_synchronize(
+int32_t trtx_cuda_get_device_count(
+    int32_t* out_count,
     char* error_msg,
     size_t error_msg_len
 ) {
-    cudaError_t err = cudaDeviceSynchronize();
+    if (!out_count) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    int count = 0;
+    cudaError_t err = cudaGetDeviceCount(&count);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    *out_count = count;
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_get_device(
+    int32_t* out_device,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!out_device) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    int device = 0;
+    cudaError_t err = cudaGetDevice(&device);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    *out_device = device;
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_set_device(
+    int32_t device,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    cudaError_t err = cudaSetDevice(device);
+    if (err != cudaSuccess) {
+        copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
+        return TRTX_ERROR_CUDA_ERROR;
+    }
+
+    return TRTX_SUCCESS;
+}
+
+int32_t trtx_cuda_get_device_identity(
+    int32_t* out_major,
+    int32_t* out_minor,
+    uint8_t* out_uuid,
+    char* error_msg,
+    size_t error_msg_len
+) {
+    if (!out_major || !out_minor || !out_uuid) {
+        copy_error("Invalid arguments", error_msg, error_msg_len);
+        return TRTX_ERROR_INVALID_ARGUMENT;
+    }
+
+    int device = 0;
+    cudaError_t err = cudaGetDevice(&device);
+    if (err == cudaSuccess) {
+        cudaDeviceProp prop;
+        err = cudaGetDeviceProperties(&prop, device);
+        if (err == cudaSuccess) {
+            *out_major = prop.major;
+            *out_minor = prop.minor;
+            std::memcpy(out_uuid, prop.uuid.bytes, sizeof(prop.uuid.bytes));
+        }
+    }
     if (err != cudaSuccess) {
         copy_error(cudaGetErrorString(err), error_msg, error_msg_len);
         return TRTX_ERROR_CUDA_ERROR;
@@ -16,6 +16,137 @@ extern "C" {
 #define TRTX_ERROR_CUDA_ERROR 4
 #define TRTX_ERROR_UNKNOWN 99
 
+// CUDA stream creation flags (matching cudaStreamDefault / cudaStreamNonBlocking)
+#define TRTX_CUDA_STREAM_DEFAULT 0
+#define TRTX_CUDA_STREAM_NON_BLOCKING 1
+
+// CUDA event creation flags (matching cudaEventDefault / cudaEventBlockingSync / cudaEventDisableTiming)
+#define TRTX_CUDA_EVENT_DEFAULT 0
+#define TRTX_CUDA_EVENT_BLOCKING_SYNC 1
+#define TRTX_CUDA_EVENT_DISABLE_TIMING 2
+
+// Pinned host allocation flags (matching cudaHostAlloc* flags)
+#define TRTX_CUDA_HOST_ALLOC_DEFAULT 0
+#define TRTX_CUDA_HOST_ALLOC_PORTABLE 1
+#define TRTX_CUDA_HOST_ALLOC_MAPPED 2
+#define TRTX_CUDA_HOST_ALLOC_WRITE_COMBINED 4
+
+// Host registration flags (matching cudaHostRegister* flags)
+#define TRTX_CUDA_HOST_REGISTER_DEFAULT 0
+#define TRTX_CUDA_HOST_REGISTER_PORTABLE 1
+#define TRTX_CUDA_HOST_REGISTER_MAPPED 2
+#define TRTX_CUDA_HOST_REGISTER_READ_ONLY 8
+
+// Tensor data types (matching nvinfer1::DataType)
+#define TRTX_DATA_TYPE_FLOAT 0
+#define TRTX_DATA_TYPE_HALF 1
+#define TRTX_DATA_TYPE_INT8 2
+#define TRTX_DATA_TYPE_INT32 3
+#define TRTX_DATA_TYPE_BOOL 4
+#define TRTX_DATA_TYPE_UINT8 5
+#define TRTX_DATA_TYPE_FP8 6
+#define TRTX_DATA_TYPE_BF16 7
+#define TRTX_DATA_TYPE_INT64 8
+#define TRTX_DATA_TYPE_INT4 9
+#define TRTX_DATA_TYPE_FP4 10
+#define TRTX_DATA_TYPE_E8M0 11
+
+// Tensor IO modes (matching nvinfer1::TensorIOMode)
+#define TRTX_TENSOR_IO_MODE_NONE 0
+#define TRTX_TENSOR_IO_MODE_INPUT 1
+#define TRTX_TENSOR_IO_MODE_OUTPUT 2
+
+// Tensor memory layouts (matching nvinfer1::TensorFormat)
+#define TRTX_TENSOR_FORMAT_LINEAR 0
+#define TRTX_TENSOR_FORMAT_CHW2 1
+#define TRTX_TENSOR_FORMAT_HWC8 2
+#define TRTX_TENSOR_FORMAT_CHW4 3
+#define TRTX_TENSOR_FORMAT_CHW16 4
+#define TRTX_TENSOR_FORMAT_CHW32 5
+#define TRTX_TENSOR_FORMAT_DHWC8 6
+#define TRTX_TENSOR_FORMAT_CDHW32 7
+#define TRTX_TENSOR_FORMAT_HWC 8
+#define TRTX_TENSOR_FORMAT_DLA_LINEAR 9
+#define TRTX_TENSOR_FORMAT_DLA_HWC4 10
+#define TRTX_TENSOR_FORMAT_HWC16 11
+#define TRTX_TENSOR_FORMAT_DHWC 12
+
+// Optimization profile shape selectors (matching nvinfer1::OptProfileSelector)
+#define TRTX_PROFILE_MIN 0
+#define TRTX_PROFILE_OPT 1
+#define TRTX_PROFILE_MAX 2
+
+// Activation memory allocation strategies (matching nvinfer1::ExecutionContextAllocationStrategy)
+#define TRTX_ALLOCATION_STRATEGY_STATIC 0
+#define TRTX_ALLOCATION_STRATEGY_ON_PROFILE_CHANGE 1
+#define TRTX_ALLOCATION_STRATEGY_USER_MANAGED 2
+
+// Builder flags (matching nvinfer1::BuilderFlag)
+#define TRTX_BUILDER_FLAG_FP16 0
+#define TRTX_BUILDER_FLAG_INT8 1
+#define TRTX_BUILDER_FLAG_DEBUG 2
+#define TRTX_BUILDER_FLAG_GPU_FALLBACK 3
+#define TRTX_BUILDER_FLAG_REFIT 4
+#define TRTX_BUILDER_FLAG_DISABLE_TIMING_CACHE 5
+#define TRTX_BUILDER_FLAG_TF32 6
+#define TRTX_BUILDER_FLAG_SPARSE_WEIGHTS 7
+#define TRTX_BUILDER_FLAG_OBEY_PRECISION_CONSTRAINTS 9
+#define TRTX_BUILDER_FLAG_PREFER_PRECISION_CONSTRAINTS 10
+#define TRTX_BUILDER_FLAG_DIRECT_IO 11
+#define TRTX_BUILDER_FLAG_REJECT_EMPTY_ALGORITHMS 12
+#define TRTX_BUILDER_FLAG_VERSION_COMPATIBLE 13
+#define TRTX_BUILDER_FLAG_EXCLUDE_LEAN_RUNTIME 14
+#define TRTX_BUILDER_FLAG_FP8 15
+#define TRTX_BUILDER_FLAG_ERROR_ON_TIMING_CACHE_MISS 16
+#define TRTX_BUILDER_FLAG_BF16 17
+#define TRTX_BUILDER_FLAG_DISABLE_COMPILATION_CACHE 18
+#define TRTX_BUILDER_FLAG_STRIP_PLAN 19
+#define TRTX_BUILDER_FLAG_REFIT_IDENTICAL 20
+#define TRTX_BUILDER_FLAG_WEIGHT_STREAMING 21
+#define TRTX_BUILDER_FLAG_INT4 22
+#define TRTX_BUILDER_FLAG_REFIT_INDIVIDUAL 23
+#define TRTX_BUILDER_FLAG_STRICT_NANS 24
+#define TRTX_BUILDER_FLAG_MONITOR_MEMORY 25
+#define TRTX_BUILDER_FLAG_FP4 26
+#define TRTX_BUILDER_FLAG_EDITABLE_TIMING_CACHE 27
+
+// Tactic source bit positions (matching nvinfer1::TacticSource)
+#define TRTX_TACTIC_SOURCE_CUBLAS 0
+#define TRTX_TACTIC_SOURCE_CUBLAS_LT 1
+#define TRTX_TACTIC_SOURCE_CUDNN 2
+#define TRTX_TACTIC_SOURCE_EDGE_MASK_CONVOLUTIONS 3
+#define TRTX_TACTIC_SOURCE_JIT_CONVOLUTIONS 4
+
+// Hardware compatibility levels (matching nvinfer1::HardwareCompatibilityLevel)
+#define TRTX_HARDWARE_COMPATIBILITY_NONE 0
+#define TRTX_HARDWARE_COMPATIBILITY_AMPERE_PLUS 1
+#define TRTX_HARDWARE_COMPATIBILITY_SAME_COMPUTE_CAPABILITY 2
+
+// Compute capabilities an RTX engine can target (matching nvinfer1::ComputeCapability)
+#define TRTX_COMPUTE_CAPABILITY_NONE 0
+#define TRTX_COMPUTE_CAPABILITY_CURRENT 1
+#define TRTX_COMPUTE_CAPABILITY_SM75 75
+#define TRTX_COMPUTE_CAPABILITY_SM80 80
+#define TRTX_COMPUTE_CAPABILITY_SM86 86
+#define TRTX_COMPUTE_CAPABILITY_SM89 89
+#define TRTX_COMPUTE_CAPABILITY_SM120 120
+
+// Profiling verbosity recorded in built engines (matching nvinfer1::ProfilingVerbosity)
+#define TRTX_PROFILING_VERBOSITY_LAYER_NAMES_ONLY 0
+#define TRTX_PROFILING_VERBOSITY_NONE 1
+#define TRTX_PROFILING_VERBOSITY_DETAILED 2
+
+// Engine inspector output formats (matching nvinfer1::LayerInformationFormat)
+#define TRTX_LAYER_INFORMATION_FORMAT_ONELINE 0
+#define TRTX_LAYER_INFORMATION_FORMAT_JSON 1
+
+// Where refit weights live (matching nvinfer1::TensorLocation)
+#define TRTX_TENSOR_LOCATION_DEVICE 0
+#define TRTX_TENSOR_LOCATION_HOST 1
+
+// Maximum tensor rank (matching nvinfer1::Dims::MAX_DIMS)
+#define TRTX_MAX_DIMS 8
+
 // Logger severity levels (matching nvinfer1::ILogger::Severity)
 typedef enum {
     TRTX_SEVERITY_INTERNAL_ERROR = 0,
@@ -33,10 +164,47 @@ typedef struct TrtxNetworkDefinition TrtxNetworkDefinition;
 typedef struct TrtxRuntime TrtxRuntime;
 typedef struct TrtxCudaEngine TrtxCudaEngine;
 typedef struct TrtxExecutionContext TrtxExecutionContext;
+typedef struct TrtxHostMemory TrtxHostMemory;
+typedef struct TrtxCudaStream TrtxCudaStream;
+typedef struct TrtxOptimizationProfile TrtxOptimizationProfile;
+typedef struct TrtxCudaEvent TrtxCudaEvent;
+typedef struct TrtxTimingCache TrtxTimingCache;
+typedef struct TrtxRuntimeCache TrtxRuntimeCache;
+typedef struct TrtxProfiler TrtxProfiler;
+typedef struct TrtxEngineInspector TrtxEngineInspector;
+
+// Tensor dimensions; -1 marks a dimension only known at runtime
+typedef struct {
+    int32_t nb_dims;
+    int64_t d[TRTX_MAX_DIMS];
+} TrtxDims;
+
+// One tensor of trtx_execution_context_bind_and_enqueue. Every part is optional:
+// a NULL address keeps the current binding, shape.nb_dims < 0 keeps the current
+// shape, and a NULL host pointer skips that copy.
+typedef struct {
+    int32_t index;           // IO tensor index in engine order
+    void* address;           // device memory to bind
+    TrtxDims shape;          // input shape to set
+    const void* host_input;  // copied to the tensor's device memory before enqueue
+    size_t host_input_size;
+    void* host_output;       // filled from the tensor's device memory after enqueue
+    size_t host_output_size;
+} TrtxTensorBinding;
 
 // Logger callback type
 typedef void (*TrtxLoggerCallback)(void* user_data, TrtxLoggerSeverity severity, const char* msg);
 
+// Profiler callback type: one call per layer and profiled enqueue
+typedef void (*TrtxProfilerCallback)(void* user_data, const char* layer_name, float ms);
+
+// Error reporting: every function taking `error_msg, error_msg_len` also records the
+// message of a failure in a thread-local slot, so callers may pass NULL, 0 and fetch it
+// afterwards. The returned pointer is never NULL and stays valid until the next failure
+// or trtx_clear_last_error on the same thread.
+const char* trtx_get_last_error(void);
+void trtx_clear_last_error(void);
+
 // Logger functions
 int32_t trtx_logger_create(
     TrtxLoggerCallback callback,
@@ -48,6 +216,15 @@ int32_t trtx_logger_create(
 
 void trtx_logger_destroy(TrtxLogger* logger);
 
+// Drop messages less severe than min_severity (a TRTX_SEVERITY_* value)
+// before they reach the callback; TRTX_SEVERITY_VERBOSE passes everything
+int32_t trtx_logger_set_min_severity(
+    TrtxLogger* logger,
+    int32_t min_severity,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 // Builder functions
 int32_t trtx_builder_create(
     TrtxLogger* logger,
@@ -77,12 +254,35 @@ int32_t trtx_builder_build_serialized_network(
     TrtxBuilder* builder,
     TrtxNetworkDefinition* network,
     TrtxBuilderConfig* config,
-    void** out_data,
-    size_t* out_size,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Optimization profiles are owned by the builder and must not be destroyed
+int32_t trtx_builder_create_optimization_profile(
+    TrtxBuilder* builder,
+    TrtxOptimizationProfile** out_profile,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_optimization_profile_set_dimensions(
+    TrtxOptimizationProfile* profile,
+    const char* input_name,
+    int32_t selector,
+    const TrtxDims* dims,
     char* error_msg,
     size_t error_msg_len
 );
 
+// HostMemory functions (TensorRT-owned serialized blobs, no copies)
+const void* trtx_host_memory_data(TrtxHostMemory* memory);
+
+size_t trtx_host_memory_size(TrtxHostMemory* memory);
+
+void trtx_host_memory_destroy(TrtxHostMemory* memory);
+
 // BuilderConfig functions
 void trtx_builder_config_destroy(TrtxBuilderConfig* config);
 
@@ -94,6 +294,112 @@ int32_t trtx_builder_config_set_memory_pool_limit(
     size_t error_msg_len
 );
 
+int32_t trtx_builder_config_add_optimization_profile(
+    TrtxBuilderConfig* config,
+    TrtxOptimizationProfile* profile,
+    int32_t* out_index,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_builder_config_set_flag(
+    TrtxBuilderConfig* config,
+    int32_t flag,
+    int32_t enabled,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_builder_config_get_flag(TrtxBuilderConfig* config, int32_t flag);
+
+// Trade build time for engine performance; 0 (fastest build) to 5 (most tactics)
+int32_t trtx_builder_config_set_builder_optimization_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// sources is a bitmask of 1 << TRTX_TACTIC_SOURCE_*
+int32_t trtx_builder_config_set_tactic_sources(
+    TrtxBuilderConfig* config,
+    uint32_t sources,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_builder_config_set_max_aux_streams(
+    TrtxBuilderConfig* config,
+    int32_t nb_streams,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_builder_config_set_profiling_verbosity(
+    TrtxBuilderConfig* config,
+    int32_t verbosity,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_builder_config_set_hardware_compatibility_level(
+    TrtxBuilderConfig* config,
+    int32_t level,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Replace the compute capabilities the engine is built for (TRTX_COMPUTE_CAPABILITY_*)
+int32_t trtx_builder_config_set_compute_capabilities(
+    TrtxBuilderConfig* config,
+    const int32_t* capabilities,
+    int32_t count,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Create a timing cache from a serialized blob (empty blob for a fresh cache);
+// the cache is independent of the config and destroyed with trtx_timing_cache_destroy
+int32_t trtx_builder_config_create_timing_cache(
+    TrtxBuilderConfig* config,
+    const void* blob,
+    size_t blob_size,
+    TrtxTimingCache** out_cache,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Attach a timing cache; it must outlive every build using the config
+int32_t trtx_builder_config_set_timing_cache(
+    TrtxBuilderConfig* config,
+    TrtxTimingCache* cache,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Get the attached timing cache (NULL if none); still owned by its creator
+const TrtxTimingCache* trtx_builder_config_get_timing_cache(TrtxBuilderConfig* config);
+
+// TimingCache functions
+void trtx_timing_cache_destroy(TrtxTimingCache* cache);
+
+int32_t trtx_timing_cache_serialize(
+    const TrtxTimingCache* cache,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Merge the entries of other into cache
+int32_t trtx_timing_cache_combine(
+    TrtxTimingCache* cache,
+    const TrtxTimingCache* other,
+    int32_t ignore_mismatch,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 // NetworkDefinition functions
 void trtx_network_destroy(TrtxNetworkDefinition* network);
 
@@ -116,6 +422,16 @@ int32_t trtx_runtime_deserialize_cuda_engine(
     size_t error_msg_len
 );
 
+// Deserialize a plan file by memory-mapping it; streams it through
+// IStreamReaderV2 where available so no heap copy of the plan is made
+int32_t trtx_runtime_deserialize_cuda_engine_from_file(
+    TrtxRuntime* runtime,
+    const char* path,
+    TrtxCudaEngine** out_engine,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 // CudaEngine functions
 void trtx_cuda_engine_destroy(TrtxCudaEngine* engine);
 
@@ -126,6 +442,81 @@ int32_t trtx_cuda_engine_create_execution_context(
     size_t error_msg_len
 );
 
+// Create a context with one of the TRTX_ALLOCATION_STRATEGY_* values; with
+// USER_MANAGED, activation memory must be set before enqueueing
+int32_t trtx_cuda_engine_create_execution_context_with_strategy(
+    TrtxCudaEngine* engine,
+    int32_t strategy,
+    TrtxExecutionContext** out_context,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Create a context through an IRuntimeConfig, sharing the JIT kernels of cache
+// (may be NULL); the cache must outlive the context
+int32_t trtx_cuda_engine_create_execution_context_with_cache(
+    TrtxCudaEngine* engine,
+    int32_t strategy,
+    TrtxRuntimeCache* cache,
+    TrtxExecutionContext** out_context,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// RuntimeCache functions (TensorRT-RTX JIT kernel cache)
+// Create a cache for engine's contexts, restored from a serialized blob (empty
+// blob for a fresh cache); fails if the blob is rejected. Destroy before the engine
+int32_t trtx_runtime_cache_create(
+    TrtxCudaEngine* engine,
+    const void* blob,
+    size_t blob_size,
+    TrtxRuntimeCache** out_cache,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_runtime_cache_destroy(TrtxRuntimeCache* cache);
+
+int32_t trtx_runtime_cache_serialize(
+    const TrtxRuntimeCache* cache,
+    TrtxHostMemory** out_memory,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Activation memory a context needs, over all profiles (getDeviceMemorySizeV2)
+int32_t trtx_cuda_engine_get_device_memory_size(
+    TrtxCudaEngine* engine,
+    int64_t* out_size
+);
+
+int32_t trtx_cuda_engine_get_device_memory_size_for_profile(
+    TrtxCudaEngine* engine,
+    int32_t profile_index,
+    int64_t* out_size,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Weight streaming state of an engine built with TRTX_BUILDER_FLAG_WEIGHT_STREAMING;
+// any of the out pointers may be null
+int32_t trtx_cuda_engine_get_weight_streaming(
+    TrtxCudaEngine* engine,
+    int64_t* out_streamable_weights_size,
+    int64_t* out_budget,
+    int64_t* out_automatic_budget,
+    int64_t* out_scratch_memory_size
+);
+
+// Bytes of streamable weights to keep on the GPU (setWeightStreamingBudgetV2), from 0
+// to the streamable size; only allowed while the engine has no execution contexts
+int32_t trtx_cuda_engine_set_weight_streaming_budget(
+    TrtxCudaEngine* engine,
+    int64_t budget,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 int32_t trtx_cuda_engine_get_tensor_name(
     TrtxCudaEngine* engine,
     int32_t index,
@@ -139,9 +530,173 @@ int32_t trtx_cuda_engine_get_nb_io_tensors(
     int32_t* out_count
 );
 
+// Tensor introspection by IO tensor name
+int32_t trtx_cuda_engine_get_tensor_shape(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_engine_get_tensor_data_type(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_data_type,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_engine_get_tensor_io_mode(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_io_mode,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Layout of a tensor; out_vectorized_dim is -1 for scalar (non-vectorized) formats
+int32_t trtx_cuda_engine_get_tensor_format(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_format,
+    int32_t* out_vectorized_dim,
+    int32_t* out_components_per_element,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_engine_get_tensor_bytes_per_component(
+    TrtxCudaEngine* engine,
+    const char* tensor_name,
+    int32_t* out_bytes,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_engine_get_nb_optimization_profiles(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+);
+
+int32_t trtx_cuda_engine_get_profile_shape(
+    TrtxCudaEngine* engine,
+    const char* input_name,
+    int32_t profile_index,
+    int32_t selector,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_engine_get_nb_layers(
+    TrtxCudaEngine* engine,
+    int32_t* out_count
+);
+
+// The inspector must be destroyed before the engine
+int32_t trtx_cuda_engine_create_engine_inspector(
+    TrtxCudaEngine* engine,
+    TrtxEngineInspector** out_inspector,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// EngineInspector functions
+void trtx_engine_inspector_destroy(TrtxEngineInspector* inspector);
+
+// Report the shapes and addresses bound on a context (NULL to detach); the
+// context must outlive the inspector or be detached first
+int32_t trtx_engine_inspector_set_execution_context(
+    TrtxEngineInspector* inspector,
+    TrtxExecutionContext* context,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Returned strings are owned by the inspector and valid until its next call
+int32_t trtx_engine_inspector_get_layer_information(
+    TrtxEngineInspector* inspector,
+    int32_t layer_index,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_engine_inspector_get_engine_information(
+    TrtxEngineInspector* inspector,
+    int32_t format,
+    const char** out_info,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Profiler functions
+int32_t trtx_profiler_create(
+    TrtxProfilerCallback callback,
+    void* user_data,
+    TrtxProfiler** out_profiler,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_profiler_destroy(TrtxProfiler* profiler);
+
 // ExecutionContext functions
 void trtx_execution_context_destroy(TrtxExecutionContext* context);
 
+// Report per-layer times of every enqueue to a profiler (NULL to detach);
+// profiled enqueues run eagerly instead of replaying CUDA graphs
+int32_t trtx_execution_context_set_profiler(
+    TrtxExecutionContext* context,
+    TrtxProfiler* profiler,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_execution_context_set_input_shape(
+    TrtxExecutionContext* context,
+    const char* input_name,
+    const TrtxDims* dims,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Shape of a tensor as resolved from the input shapes set on this context
+int32_t trtx_execution_context_get_tensor_shape(
+    TrtxExecutionContext* context,
+    const char* tensor_name,
+    TrtxDims* out_dims,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_execution_context_set_optimization_profile_async(
+    TrtxExecutionContext* context,
+    int32_t profile_index,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Activation memory for a context created with USER_MANAGED (setDeviceMemoryV2)
+int32_t trtx_execution_context_set_device_memory(
+    TrtxExecutionContext* context,
+    void* memory,
+    int64_t size,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Activation memory needed for the input shapes currently set
+int32_t trtx_execution_context_update_device_memory_size_for_shapes(
+    TrtxExecutionContext* context,
+    int64_t* out_size,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 int32_t trtx_execution_context_set_tensor_address(
     TrtxExecutionContext* context,
     const char* tensor_name,
@@ -157,9 +712,43 @@ int32_t trtx_execution_context_enqueue_v3(
     size_t error_msg_len
 );
 
+// Bind, upload, enqueue and read back a whole request in one call: sets every
+// shape, then every address, then queues the H2D copies, the inference and the
+// D2H copies on cuda_stream, and waits for the stream if synchronize is non-zero
+int32_t trtx_execution_context_bind_and_enqueue(
+    TrtxExecutionContext* context,
+    const TrtxTensorBinding* bindings,
+    size_t nb_bindings,
+    void* cuda_stream,
+    int32_t synchronize,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Capture enqueue_v3 into CUDA graphs and replay them, keeping up to
+// max_graphs graphs (one per profile, input shapes and tensor addresses)
+int32_t trtx_execution_context_set_cuda_graphs(
+    TrtxExecutionContext* context,
+    int32_t enabled,
+    int32_t max_graphs,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Any of the out pointers may be null
+void trtx_execution_context_get_cuda_graph_stats(
+    TrtxExecutionContext* context,
+    int32_t* out_cached_graphs,
+    int64_t* out_captures,
+    int64_t* out_replays
+);
+
 // Utility functions
 void trtx_free_buffer(void* buffer);
 
+// TensorRT-RTX library version (as returned by getInferLibVersion)
+int32_t trtx_get_tensorrt_version();
+
 // ONNX Parser functions
 typedef struct TrtxOnnxParser TrtxOnnxParser;
 
@@ -173,10 +762,124 @@ int32_t trtx_onnx_parser_create(
 
 void trtx_onnx_parser_destroy(TrtxOnnxParser* parser);
 
+// model_path (may be NULL) locates external data files, relative to its directory
 int32_t trtx_onnx_parser_parse(
     TrtxOnnxParser* parser,
     const void* model_data,
     size_t model_size,
+    const char* model_path,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Let the parser read the model file and its external data itself (IParser::parseFromFile)
+int32_t trtx_onnx_parser_parse_from_file(
+    TrtxOnnxParser* parser,
+    const char* path,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Memory-map the model and its external data files, fault the initializers in on
+// num_threads threads (0 = one per core, 1 = none), and parse without copying them
+// (IParser::loadModelProto / loadInitializer / parseModelProto). The maps live
+// as long as the parser, which must therefore outlive the network build.
+int32_t trtx_onnx_parser_parse_mapped(
+    TrtxOnnxParser* parser,
+    const char* path,
+    int32_t num_threads,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Check whether TensorRT supports the whole model and split it into subgraphs (IParser::supportsModelV2)
+int32_t trtx_onnx_parser_supports_model(
+    TrtxOnnxParser* parser,
+    const void* model_data,
+    size_t model_size,
+    const char* model_path,
+    int32_t* out_supported,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Subgraphs found by the last trtx_onnx_parser_supports_model call
+int32_t trtx_onnx_parser_get_nb_subgraphs(
+    TrtxOnnxParser* parser,
+    int64_t* out_count
+);
+
+// Node indices of one subgraph; out_nodes is owned by the parser and valid until the next call
+int32_t trtx_onnx_parser_get_subgraph(
+    TrtxOnnxParser* parser,
+    int64_t index,
+    int32_t* out_supported,
+    const int64_t** out_nodes,
+    int64_t* out_nb_nodes
+);
+
+// Refitting (engines built with TRTX_BUILDER_FLAG_REFIT or TRTX_BUILDER_FLAG_REFIT_IDENTICAL)
+typedef struct TrtxRefitter TrtxRefitter;
+typedef struct TrtxParserRefitter TrtxParserRefitter;
+
+int32_t trtx_refitter_create(
+    TrtxCudaEngine* engine,
+    TrtxLogger* logger,
+    TrtxRefitter** out_refitter,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_refitter_destroy(TrtxRefitter* refitter);
+
+// Stage new weights for `name`; `values` must stay valid until the refit has
+// completed. location is TRTX_TENSOR_LOCATION_DEVICE or TRTX_TENSOR_LOCATION_HOST.
+int32_t trtx_refitter_set_named_weights(
+    TrtxRefitter* refitter,
+    const char* name,
+    int32_t data_type,
+    const void* values,
+    int64_t count,
+    int32_t location,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Weight names of the engine (all) or still needed before a refit (missing).
+// Writes up to `size` names and returns the total count in out_count; the
+// strings are owned by the refitter.
+int32_t trtx_refitter_get_weight_names(
+    TrtxRefitter* refitter,
+    int32_t missing_only,
+    int32_t size,
+    const char** out_names,
+    int32_t* out_count
+);
+
+// Apply the staged weights, ordered on cuda_stream
+int32_t trtx_refitter_refit_cuda_engine_async(
+    TrtxRefitter* refitter,
+    void* cuda_stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Stage every initializer of an ONNX model as refit weights (IParserRefitter);
+// the parser refitter must outlive the refit
+int32_t trtx_parser_refitter_create(
+    TrtxRefitter* refitter,
+    TrtxLogger* logger,
+    TrtxParserRefitter** out_parser_refitter,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_parser_refitter_destroy(TrtxParserRefitter* parser_refitter);
+
+int32_t trtx_parser_refitter_refit_from_bytes(
+    TrtxParserRefitter* parser_refitter,
+    const void* model_data,
+    size_t model_size,
     char* error_msg,
     size_t error_msg_len
 );
@@ -195,6 +898,66 @@ int32_t trtx_cuda_free(
     size_t error_msg_len
 );
 
+// Stream-ordered allocation (cudaMallocAsync / cudaFreeAsync on the device's default pool)
+int32_t trtx_cuda_malloc_async(
+    void** ptr,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_free_async(
+    void* ptr,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Keep up to `threshold` bytes reserved in the current device's default pool across syncs
+int32_t trtx_cuda_mem_pool_set_release_threshold(
+    uint64_t threshold,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Pinned (page-locked) host memory functions
+int32_t trtx_cuda_host_alloc(
+    void** ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_free_host(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_host_register(
+    void* ptr,
+    size_t size,
+    uint32_t flags,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_host_unregister(
+    void* ptr,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Device address of mapped pinned memory (allocated or registered with the MAPPED flag)
+int32_t trtx_cuda_host_get_device_pointer(
+    void* host_ptr,
+    void** out_device_ptr,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 int32_t trtx_cuda_memcpy_host_to_device(
     void* dst,
     const void* src,
@@ -216,6 +979,137 @@ int32_t trtx_cuda_synchronize(
     size_t error_msg_len
 );
 
+int32_t trtx_cuda_memcpy_host_to_device_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_memcpy_device_to_host_async(
+    void* dst,
+    const void* src,
+    size_t size,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// CUDA stream functions (a NULL stream is the legacy default stream)
+int32_t trtx_cuda_stream_create(
+    uint32_t flags,
+    int32_t priority,
+    TrtxCudaStream** out_stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_cuda_stream_destroy(TrtxCudaStream* stream);
+
+int32_t trtx_cuda_stream_synchronize(
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_get_stream_priority_range(
+    int32_t* out_least_priority,
+    int32_t* out_greatest_priority,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// CUDA event functions
+int32_t trtx_cuda_event_create(
+    uint32_t flags,
+    TrtxCudaEvent** out_event,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+void trtx_cuda_event_destroy(TrtxCudaEvent* event);
+
+int32_t trtx_cuda_event_record(
+    TrtxCudaEvent* event,
+    TrtxCudaStream* stream,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Sets *out_complete to 1 once all work before the record has finished, 0 otherwise
+int32_t trtx_cuda_event_query(
+    TrtxCudaEvent* event,
+    int32_t* out_complete,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_event_synchronize(
+    TrtxCudaEvent* event,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Milliseconds between two completed events (both created with timing enabled)
+int32_t trtx_cuda_event_elapsed_time(
+    TrtxCudaEvent* start,
+    TrtxCudaEvent* end,
+    float* out_ms,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Make future work on stream wait for event, without blocking the host
+int32_t trtx_cuda_stream_wait_event(
+    TrtxCudaStream* stream,
+    TrtxCudaEvent* event,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Host callback run on a CUDA driver thread; it must not call CUDA APIs
+typedef void (*TrtxHostFunc)(void* user_data);
+
+// Run callback once all work queued on stream so far has finished (cudaLaunchHostFunc)
+int32_t trtx_cuda_launch_host_func(
+    TrtxCudaStream* stream,
+    TrtxHostFunc callback,
+    void* user_data,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Number of visible CUDA devices
+int32_t trtx_cuda_get_device_count(
+    int32_t* out_count,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Device current on the calling thread (cudaGetDevice / cudaSetDevice)
+int32_t trtx_cuda_get_device(
+    int32_t* out_device,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+int32_t trtx_cuda_set_device(
+    int32_t device,
+    char* error_msg,
+    size_t error_msg_len
+);
+
+// Identity of the current CUDA device (compute capability and 16-byte UUID)
+int32_t trtx_cuda_get_device_identity(
+    int32_t* out_major,
+    int32_t* out_minor,
+    uint8_t* out_uuid,
+    char* error_msg,
+    size_t error_msg_len
+);
+
 // Helper function to get default CUDA stream (returns NULL for default stream)
 void* trtx_cuda_get_default_stream();
 
@@ -0,0 +1,107 @@
+//! trtexec-style inference benchmark
+//!
+//! Loads a serialized engine or builds one from ONNX, then reports latency
+//! percentiles, throughput and the H2D/compute/D2H breakdown as JSON:
+//!
+//! ```text
+//! cargo run --release --example benchmark -- \
+//!     --onnx trtx/tests/data/super-resolution-10.onnx \
+//!     --shape input:1x1x224x224 --contexts 2 --iterations 500 --json report.json
+//! ```
+//!
+//! Run with `--features mock` to measure the overhead of the FFI layer alone.
+
+use std::error::Error;
+use trtx::{benchmark, BenchmarkConfig, InferenceSession, Logger, SessionConfig, ShapeRange};
+
+const USAGE: &str = "usage: benchmark (--onnx PATH | --engine PATH) [--shape NAME:DxDxD]... \
+[--contexts N] [--iterations N] [--warmup N] [--cuda-graphs] [--json PATH]";
+
+enum Model {
+    Onnx(String),
+    Engine(String),
+}
+
+fn parse_shape(spec: &str) -> Result<(String, Vec<i64>), Box<dyn Error>> {
+    let (name, dims) = spec
+        .rsplit_once(':')
+        .ok_or_else(|| format!("shape '{spec}' is not NAME:DxDxD"))?;
+    let dims = dims
+        .split('x')
+        .map(str::parse)
+        .collect::<Result<Vec<i64>, _>>()?;
+    Ok((name.to_string(), dims))
+}
+
+fn main() -> Result<(), Box<dyn Error>> {
+    let mut model = None;
+    let mut config = BenchmarkConfig::default();
+    let mut json_path = None;
+
+    let mut args = std::env::args().skip(1);
+    while let Some(arg) = args.next() {
+        let mut value = || {
+            args.next()
+                .ok_or_else(|| format!("{arg} needs a value\n{USAGE}"))
+        };
+        match arg.as_str() {
+            "--onnx" => model = Some(Model::Onnx(value()?)),
+            "--engine" => model = Some(Model::Engine(value()?)),
+            "--shape" => config.input_shapes.push(parse_shape(&value()?)?),
+            "--contexts" => config.contexts = value()?.parse()?,
+            "--iterations" => config.iterations = value()?.parse()?,
+            "--warmup" => config.warmup_iterations = value()?.parse()?,
+            "--cuda-graphs" => config.cuda_graphs = true,
+            "--json" => json_path = Some(value()?),
+            _ => return Err(format!("unknown argument '{arg}'\n{USAGE}").into()),
+        }
+    }
+    let model = model.ok_or(USAGE)?;
+
+    let logger = Logger::stderr()?;
+    let session_config = SessionConfig {
+        // Build a profile around the requested shapes so they are the ones tuned for
+        optimization_profiles: if config.input_shapes.is_empty() {
+            Vec::new()
+        } else {
+            vec![config
+                .input_shapes
+                .iter()
+                .map(|(name, shape)| ShapeRange {
+                    input: name.clone(),
+                    min: shape.clone(),
+                    opt: shape.clone(),
+                    max: shape.clone(),
+                })
+                .collect()]
+        },
+        ..SessionConfig::default()
+    };
+    let session = match &model {
+        Model::Onnx(path) => {
+            InferenceSession::from_onnx(logger, &std::fs::read(path)?, session_config)?
+        }
+        Model::Engine(path) => InferenceSession::from_plan_file(logger, path, session_config)?,
+    };
+
+    let report = benchmark(session.engine(), &config)?;
+    eprintln!(
+        "{} iterations on {} context(s): {:.1} inferences/s, latency p50 {:.3} ms, p99 {:.3} ms",
+        report.iterations,
+        report.contexts,
+        report.throughput,
+        report.latency.p50,
+        report.latency.p99
+    );
+    eprintln!(
+        "GPU mean: H2D {:.3} ms, compute {:.3} ms, D2H {:.3} ms",
+        report.h2d.mean, report.compute.mean, report.d2h.mean
+    );
+
+    let json = report.to_json();
+    match json_path {
+        Some(path) => std::fs::write(path, json + "\n")?,
+        None => println!("{json}"),
+    }
+    Ok(())
+}
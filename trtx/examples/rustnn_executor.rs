@@ -46,7 +46,7 @@ fn main() -> Result<(), Box<dyn Error>> {
     let inputs = vec![TensorInput {
         name: "input".to_string(),
         shape: vec![1, 3, 224, 224],
-        data: create_sample_input(3 * 224 * 224),
+        data: create_sample_input(3 * 224 * 224).into(),
     }];
 
     match run_onnx_with_tensorrt(&dummy_onnx, &inputs) {
@@ -56,7 +56,7 @@ fn main() -> Result<(), Box<dyn Error>> {
                 println!("      - {}: shape {:?}", output.name, output.shape);
                 println!(
                     "        First 5 values: {:?}",
-                    &output.data[..output.data.len().min(5)]
+                    &output.data.to_f32()?[..output.data.len().min(5)]
                 );
             }
         }
@@ -0,0 +1,569 @@
+//! Dynamic batching of concurrent inference requests
+//!
+//! A [`DynamicBatcher`] sits in front of an [`InferenceSession`] whose inputs
+//! have a dynamic leading (batch) dimension. Callers submit requests of one
+//! or more rows each; worker threads merge queued requests with matching
+//! trailing dimensions along the batch dimension, up to the profile's max
+//! batch, run them as one inference and hand each caller its slice of the
+//! outputs.
+//!
+//! A batch is launched when it is full or when its oldest request has waited
+//! [`BatcherConfig::max_wait`], whichever comes first, so the added latency
+//! for a lone request is bounded.
+
+use crate::data::TensorData;
+use crate::error::{Error, Result};
+use crate::executor::{TensorInput, TensorOutput};
+use crate::session::InferenceSession;
+use crate::tensor::ProfileSelector;
+use std::collections::VecDeque;
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::{Arc, Condvar, Mutex};
+use std::task::{Context, Poll, Waker};
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant};
+
+/// Settings for [`DynamicBatcher`]
+#[derive(Debug, Clone)]
+pub struct BatcherConfig {
+    /// Upper bound on rows per batch; defaults to the engine's max batch
+    pub max_batch_size: Option<usize>,
+    /// Longest a request waits for others to join its batch
+    pub max_wait: Duration,
+    /// Requests that may be queued before `submit` starts failing
+    pub max_queue_depth: usize,
+    /// Threads forming and running batches; more than one only helps if the
+    /// session has several execution contexts
+    pub workers: usize,
+}
+
+impl Default for BatcherConfig {
+    fn default() -> Self {
+        BatcherConfig {
+            max_batch_size: None,
+            max_wait: Duration::from_millis(2),
+            max_queue_depth: 1024,
+            workers: 1,
+        }
+    }
+}
+
+/// Snapshot of a batcher's counters
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct BatcherStats {
+    /// Requests waiting to be batched
+    pub queue_depth: usize,
+    /// Requests completed, successfully or not
+    pub requests: u64,
+    /// Batches run
+    pub batches: u64,
+    /// Number of batches run with each total row count (index = rows)
+    pub batch_size_histogram: Vec<u64>,
+    /// Number of batches run with each request count (index = requests)
+    pub requests_per_batch_histogram: Vec<u64>,
+}
+
+/// Result slot shared between a worker and the caller's [`PendingOutputs`]
+struct Completion {
+    state: Mutex<CompletionState>,
+    done: Condvar,
+}
+
+struct CompletionState {
+    result: Option<Result<Vec<TensorOutput>>>,
+    waker: Option<Waker>,
+}
+
+impl Completion {
+    fn new() -> Arc<Self> {
+        Arc::new(Completion {
+            state: Mutex::new(CompletionState {
+                result: None,
+                waker: None,
+            }),
+            done: Condvar::new(),
+        })
+    }
+
+    fn complete(&self, result: Result<Vec<TensorOutput>>) {
+        let waker = {
+            let mut state = self.state.lock().unwrap();
+            state.result = Some(result);
+            state.waker.take()
+        };
+        self.done.notify_all();
+        if let Some(waker) = waker {
+            waker.wake();
+        }
+    }
+}
+
+/// Outputs of a submitted request, available once its batch has run
+///
+/// Either block on [`wait`](Self::wait) or `.await` it.
+pub struct PendingOutputs {
+    completion: Arc<Completion>,
+}
+
+impl PendingOutputs {
+    /// Block until the request has run
+    pub fn wait(self) -> Result<Vec<TensorOutput>> {
+        let mut state = self.completion.state.lock().unwrap();
+        loop {
+            if let Some(result) = state.result.take() {
+                return result;
+            }
+            state = self.completion.done.wait(state).unwrap();
+        }
+    }
+
+    /// Take the outputs if the request has already run
+    pub fn try_take(&mut self) -> Option<Result<Vec<TensorOutput>>> {
+        self.completion.state.lock().unwrap().result.take()
+    }
+}
+
+impl Future for PendingOutputs {
+    type Output = Result<Vec<TensorOutput>>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        let mut state = self.completion.state.lock().unwrap();
+        match state.result.take() {
+            Some(result) => Poll::Ready(result),
+            None => {
+                state.waker = Some(cx.waker().clone());
+                Poll::Pending
+            }
+        }
+    }
+}
+
+/// A queued request, with inputs in engine input order
+struct Request {
+    inputs: Vec<TensorInput>,
+    rows: usize,
+    enqueued: Instant,
+    completion: Arc<Completion>,
+}
+
+impl Request {
+    /// Whether `other` can share a batch with this request
+    fn compatible(&self, other: &Request) -> bool {
+        self.inputs
+            .iter()
+            .zip(&other.inputs)
+            .all(|(a, b)| a.shape[1..] == b.shape[1..] && a.data.data_type() == b.data.data_type())
+    }
+}
+
+struct Queue {
+    requests: VecDeque<Request>,
+    shutdown: bool,
+}
+
+struct Shared {
+    session: Arc<InferenceSession>,
+    input_names: Vec<String>,
+    max_batch: usize,
+    max_wait: Duration,
+    max_queue_depth: usize,
+    queue: Mutex<Queue>,
+    request_ready: Condvar,
+    stats: Mutex<BatcherStats>,
+}
+
+/// Merges concurrent requests into batched runs of an [`InferenceSession`]
+///
+/// Dropping the batcher runs any requests still queued, then stops its
+/// worker threads.
+pub struct DynamicBatcher {
+    shared: Arc<Shared>,
+    workers: Vec<JoinHandle<()>>,
+}
+
+impl DynamicBatcher {
+    /// Start batching requests for `session`
+    ///
+    /// Every engine input must have a leading batch dimension.
+    pub fn new(session: Arc<InferenceSession>, config: BatcherConfig) -> Result<Self> {
+        if config.workers == 0 {
+            return Err(Error::InvalidArgument(
+                "A batcher needs at least one worker".to_string(),
+            ));
+        }
+
+        let input_names: Vec<String> = session.inputs().map(|t| t.name.clone()).collect();
+        let engine_max = engine_max_batch(&session)?;
+        let max_batch = config
+            .max_batch_size
+            .map_or(engine_max, |max| max.min(engine_max));
+        if max_batch == 0 {
+            return Err(Error::InvalidArgument(
+                "Max batch size must be at least 1".to_string(),
+            ));
+        }
+
+        let shared = Arc::new(Shared {
+            session,
+            input_names,
+            max_batch,
+            max_wait: config.max_wait,
+            max_queue_depth: config.max_queue_depth,
+            queue: Mutex::new(Queue {
+                requests: VecDeque::new(),
+                shutdown: false,
+            }),
+            request_ready: Condvar::new(),
+            stats: Mutex::new(BatcherStats {
+                batch_size_histogram: vec![0; max_batch + 1],
+                requests_per_batch_histogram: vec![0; max_batch + 1],
+                ..BatcherStats::default()
+            }),
+        });
+
+        let mut batcher = DynamicBatcher {
+            shared,
+            workers: Vec::with_capacity(config.workers),
+        };
+        for i in 0..config.workers {
+            let shared = Arc::clone(&batcher.shared);
+            // On failure, dropping `batcher` stops the workers already started
+            let worker = std::thread::Builder::new()
+                .name(format!("trtx-batcher-{i}"))
+                .spawn(move || shared.work())?;
+            batcher.workers.push(worker);
+        }
+
+        Ok(batcher)
+    }
+
+    /// Get the largest number of rows merged into one batch
+    pub fn max_batch_size(&self) -> usize {
+        self.shared.max_batch
+    }
+
+    /// Queue a request of one or more rows
+    ///
+    /// All inputs must share the same leading dimension, which is the
+    /// request's row count.
+    pub fn submit(&self, inputs: Vec<TensorInput>) -> Result<PendingOutputs> {
+        let request = self.shared.prepare(inputs)?;
+        let pending = PendingOutputs {
+            completion: Arc::clone(&request.completion),
+        };
+
+        let mut queue = self.shared.queue.lock().unwrap();
+        if queue.requests.len() >= self.shared.max_queue_depth {
+            return Err(Error::Runtime(format!(
+                "Batching queue is full ({} requests)",
+                self.shared.max_queue_depth
+            )));
+        }
+        queue.requests.push_back(request);
+        drop(queue);
+        self.shared.request_ready.notify_one();
+
+        Ok(pending)
+    }
+
+    /// Queue a request and block until it has run
+    pub fn run(&self, inputs: Vec<TensorInput>) -> Result<Vec<TensorOutput>> {
+        self.submit(inputs)?.wait()
+    }
+
+    /// Get a snapshot of the queue depth and batch histograms
+    pub fn stats(&self) -> BatcherStats {
+        let queue_depth = self.shared.queue.lock().unwrap().requests.len();
+        BatcherStats {
+            queue_depth,
+            ..self.shared.stats.lock().unwrap().clone()
+        }
+    }
+}
+
+impl Drop for DynamicBatcher {
+    fn drop(&mut self) {
+        self.shared.queue.lock().unwrap().shutdown = true;
+        self.shared.request_ready.notify_all();
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
+
+impl Shared {
+    /// Check a request and put its inputs in engine order
+    fn prepare(&self, mut inputs: Vec<TensorInput>) -> Result<Request> {
+        if inputs.len() != self.input_names.len() {
+            return Err(Error::InvalidArgument(format!(
+                "Expected {} inputs, got {}",
+                self.input_names.len(),
+                inputs.len()
+            )));
+        }
+
+        let mut ordered = Vec::with_capacity(inputs.len());
+        for name in &self.input_names {
+            let index = inputs
+                .iter()
+                .position(|inp| &inp.name == name)
+                .ok_or_else(|| Error::InvalidArgument(format!("Missing input '{name}'")))?;
+            ordered.push(inputs.swap_remove(index));
+        }
+
+        let rows = ordered[0].shape.first().copied().unwrap_or(0);
+        for input in &ordered {
+            if input.shape.first() != Some(&rows) {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{}' has shape {:?}; all inputs need the same leading dimension {rows}",
+                    input.name, input.shape
+                )));
+            }
+            if input.data.len() != input.shape.iter().product::<usize>() {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{}' has {} values for shape {:?}",
+                    input.name,
+                    input.data.len(),
+                    input.shape
+                )));
+            }
+        }
+        if rows == 0 || rows > self.max_batch {
+            return Err(Error::InvalidArgument(format!(
+                "Request has {rows} rows; expected 1..={}",
+                self.max_batch
+            )));
+        }
+
+        Ok(Request {
+            inputs: ordered,
+            rows,
+            enqueued: Instant::now(),
+            completion: Completion::new(),
+        })
+    }
+
+    /// Worker loop: form batches until shut down and drained
+    fn work(&self) {
+        while let Some(batch) = self.next_batch() {
+            self.run_batch(batch);
+        }
+    }
+
+    /// Wait for a batch to fill up or hit its deadline; None once shut down and drained
+    fn next_batch(&self) -> Option<Vec<Request>> {
+        let mut queue = self.queue.lock().unwrap();
+        let first = loop {
+            if let Some(first) = queue.requests.pop_front() {
+                break first;
+            }
+            if queue.shutdown {
+                return None;
+            }
+            queue = self.request_ready.wait(queue).unwrap();
+        };
+
+        let deadline = first.enqueued + self.max_wait;
+        let mut rows = first.rows;
+        let mut batch = vec![first];
+
+        loop {
+            // Take compatible requests in arrival order while they fit
+            let mut i = 0;
+            while i < queue.requests.len() && rows < self.max_batch {
+                let candidate = &queue.requests[i];
+                if rows + candidate.rows <= self.max_batch && batch[0].compatible(candidate) {
+                    let request = queue.requests.remove(i).expect("index in range");
+                    rows += request.rows;
+                    batch.push(request);
+                } else {
+                    i += 1;
+                }
+            }
+
+            let now = Instant::now();
+            if rows >= self.max_batch || now >= deadline || queue.shutdown {
+                break;
+            }
+            queue = self
+                .request_ready
+                .wait_timeout(queue, deadline - now)
+                .unwrap()
+                .0;
+        }
+
+        // Others may still be waiting behind what this batch left behind
+        if !queue.requests.is_empty() {
+            self.request_ready.notify_one();
+        }
+        Some(batch)
+    }
+
+    fn run_batch(&self, mut batch: Vec<Request>) {
+        let rows: usize = batch.iter().map(|r| r.rows).sum();
+        {
+            let mut stats = self.stats.lock().unwrap();
+            stats.batches += 1;
+            stats.requests += batch.len() as u64;
+            stats.batch_size_histogram[rows] += 1;
+            stats.requests_per_batch_histogram[batch.len()] += 1;
+        }
+
+        if batch.len() == 1 {
+            let request = batch.pop().expect("one request");
+            let result = self.session.run(&request.inputs);
+            request.completion.complete(result);
+            return;
+        }
+
+        match self.run_merged(&batch, rows) {
+            Ok(per_request) => {
+                for (request, outputs) in batch.iter().zip(per_request) {
+                    request.completion.complete(Ok(outputs));
+                }
+            }
+            Err(e) => {
+                let message = e.to_string();
+                for request in &batch {
+                    request
+                        .completion
+                        .complete(Err(Error::Runtime(message.clone())));
+                }
+            }
+        }
+    }
+
+    /// Concatenate the batch along dimension 0, run it and split the outputs back
+    fn run_merged(&self, batch: &[Request], rows: usize) -> Result<Vec<Vec<TensorOutput>>> {
+        let merged: Vec<TensorInput> = (0..self.input_names.len())
+            .map(|i| {
+                let first = &batch[0].inputs[i];
+                let mut shape = first.shape.clone();
+                shape[0] = rows;
+                let data = TensorData::concat(batch.iter().map(|r| &r.inputs[i].data))?;
+                Ok(TensorInput {
+                    name: first.name.clone(),
+                    shape,
+                    data,
+                })
+            })
+            .collect::<Result<_>>()?;
+
+        let outputs = self.session.run(&merged)?;
+
+        let mut per_request: Vec<Vec<TensorOutput>> = batch
+            .iter()
+            .map(|_| Vec::with_capacity(outputs.len()))
+            .collect();
+        for output in outputs {
+            if output.shape.first() != Some(&rows) {
+                return Err(Error::Runtime(format!(
+                    "Output '{}' has shape {:?}; cannot split it into a batch of {rows}",
+                    output.name, output.shape
+                )));
+            }
+            let row_len: usize = output.shape[1..].iter().product();
+
+            let mut offset = 0;
+            for (request, outputs) in batch.iter().zip(&mut per_request) {
+                let len = request.rows * row_len;
+                let mut shape = output.shape.clone();
+                shape[0] = request.rows;
+                outputs.push(TensorOutput {
+                    name: output.name.clone(),
+                    shape,
+                    data: output.data.slice(offset..offset + len),
+                });
+                offset += len;
+            }
+        }
+
+        Ok(per_request)
+    }
+}
+
+/// Largest batch the engine accepts on its first input, across all profiles
+fn engine_max_batch(session: &InferenceSession) -> Result<usize> {
+    let first = session
+        .inputs()
+        .next()
+        .ok_or_else(|| Error::InvalidArgument("Engine has no inputs".to_string()))?;
+    let batch_dim = *first.shape.first().ok_or_else(|| {
+        Error::InvalidArgument(format!("Input '{}' has no batch dimension", first.name))
+    })?;
+
+    if batch_dim >= 0 {
+        return Ok(batch_dim as usize);
+    }
+
+    let engine = session.engine();
+    let mut max = 0;
+    for profile in 0..engine.get_nb_optimization_profiles()? {
+        let shape = engine.get_profile_shape(&first.name, profile, ProfileSelector::Max)?;
+        max = max.max(shape.first().copied().unwrap_or(0).max(0) as usize);
+    }
+    Ok(max)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::session::SessionConfig;
+    use crate::Logger;
+
+    fn row_input(rows: usize) -> Vec<TensorInput> {
+        vec![TensorInput {
+            name: "input".to_string(),
+            shape: vec![rows, 3, 224, 224],
+            data: vec![0.5f32; rows * 3 * 224 * 224].into(),
+        }]
+    }
+
+    fn session() -> Arc<InferenceSession> {
+        let logger = Logger::stderr().unwrap();
+        Arc::new(
+            InferenceSession::from_onnx(logger, &[0u8; 100], SessionConfig::default()).unwrap(),
+        )
+    }
+
+    #[test]
+    fn test_batcher_merges_requests() {
+        let config = BatcherConfig {
+            max_wait: Duration::from_millis(200),
+            ..BatcherConfig::default()
+        };
+        let batcher = DynamicBatcher::new(session(), config).unwrap();
+        assert_eq!(batcher.max_batch_size(), 8);
+
+        let pending: Vec<_> = [1, 2, 1]
+            .iter()
+            .map(|&rows| batcher.submit(row_input(rows)).unwrap())
+            .collect();
+        for (pending, rows) in pending.into_iter().zip([1, 2, 1]) {
+            let outputs = pending.wait().unwrap();
+            assert_eq!(outputs[0].shape, vec![rows, 1000]);
+            assert_eq!(outputs[0].data.len(), rows * 1000);
+        }
+
+        let stats = batcher.stats();
+        assert_eq!(stats.queue_depth, 0);
+        assert_eq!(stats.requests, 3);
+        assert_eq!(
+            stats.batch_size_histogram.iter().sum::<u64>(),
+            stats.batches
+        );
+        assert!(stats.batches < 3);
+    }
+
+    #[test]
+    fn test_batcher_rejects_oversized_requests() {
+        let config = BatcherConfig {
+            max_batch_size: Some(4),
+            ..BatcherConfig::default()
+        };
+        let batcher = DynamicBatcher::new(session(), config).unwrap();
+        assert!(batcher.submit(row_input(5)).is_err());
+        assert_eq!(batcher.run(row_input(4)).unwrap()[0].shape, vec![4, 1000]);
+    }
+}
@@ -0,0 +1,441 @@
+//! Throughput and latency measurement in the style of `trtexec`
+//!
+//! [`benchmark`] runs an engine on several execution contexts at once, each
+//! on its own thread and CUDA stream, and times every iteration twice: on the
+//! host, from queueing the first input copy until the last output copy has
+//! finished, and on the GPU, with events between the host-to-device copies,
+//! the inference launch and the device-to-host copies. The returned
+//! [`BenchmarkReport`] summarizes both as percentiles and serializes to JSON,
+//! so runs can be compared across releases.
+//!
+//! Built with the `mock` feature the engine does no work and the GPU phases
+//! take no time, so the same benchmark measures the overhead of the FFI
+//! layer alone.
+
+use crate::cuda::{
+    event_flags, CudaEvent, CudaStream, DeviceBuffer, DeviceGuard, PinnedHostBuffer,
+};
+use crate::error::{Error, Result};
+use crate::runtime::{CudaEngine, ExecutionContext};
+use crate::tensor::{ProfileSelector, TensorInfo};
+use std::fmt::Write as _;
+use std::sync::Barrier;
+use std::time::{Duration, Instant};
+
+/// Configuration for [`benchmark`]
+#[derive(Debug, Clone)]
+pub struct BenchmarkConfig {
+    /// Unmeasured iterations per context, to settle clocks and lazy allocations
+    pub warmup_iterations: usize,
+    /// Measured iterations per context
+    pub iterations: usize,
+    /// Execution contexts running concurrently, each with its own thread and stream
+    pub contexts: usize,
+    /// Shapes for dynamic inputs; unlisted ones use the opt shape of profile 0
+    pub input_shapes: Vec<(String, Vec<i64>)>,
+    /// Replay launches from captured CUDA graphs
+    pub cuda_graphs: bool,
+}
+
+impl Default for BenchmarkConfig {
+    fn default() -> Self {
+        BenchmarkConfig {
+            warmup_iterations: 10,
+            iterations: 100,
+            contexts: 1,
+            input_shapes: Vec::new(),
+            cuda_graphs: false,
+        }
+    }
+}
+
+/// Distribution of one timing, in milliseconds
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct LatencySummary {
+    /// Fastest sample
+    pub min: f64,
+    /// Arithmetic mean
+    pub mean: f64,
+    /// Median
+    pub p50: f64,
+    /// 90th percentile
+    pub p90: f64,
+    /// 99th percentile
+    pub p99: f64,
+    /// Slowest sample
+    pub max: f64,
+}
+
+impl LatencySummary {
+    /// Summarize samples; all fields are zero if there are none
+    pub fn from_samples(samples: &[f64]) -> Self {
+        if samples.is_empty() {
+            return LatencySummary::default();
+        }
+
+        let mut sorted = samples.to_vec();
+        sorted.sort_by(f64::total_cmp);
+        // Nearest-rank percentile
+        let percentile = |p: f64| {
+            let rank = (p / 100.0 * sorted.len() as f64).ceil() as usize;
+            sorted[rank.clamp(1, sorted.len()) - 1]
+        };
+
+        LatencySummary {
+            min: sorted[0],
+            mean: sorted.iter().sum::<f64>() / sorted.len() as f64,
+            p50: percentile(50.0),
+            p90: percentile(90.0),
+            p99: percentile(99.0),
+            max: sorted[sorted.len() - 1],
+        }
+    }
+
+    fn write_json(&self, out: &mut String) {
+        let _ = write!(
+            out,
+            "{{\"min\":{},\"mean\":{},\"p50\":{},\"p90\":{},\"p99\":{},\"max\":{}}}",
+            self.min, self.mean, self.p50, self.p90, self.p99, self.max
+        );
+    }
+}
+
+/// Results of one [`benchmark`] run
+#[derive(Debug, Clone)]
+pub struct BenchmarkReport {
+    /// Whether the run used the mock backend, i.e. measured FFI overhead only
+    pub mock: bool,
+    /// Concurrent execution contexts
+    pub contexts: usize,
+    /// Measured iterations across all contexts
+    pub iterations: usize,
+    /// Shape of every input as run
+    pub input_shapes: Vec<(String, Vec<i64>)>,
+    /// Time from the first measured iteration starting to the last one finishing
+    pub wall_time: Duration,
+    /// Inferences per second across all contexts
+    pub throughput: f64,
+    /// Host-side time per iteration, copies included
+    pub latency: LatencySummary,
+    /// GPU time of the host-to-device input copies
+    pub h2d: LatencySummary,
+    /// GPU time of the inference launch
+    pub compute: LatencySummary,
+    /// GPU time of the device-to-host output copies
+    pub d2h: LatencySummary,
+}
+
+impl BenchmarkReport {
+    /// Serialize the report as a single JSON object
+    pub fn to_json(&self) -> String {
+        let mut out = String::new();
+        let _ = write!(
+            out,
+            "{{\"mock\":{},\"contexts\":{},\"iterations\":{},\"input_shapes\":{{",
+            self.mock, self.contexts, self.iterations
+        );
+        for (i, (name, shape)) in self.input_shapes.iter().enumerate() {
+            if i > 0 {
+                out.push(',');
+            }
+            write_json_string(&mut out, name);
+            let _ = write!(out, ":{shape:?}");
+        }
+        let _ = write!(
+            out,
+            "}},\"wall_time_ms\":{},\"throughput_per_s\":{}",
+            self.wall_time.as_secs_f64() * 1e3,
+            self.throughput
+        );
+        for (key, summary) in [
+            ("latency_ms", &self.latency),
+            ("h2d_ms", &self.h2d),
+            ("compute_ms", &self.compute),
+            ("d2h_ms", &self.d2h),
+        ] {
+            let _ = write!(out, ",\"{key}\":");
+            summary.write_json(&mut out);
+        }
+        out.push('}');
+        out
+    }
+}
+
+fn write_json_string(out: &mut String, value: &str) {
+    out.push('"');
+    for c in value.chars() {
+        match c {
+            '"' => out.push_str("\\\""),
+            '\\' => out.push_str("\\\\"),
+            c if (c as u32) < 0x20 => {
+                let _ = write!(out, "\\u{:04x}", c as u32);
+            }
+            c => out.push(c),
+        }
+    }
+    out.push('"');
+}
+
+/// Times of one iteration, in milliseconds
+#[derive(Debug, Clone, Copy)]
+struct Sample {
+    latency: f64,
+    h2d: f64,
+    compute: f64,
+    d2h: f64,
+}
+
+/// Device buffer, pinned host copy and byte size of one IO tensor
+struct Binding {
+    device: DeviceBuffer,
+    host: PinnedHostBuffer,
+    size: usize,
+}
+
+/// One execution context with everything an iteration needs
+struct Worker<'e> {
+    // Declared first so the context is gone before the memory it is bound to
+    context: ExecutionContext<'e>,
+    stream: CudaStream,
+    inputs: Vec<Binding>,
+    outputs: Vec<Binding>,
+    // Before the input copies, after them, after the launch, after the output copies
+    events: [CudaEvent; 4],
+}
+
+impl<'e> Worker<'e> {
+    fn new(
+        engine: &'e CudaEngine,
+        tensors: &[TensorInfo],
+        input_shapes: &[(String, Vec<i64>)],
+        cuda_graphs: bool,
+    ) -> Result<Self> {
+        let mut context = engine.create_execution_context()?;
+        if cuda_graphs {
+            context.enable_cuda_graphs(1)?;
+        }
+        for (name, shape) in input_shapes {
+            context.set_input_shape(name, shape)?;
+        }
+
+        let mut inputs = Vec::new();
+        let mut outputs = Vec::new();
+        for info in tensors {
+            let shape = context.get_tensor_shape(&info.name)?;
+            let size = info.size_in_bytes_for(&shape).ok_or_else(|| {
+                Error::InvalidArgument(format!(
+                    "Tensor '{}' has unresolved shape {shape:?}",
+                    info.name
+                ))
+            })?;
+            let binding = Binding {
+                device: DeviceBuffer::new(size.max(1))?,
+                host: PinnedHostBuffer::new(size.max(1))?,
+                size,
+            };
+            // SAFETY: the buffer is owned by the worker and outlives the context
+            unsafe { context.set_tensor_address(&info.name, binding.device.as_ptr())? };
+            if info.is_input() {
+                inputs.push(binding);
+            } else {
+                outputs.push(binding);
+            }
+        }
+
+        let event = || CudaEvent::with_flags(event_flags::DEFAULT);
+        Ok(Worker {
+            context,
+            stream: CudaStream::new()?,
+            inputs,
+            outputs,
+            events: [event()?, event()?, event()?, event()?],
+        })
+    }
+
+    fn run_once(&mut self) -> Result<Sample> {
+        let start = Instant::now();
+        let [before, copied_in, computed, copied_out] = &self.events;
+
+        before.record(&self.stream)?;
+        for binding in &mut self.inputs {
+            // SAFETY: host and device memory are owned by the worker, which
+            // waits for the stream before the next iteration touches them
+            unsafe {
+                binding
+                    .device
+                    .copy_from_host_async(&binding.host.as_slice()[..binding.size], &self.stream)?;
+            }
+        }
+        copied_in.record(&self.stream)?;
+        // SAFETY: every IO tensor is bound to a buffer of the worker
+        unsafe { self.context.enqueue_v3(&self.stream)? };
+        computed.record(&self.stream)?;
+        for binding in &mut self.outputs {
+            // SAFETY: as for the input copies
+            unsafe {
+                binding.device.copy_to_host_async(
+                    &mut binding.host.as_mut_slice()[..binding.size],
+                    &self.stream,
+                )?;
+            }
+        }
+        copied_out.record(&self.stream)?;
+        copied_out.synchronize()?;
+
+        Ok(Sample {
+            latency: start.elapsed().as_secs_f64() * 1e3,
+            h2d: f64::from(copied_in.elapsed_ms_since(before)?),
+            compute: f64::from(computed.elapsed_ms_since(copied_in)?),
+            d2h: f64::from(copied_out.elapsed_ms_since(computed)?),
+        })
+    }
+}
+
+/// Resolve the shape every input runs with
+pub(crate) fn resolve_input_shapes(
+    engine: &CudaEngine,
+    tensors: &[TensorInfo],
+    overrides: &[(String, Vec<i64>)],
+) -> Result<Vec<(String, Vec<i64>)>> {
+    for (name, _) in overrides {
+        if !tensors.iter().any(|t| t.is_input() && &t.name == name) {
+            return Err(Error::InvalidArgument(format!(
+                "Engine has no input named '{name}'"
+            )));
+        }
+    }
+
+    tensors
+        .iter()
+        .filter(|info| info.is_input())
+        .map(|info| {
+            let shape = match overrides.iter().find(|(name, _)| name == &info.name) {
+                Some((_, shape)) => shape.clone(),
+                None if info.is_static() => info.shape.clone(),
+                None => engine.get_profile_shape(&info.name, 0, ProfileSelector::Opt)?,
+            };
+            Ok((info.name.clone(), shape))
+        })
+        .collect()
+}
+
+/// Benchmark `engine` with zero-filled inputs
+///
+/// Every context runs its warmup iterations, then all contexts start their
+/// measured iterations together, so [`BenchmarkReport::throughput`] reflects
+/// them competing for the GPU.
+pub fn benchmark(engine: &CudaEngine, config: &BenchmarkConfig) -> Result<BenchmarkReport> {
+    if config.contexts == 0 || config.iterations == 0 {
+        return Err(Error::InvalidArgument(
+            "Benchmark needs at least one context and one iteration".to_string(),
+        ));
+    }
+
+    let tensors = engine.io_tensors()?;
+    let input_shapes = resolve_input_shapes(engine, &tensors, &config.input_shapes)?;
+
+    // One extra party: the measuring thread starts the clock once all are warm
+    let barrier = Barrier::new(config.contexts + 1);
+    let (wall_time, results) = std::thread::scope(|scope| {
+        let handles = (0..config.contexts)
+            .map(|_| {
+                scope.spawn(|| {
+                    // Buffers, streams and events belong on the engine's device,
+                    // and the guard outlives the worker that frees them
+                    let mut device = None;
+                    let prepared = DeviceGuard::new(engine.device()).and_then(|guard| {
+                        device = Some(guard);
+                        let mut worker =
+                            Worker::new(engine, &tensors, &input_shapes, config.cuda_graphs)?;
+                        for _ in 0..config.warmup_iterations {
+                            worker.run_once()?;
+                        }
+                        Ok(worker)
+                    });
+                    // Wait even after failing, so the other threads are not stuck
+                    barrier.wait();
+                    let mut worker = prepared?;
+                    (0..config.iterations)
+                        .map(|_| worker.run_once())
+                        .collect::<Result<Vec<_>>>()
+                })
+            })
+            .collect::<Vec<_>>();
+
+        barrier.wait();
+        let start = Instant::now();
+        let results = handles
+            .into_iter()
+            .map(|handle| match handle.join() {
+                Ok(samples) => samples,
+                Err(panic) => std::panic::resume_unwind(panic),
+            })
+            .collect::<Vec<_>>();
+        (start.elapsed(), results)
+    });
+
+    let samples = results.into_iter().collect::<Result<Vec<_>>>()?.concat();
+    let summarize = |field: fn(&Sample) -> f64| {
+        LatencySummary::from_samples(&samples.iter().map(field).collect::<Vec<_>>())
+    };
+
+    Ok(BenchmarkReport {
+        mock: cfg!(feature = "mock"),
+        contexts: config.contexts,
+        iterations: samples.len(),
+        input_shapes,
+        wall_time,
+        throughput: samples.len() as f64 / wall_time.as_secs_f64().max(f64::MIN_POSITIVE),
+        latency: summarize(|s| s.latency),
+        h2d: summarize(|s| s.h2d),
+        compute: summarize(|s| s.compute),
+        d2h: summarize(|s| s.d2h),
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{Logger, Runtime};
+
+    #[test]
+    fn test_latency_summary() {
+        let samples = (1..=100).rev().map(f64::from).collect::<Vec<_>>();
+        let summary = LatencySummary::from_samples(&samples);
+        assert_eq!((summary.min, summary.max), (1.0, 100.0));
+        assert_eq!((summary.p50, summary.p90, summary.p99), (50.0, 90.0, 99.0));
+        assert_eq!(summary.mean, 50.5);
+        assert_eq!(LatencySummary::from_samples(&[]), LatencySummary::default());
+    }
+
+    #[test]
+    fn test_benchmark_mock_engine() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+
+        let config = BenchmarkConfig {
+            warmup_iterations: 2,
+            iterations: 5,
+            contexts: 2,
+            input_shapes: vec![("input".to_string(), vec![4, 3, 224, 224])],
+            ..BenchmarkConfig::default()
+        };
+        let report = benchmark(&engine, &config).unwrap();
+        assert!(report.mock);
+        assert_eq!(report.iterations, 10);
+        assert_eq!(report.input_shapes, config.input_shapes);
+        assert!(report.throughput > 0.0);
+
+        let json = report.to_json();
+        assert!(json.starts_with("{\"mock\":true,\"contexts\":2,\"iterations\":10,"));
+        assert!(json.contains("\"input_shapes\":{\"input\":[4, 3, 224, 224]}"));
+        assert!(json.contains("\"compute_ms\":{\"min\":0,"));
+
+        let unknown = BenchmarkConfig {
+            input_shapes: vec![("missing".to_string(), vec![1])],
+            ..BenchmarkConfig::default()
+        };
+        assert!(benchmark(&engine, &unknown).is_err());
+    }
+}
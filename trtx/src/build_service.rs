@@ -0,0 +1,334 @@
+//! Parallel engine builds sharing one timing cache
+//!
+//! Building many model variants one after the other spends most of its time
+//! profiling tactics, and the variants usually profile the same layers. A
+//! [`BuildService`] runs a list of [`BuildJob`]s on worker threads and lets
+//! every job start from the timings the others have already measured: each
+//! job builds with a snapshot of a shared [`TimingCache`], and what it
+//! learned is merged back once it finishes. The merged cache can be persisted
+//! to disk so the next run skips profiling altogether.
+
+use crate::builder::{network_flags, BuilderConfig, HostMemory, TimingCache};
+use crate::engine_cache::{write_atomically, EngineCache};
+use crate::error::Result;
+use crate::{Builder, Logger, OnnxParser};
+use std::path::PathBuf;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+/// Callback that applies a job's settings to a fresh builder config
+pub type ConfigureFn = dyn Fn(&Builder<'_>, &mut BuilderConfig) -> Result<()> + Send + Sync;
+
+/// One engine to build
+#[derive(Clone)]
+pub struct BuildJob {
+    /// Name reported back in the job's [`BuildOutcome`]
+    pub name: String,
+    /// ONNX model bytes
+    pub onnx: Arc<[u8]>,
+    configure: Option<Arc<ConfigureFn>>,
+}
+
+impl BuildJob {
+    /// Create a job that builds `onnx` with default builder settings
+    pub fn new(name: impl Into<String>, onnx: impl Into<Arc<[u8]>>) -> Self {
+        BuildJob {
+            name: name.into(),
+            onnx: onnx.into(),
+            configure: None,
+        }
+    }
+
+    /// Apply settings (memory limits, optimization profiles, ...) to the job's config
+    pub fn configure<F>(mut self, configure: F) -> Self
+    where
+        F: Fn(&Builder<'_>, &mut BuilderConfig) -> Result<()> + Send + Sync + 'static,
+    {
+        self.configure = Some(Arc::new(configure));
+        self
+    }
+}
+
+impl std::fmt::Debug for BuildJob {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("BuildJob")
+            .field("name", &self.name)
+            .field("onnx_len", &self.onnx.len())
+            .finish()
+    }
+}
+
+/// Configuration for [`BuildService`]
+#[derive(Debug, Clone, Default)]
+pub struct BuildServiceConfig {
+    /// Builds running at once; `0` uses the available parallelism
+    pub workers: usize,
+    /// File the shared timing cache is loaded from and saved to
+    pub timing_cache_path: Option<PathBuf>,
+    /// Accept timing caches recorded on another device or TensorRT-RTX version
+    pub ignore_timing_cache_mismatch: bool,
+    /// Skip jobs whose plan is already cached, and store the plans that are built
+    pub engine_cache: Option<EngineCache>,
+}
+
+/// Plan produced for one job
+#[derive(Debug)]
+pub enum BuiltPlan {
+    /// Freshly built plan (also stored in the engine cache, if configured)
+    Built(HostMemory),
+    /// Plan found in the engine cache; nothing was built
+    Cached(PathBuf),
+}
+
+/// Result of one job
+#[derive(Debug)]
+pub struct BuildOutcome {
+    /// Name of the job
+    pub name: String,
+    /// The plan, or why the job failed
+    pub plan: Result<BuiltPlan>,
+    /// Wall-clock time the job took
+    pub elapsed: Duration,
+}
+
+/// Builds engines on several threads with a shared, persistent timing cache
+pub struct BuildService {
+    logger: Logger,
+    config: BuildServiceConfig,
+    // Serialized shared cache; every job starts from a snapshot of it
+    timing_cache: Mutex<SharedTimingCache>,
+}
+
+struct SharedTimingCache {
+    blob: Vec<u8>,
+    // Whether any job merged new timings since the cache was loaded or saved
+    dirty: bool,
+}
+
+impl BuildService {
+    /// Create a service, loading the timing cache from disk if it exists
+    pub fn new(logger: Logger, config: BuildServiceConfig) -> Result<Self> {
+        let blob = match &config.timing_cache_path {
+            Some(path) => match std::fs::read(path) {
+                Ok(blob) => blob,
+                Err(e) if e.kind() == std::io::ErrorKind::NotFound => Vec::new(),
+                Err(e) => return Err(e.into()),
+            },
+            None => Vec::new(),
+        };
+
+        Ok(BuildService {
+            logger,
+            config,
+            timing_cache: Mutex::new(SharedTimingCache { blob, dirty: false }),
+        })
+    }
+
+    /// Get the serialized shared timing cache (empty until a job has finished)
+    pub fn timing_cache(&self) -> Vec<u8> {
+        self.lock_cache().blob.clone()
+    }
+
+    /// Build every job, at most [`BuildServiceConfig::workers`] at a time
+    ///
+    /// Outcomes are returned in job order; one job failing does not stop the
+    /// others. The merged timing cache is saved to
+    /// [`BuildServiceConfig::timing_cache_path`] afterwards, which is the only
+    /// error reported through the outer `Result`.
+    pub fn build_all(&self, jobs: &[BuildJob]) -> Result<Vec<BuildOutcome>> {
+        let workers = match self.config.workers {
+            0 => std::thread::available_parallelism().map_or(1, |n| n.get()),
+            n => n,
+        }
+        .min(jobs.len());
+
+        let next = AtomicUsize::new(0);
+        let mut outcomes = std::thread::scope(|scope| {
+            let handles = (0..workers)
+                .map(|_| {
+                    scope.spawn(|| {
+                        let mut done = Vec::new();
+                        loop {
+                            let index = next.fetch_add(1, Ordering::Relaxed);
+                            let Some(job) = jobs.get(index) else {
+                                return done;
+                            };
+                            done.push((index, self.run_job(job)));
+                        }
+                    })
+                })
+                .collect::<Vec<_>>();
+
+            handles
+                .into_iter()
+                .flat_map(|handle| match handle.join() {
+                    Ok(done) => done,
+                    Err(panic) => std::panic::resume_unwind(panic),
+                })
+                .collect::<Vec<_>>()
+        });
+
+        outcomes.sort_by_key(|(index, _)| *index);
+        self.save_timing_cache()?;
+        Ok(outcomes.into_iter().map(|(_, outcome)| outcome).collect())
+    }
+
+    /// Write the shared timing cache to disk if it changed
+    ///
+    /// Does nothing without a [`BuildServiceConfig::timing_cache_path`].
+    pub fn save_timing_cache(&self) -> Result<()> {
+        let Some(path) = &self.config.timing_cache_path else {
+            return Ok(());
+        };
+
+        let mut cache = self.lock_cache();
+        if !cache.dirty {
+            return Ok(());
+        }
+        write_atomically(path, &cache.blob)?;
+        cache.dirty = false;
+        Ok(())
+    }
+
+    fn run_job(&self, job: &BuildJob) -> BuildOutcome {
+        let start = Instant::now();
+        let plan = self.build_job(job);
+        BuildOutcome {
+            name: job.name.clone(),
+            plan,
+            elapsed: start.elapsed(),
+        }
+    }
+
+    fn build_job(&self, job: &BuildJob) -> Result<BuiltPlan> {
+        let builder = Builder::new(&self.logger)?;
+        let mut config = builder.create_config()?;
+        if let Some(configure) = &job.configure {
+            configure(&builder, &mut config)?;
+        }
+
+        let key = match &self.config.engine_cache {
+            Some(cache) => {
+                let key = cache.key(&job.onnx, &config)?;
+                if let Some(path) = cache.lookup(&key) {
+                    return Ok(BuiltPlan::Cached(path));
+                }
+                Some((cache, key))
+            }
+            None => None,
+        };
+
+        // Each job profiles into its own copy so builds never contend on one cache
+        let snapshot = self.lock_cache().blob.clone();
+        let job_cache = config.create_timing_cache(&snapshot)?;
+        config.set_timing_cache(job_cache, self.config.ignore_timing_cache_mismatch)?;
+
+        let network = builder.create_network(network_flags::EXPLICIT_BATCH)?;
+        let parser = OnnxParser::new(&network, &self.logger)?;
+        parser.parse(&job.onnx)?;
+        let plan = builder.build_serialized_network(&network, &config)?;
+
+        if let Some(job_cache) = config.timing_cache() {
+            self.merge_timing_cache(&config, job_cache, &snapshot)?;
+        }
+        if let Some((cache, key)) = key {
+            cache.store(&key, &plan)?;
+        }
+        Ok(BuiltPlan::Built(plan))
+    }
+
+    /// Merge what a job learned into the shared cache
+    fn merge_timing_cache(
+        &self,
+        config: &BuilderConfig,
+        job_cache: &TimingCache,
+        snapshot: &[u8],
+    ) -> Result<()> {
+        let ignore_mismatch = self.config.ignore_timing_cache_mismatch;
+        let mut shared = self.lock_cache();
+
+        let blob = if shared.blob.as_slice() == snapshot {
+            // Nobody merged in the meantime: the job's cache already holds everything
+            job_cache.serialize()?
+        } else {
+            // Entries both caches inherited from the snapshot are deduplicated
+            let mut merged = config.create_timing_cache(&shared.blob)?;
+            merged.combine(job_cache, ignore_mismatch)?;
+            merged.serialize()?
+        };
+
+        shared.blob = blob.to_vec();
+        shared.dirty = true;
+        Ok(())
+    }
+
+    fn lock_cache(&self) -> std::sync::MutexGuard<'_, SharedTimingCache> {
+        self.timing_cache
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::builder::MemoryPoolType;
+    use crate::error::Error;
+
+    #[test]
+    fn test_build_all_shares_timing_cache() {
+        let dir = std::env::temp_dir().join(format!("trtx-build-service-{}", std::process::id()));
+        let _ = std::fs::remove_dir_all(&dir);
+        let cache_path = dir.join("timing.cache");
+
+        let config = BuildServiceConfig {
+            workers: 2,
+            timing_cache_path: Some(cache_path.clone()),
+            ..BuildServiceConfig::default()
+        };
+        let service = BuildService::new(Logger::stderr().unwrap(), config.clone()).unwrap();
+        assert!(service.timing_cache().is_empty());
+
+        let jobs = (0..4)
+            .map(|i| {
+                BuildJob::new(format!("variant-{i}"), vec![i as u8; 100]).configure(
+                    move |_, config| {
+                        config.set_memory_pool_limit(MemoryPoolType::Workspace, (i + 1) << 20)
+                    },
+                )
+            })
+            .collect::<Vec<_>>();
+
+        let outcomes = service.build_all(&jobs).unwrap();
+        assert_eq!(outcomes.len(), 4);
+        for (i, outcome) in outcomes.iter().enumerate() {
+            assert_eq!(outcome.name, format!("variant-{i}"));
+            assert!(matches!(outcome.plan, Ok(BuiltPlan::Built(_))));
+        }
+
+        // The merged cache was persisted and is picked up by the next service
+        let saved = std::fs::read(&cache_path).unwrap();
+        assert!(!saved.is_empty());
+        assert_eq!(saved, service.timing_cache());
+        let reloaded = BuildService::new(Logger::stderr().unwrap(), config).unwrap();
+        assert_eq!(reloaded.timing_cache(), saved);
+
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn test_build_all_reports_job_errors() {
+        let service =
+            BuildService::new(Logger::stderr().unwrap(), BuildServiceConfig::default()).unwrap();
+        let jobs = vec![
+            BuildJob::new("ok", vec![0u8; 100]),
+            BuildJob::new("bad", vec![0u8; 100])
+                .configure(|_, _| Err(Error::InvalidArgument("unsupported variant".to_string()))),
+        ];
+
+        let outcomes = service.build_all(&jobs).unwrap();
+        assert!(outcomes[0].plan.is_ok());
+        assert!(matches!(outcomes[1].plan, Err(Error::InvalidArgument(_))));
+    }
+}
@@ -2,12 +2,139 @@
 
 use crate::error::{Error, Result};
 use crate::logger::Logger;
+use crate::tensor::{to_dims, ProfileSelector};
+use std::collections::BTreeMap;
+use std::ffi::CString;
+use std::marker::PhantomData;
 use trtx_sys::*;
 
 /// Network definition builder flags
 pub mod network_flags {
     /// Explicit batch sizes
     pub const EXPLICIT_BATCH: u32 = 1 << 0;
+    /// Take tensor types from the network instead of letting the builder pick precisions
+    pub const STRONGLY_TYPED: u32 = 1 << 1;
+}
+
+/// Tactic source bitmask values for [`BuilderConfig::set_tactic_sources`]
+pub mod tactic_sources {
+    /// cuBLAS kernels
+    pub const CUBLAS: u32 = 1 << 0;
+    /// cuBLAS LT kernels
+    pub const CUBLAS_LT: u32 = 1 << 1;
+    /// cuDNN kernels
+    pub const CUDNN: u32 = 1 << 2;
+    /// Edge mask tables for convolutions
+    pub const EDGE_MASK_CONVOLUTIONS: u32 = 1 << 3;
+    /// Convolutions compiled at build time
+    pub const JIT_CONVOLUTIONS: u32 = 1 << 4;
+}
+
+/// Boolean build options toggled with [`BuilderConfig::set_flag`]
+///
+/// Not every flag is honoured by TensorRT-RTX; unsupported ones are
+/// rejected when set.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum BuilderFlag {
+    /// Allow FP16 kernels
+    Fp16 = 0,
+    /// Allow INT8 kernels
+    Int8 = 1,
+    /// Synchronize after every layer, for debugging
+    Debug = 2,
+    /// Fall back to the GPU for layers a DLA cannot run
+    GpuFallback = 3,
+    /// Keep weights refittable after the build
+    Refit = 4,
+    /// Do not consult or update the timing cache
+    DisableTimingCache = 5,
+    /// Allow TF32 for FP32 math
+    Tf32 = 6,
+    /// Use structured-sparsity kernels where weights allow
+    SparseWeights = 7,
+    /// Fail rather than ignore layer precision constraints
+    ObeyPrecisionConstraints = 9,
+    /// Prefer layer precision constraints when a kernel exists
+    PreferPrecisionConstraints = 10,
+    /// Keep network IO in the requested formats, without reformatting
+    DirectIo = 11,
+    /// Fail when a layer has no valid tactic
+    RejectEmptyAlgorithms = 12,
+    /// Build a plan loadable by later TensorRT versions
+    VersionCompatible = 13,
+    /// Leave the lean runtime out of version-compatible plans
+    ExcludeLeanRuntime = 14,
+    /// Allow FP8 kernels
+    Fp8 = 15,
+    /// Fail when a tactic is missing from the timing cache
+    ErrorOnTimingCacheMiss = 16,
+    /// Allow BF16 kernels
+    Bf16 = 17,
+    /// Do not cache compiled kernels
+    DisableCompilationCache = 18,
+    /// Strip refittable weights from the plan
+    StripPlan = 19,
+    /// Refit only with the weights the engine was built with
+    RefitIdentical = 20,
+    /// Allow weights to stay in host memory and stream in at run time
+    WeightStreaming = 21,
+    /// Allow INT4 weight-only kernels
+    Int4 = 22,
+    /// Mark individual weights refittable
+    RefitIndividual = 23,
+    /// Do not trade NaN propagation for speed
+    StrictNans = 24,
+    /// Track device memory during the build
+    MonitorMemory = 25,
+    /// Allow FP4 kernels
+    Fp4 = 26,
+    /// Record the timing cache in an editable form
+    EditableTimingCache = 27,
+}
+
+/// How much layer detail a built engine records for inspection and profiling
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum ProfilingVerbosity {
+    /// Layer names only (the default)
+    LayerNamesOnly = 0,
+    /// Nothing
+    None = 1,
+    /// Layer names plus precisions, formats and the chosen tactics
+    Detailed = 2,
+}
+
+/// Which GPUs an engine built on this one must run on
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum HardwareCompatibilityLevel {
+    /// Only GPUs of the build GPU's exact model line
+    None = 0,
+    /// Any Ampere or newer GPU
+    AmperePlus = 1,
+    /// Any GPU with the build GPU's compute capability
+    SameComputeCapability = 2,
+}
+
+/// GPU architecture a TensorRT-RTX engine is compiled for
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum ComputeCapability {
+    /// No specific target
+    None = 0,
+    /// The GPU the build runs on
+    Current = 1,
+    /// Turing
+    Sm75 = 75,
+    /// Ampere (data center)
+    Sm80 = 80,
+    /// Ampere
+    Sm86 = 86,
+    /// Ada Lovelace
+    Sm89 = 89,
+    /// Blackwell
+    Sm120 = 120,
 }
 
 /// Memory pool types
@@ -24,6 +151,73 @@ pub enum MemoryPoolType {
     DlaGlobalDram = 3,
 }
 
+/// Serialized engine plan owned by TensorRT
+///
+/// Wraps the `IHostMemory` returned by the builder and derefs to `&[u8]`,
+/// so the plan is never copied into a Rust-owned allocation.
+pub struct HostMemory {
+    inner: *mut TrtxHostMemory,
+    data: *const u8,
+    size: usize,
+}
+
+impl HostMemory {
+    /// Take ownership of a raw host memory handle
+    ///
+    /// # Safety
+    ///
+    /// `inner` must be a valid handle returned by trtx-sys that is not owned elsewhere.
+    pub(crate) unsafe fn from_raw(inner: *mut TrtxHostMemory) -> Self {
+        let data = trtx_host_memory_data(inner) as *const u8;
+        let size = trtx_host_memory_size(inner);
+        HostMemory { inner, data, size }
+    }
+
+    /// Get the serialized bytes
+    pub fn as_bytes(&self) -> &[u8] {
+        if self.data.is_null() || self.size == 0 {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.data, self.size) }
+    }
+}
+
+impl std::ops::Deref for HostMemory {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        self.as_bytes()
+    }
+}
+
+impl AsRef<[u8]> for HostMemory {
+    fn as_ref(&self) -> &[u8] {
+        self.as_bytes()
+    }
+}
+
+impl std::fmt::Debug for HostMemory {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("HostMemory")
+            .field("size", &self.size)
+            .finish()
+    }
+}
+
+impl Drop for HostMemory {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            unsafe {
+                trtx_host_memory_destroy(self.inner);
+            }
+        }
+    }
+}
+
+// The blob is immutable after creation
+unsafe impl Send for HostMemory {}
+unsafe impl Sync for HostMemory {}
+
 /// Network definition for building TensorRT engines
 pub struct NetworkDefinition {
     inner: *mut TrtxNetworkDefinition,
@@ -48,33 +242,425 @@ impl Drop for NetworkDefinition {
 
 unsafe impl Send for NetworkDefinition {}
 
+/// Range of input shapes an engine must support
+///
+/// Created with [`Builder::create_optimization_profile`] and added to a
+/// config with [`BuilderConfig::add_optimization_profile`]. The builder owns
+/// the underlying object, so the profile cannot outlive it.
+pub struct OptimizationProfile<'b> {
+    inner: *mut TrtxOptimizationProfile,
+    // Shapes set so far, keyed by input then selector, for config fingerprints
+    shapes: BTreeMap<String, BTreeMap<i32, Vec<i64>>>,
+    _builder: PhantomData<&'b ()>,
+}
+
+impl OptimizationProfile<'_> {
+    /// Set the min, opt or max shape of one input
+    pub fn set_dimensions(
+        &mut self,
+        input: &str,
+        selector: ProfileSelector,
+        shape: &[i64],
+    ) -> Result<()> {
+        let name_cstr = CString::new(input)?;
+        let dims = to_dims(shape)?;
+
+        let result = unsafe {
+            trtx_optimization_profile_set_dimensions(
+                self.inner,
+                name_cstr.as_ptr(),
+                selector as i32,
+                &dims,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.shapes
+            .entry(input.to_string())
+            .or_default()
+            .insert(selector as i32, shape.to_vec());
+        Ok(())
+    }
+
+    /// Set the whole min/opt/max range of one input
+    pub fn set_shape_range(
+        &mut self,
+        input: &str,
+        min: &[i64],
+        opt: &[i64],
+        max: &[i64],
+    ) -> Result<()> {
+        self.set_dimensions(input, ProfileSelector::Min, min)?;
+        self.set_dimensions(input, ProfileSelector::Opt, opt)?;
+        self.set_dimensions(input, ProfileSelector::Max, max)
+    }
+
+    fn fingerprint(&self) -> String {
+        format!("{:?}", self.shapes)
+    }
+}
+
+/// Tactic timings measured by the builder
+///
+/// Attaching a cache with [`BuilderConfig::set_timing_cache`] lets a build
+/// reuse timings instead of profiling every tactic again. Serialize it with
+/// [`TimingCache::serialize`] to keep it across processes; caches built by
+/// different jobs can be merged with [`TimingCache::combine`].
+pub struct TimingCache {
+    inner: *mut TrtxTimingCache,
+}
+
+impl TimingCache {
+    /// Serialize the cache, e.g. to write it to disk
+    pub fn serialize(&self) -> Result<HostMemory> {
+        serialize_timing_cache(self.inner)
+    }
+
+    /// Merge the entries of `other` into this cache
+    ///
+    /// With `ignore_mismatch`, entries recorded on a different device or
+    /// TensorRT-RTX version are merged instead of rejected.
+    pub fn combine(&mut self, other: &TimingCache, ignore_mismatch: bool) -> Result<()> {
+        let result = unsafe {
+            trtx_timing_cache_combine(
+                self.inner,
+                other.inner,
+                ignore_mismatch as i32,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+}
+
+impl Drop for TimingCache {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            unsafe {
+                trtx_timing_cache_destroy(self.inner);
+            }
+        }
+    }
+}
+
+unsafe impl Send for TimingCache {}
+
+fn serialize_timing_cache(cache: *const TrtxTimingCache) -> Result<HostMemory> {
+    let mut memory_ptr: *mut TrtxHostMemory = std::ptr::null_mut();
+
+    let result =
+        unsafe { trtx_timing_cache_serialize(cache, &mut memory_ptr, std::ptr::null_mut(), 0) };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(unsafe { HostMemory::from_raw(memory_ptr) })
+}
+
 /// Builder configuration
 pub struct BuilderConfig {
     inner: *mut TrtxBuilderConfig,
+    // Every setting applied through this wrapper, for cache fingerprints
+    settings: BTreeMap<String, String>,
+    // Kept alive for as long as the config may build with it
+    timing_cache: Option<TimingCache>,
 }
 
 impl BuilderConfig {
+    /// Canonical description of every setting applied to this config
+    ///
+    /// Two configs with the same fingerprint build interchangeable engines,
+    /// which is what keys the on-disk [`EngineCache`](crate::EngineCache).
+    pub fn settings_fingerprint(&self) -> String {
+        self.settings
+            .iter()
+            .map(|(key, value)| format!("{key}={value};"))
+            .collect()
+    }
+
+    fn record_setting(&mut self, key: String, value: impl ToString) {
+        self.settings.insert(key, value.to_string());
+    }
+
     /// Set memory pool limit
     pub fn set_memory_pool_limit(&mut self, pool: MemoryPoolType, size: usize) -> Result<()> {
-        let mut error_msg = [0i8; 1024];
-
         let result = unsafe {
             trtx_builder_config_set_memory_pool_limit(
                 self.inner,
                 pool as i32,
                 size,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
+        self.record_setting(format!("memory_pool_limit.{pool:?}"), size);
         Ok(())
     }
 
+    /// Enable or disable a builder flag
+    pub fn set_flag(&mut self, flag: BuilderFlag, enabled: bool) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_flag(
+                self.inner,
+                flag as i32,
+                enabled as i32,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting(format!("flag.{flag:?}"), enabled);
+        Ok(())
+    }
+
+    /// Check whether a builder flag is set
+    pub fn get_flag(&self, flag: BuilderFlag) -> bool {
+        unsafe { trtx_builder_config_get_flag(self.inner, flag as i32) != 0 }
+    }
+
+    /// Trade build time for engine speed
+    ///
+    /// Levels run from 0 (fastest build, fewest tactics) to 5 (slowest
+    /// build, most tactics); TensorRT-RTX defaults to 3.
+    pub fn set_builder_optimization_level(&mut self, level: i32) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_builder_optimization_level(
+                self.inner,
+                level,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("builder_optimization_level".to_string(), level);
+        Ok(())
+    }
+
+    /// Restrict the kernel libraries tactics may come from
+    ///
+    /// `sources` is a bitmask of [`tactic_sources`] values.
+    pub fn set_tactic_sources(&mut self, sources: u32) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_tactic_sources(self.inner, sources, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("tactic_sources".to_string(), sources);
+        Ok(())
+    }
+
+    /// Limit the auxiliary streams the engine may run layers on in parallel
+    ///
+    /// `0` keeps every layer on the enqueue stream, which uses the least
+    /// memory.
+    pub fn set_max_aux_streams(&mut self, nb_streams: i32) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_max_aux_streams(self.inner, nb_streams, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("max_aux_streams".to_string(), nb_streams);
+        Ok(())
+    }
+
+    /// Set how much layer detail the engine records
+    ///
+    /// [`ProfilingVerbosity::Detailed`] lets an
+    /// [`EngineInspector`](crate::profiler::EngineInspector) report the
+    /// tactic chosen for each layer.
+    pub fn set_profiling_verbosity(&mut self, verbosity: ProfilingVerbosity) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_profiling_verbosity(
+                self.inner,
+                verbosity as i32,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("profiling_verbosity".to_string(), verbosity as i32);
+        Ok(())
+    }
+
+    /// Choose which GPUs besides the build GPU the engine must run on
+    pub fn set_hardware_compatibility_level(
+        &mut self,
+        level: HardwareCompatibilityLevel,
+    ) -> Result<()> {
+        let result = unsafe {
+            trtx_builder_config_set_hardware_compatibility_level(
+                self.inner,
+                level as i32,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("hardware_compatibility_level".to_string(), level as i32);
+        Ok(())
+    }
+
+    /// Set the GPU architectures the engine is compiled for
+    ///
+    /// Targeting only [`ComputeCapability::Current`] gives the smallest plan
+    /// and the fastest build; listing several architectures produces one
+    /// plan that runs on all of them.
+    pub fn set_compute_capabilities(&mut self, capabilities: &[ComputeCapability]) -> Result<()> {
+        let raw = capabilities.iter().map(|&c| c as i32).collect::<Vec<_>>();
+        let count = i32::try_from(raw.len()).map_err(|_| {
+            Error::InvalidArgument(format!("Too many compute capabilities: {}", raw.len()))
+        })?;
+
+        let result = unsafe {
+            trtx_builder_config_set_compute_capabilities(
+                self.inner,
+                raw.as_ptr(),
+                count,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting("compute_capabilities".to_string(), format!("{raw:?}"));
+        Ok(())
+    }
+
+    /// Add an optimization profile, returning its index in the built engine
+    pub fn add_optimization_profile(&mut self, profile: &OptimizationProfile<'_>) -> Result<i32> {
+        let mut index = 0;
+
+        let result = unsafe {
+            trtx_builder_config_add_optimization_profile(
+                self.inner,
+                profile.inner,
+                &mut index,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.record_setting(
+            format!("optimization_profile.{index}"),
+            profile.fingerprint(),
+        );
+        Ok(index)
+    }
+
+    /// Create a timing cache from serialized bytes, or an empty one from `&[]`
+    ///
+    /// The cache is independent of this config and can be attached to any
+    /// config with [`BuilderConfig::set_timing_cache`].
+    pub fn create_timing_cache(&self, blob: &[u8]) -> Result<TimingCache> {
+        let mut cache_ptr: *mut TrtxTimingCache = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_builder_config_create_timing_cache(
+                self.inner,
+                blob.as_ptr() as *const std::ffi::c_void,
+                blob.len(),
+                &mut cache_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(TimingCache { inner: cache_ptr })
+    }
+
+    /// Attach a timing cache that builds with this config read and extend
+    ///
+    /// The config keeps the cache alive; any previously attached cache is
+    /// returned. With `ignore_mismatch`, a cache recorded on a different
+    /// device or TensorRT-RTX version is accepted.
+    pub fn set_timing_cache(
+        &mut self,
+        cache: TimingCache,
+        ignore_mismatch: bool,
+    ) -> Result<Option<TimingCache>> {
+        let result = unsafe {
+            trtx_builder_config_set_timing_cache(
+                self.inner,
+                cache.inner,
+                ignore_mismatch as i32,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(self.timing_cache.replace(cache))
+    }
+
+    /// Get the attached timing cache, if any
+    pub fn timing_cache(&self) -> Option<&TimingCache> {
+        self.timing_cache.as_ref()
+    }
+
+    /// Serialize the timing cache the config currently builds with
+    ///
+    /// Returns `None` if no cache is attached.
+    pub fn serialize_timing_cache(&self) -> Result<Option<HostMemory>> {
+        let cache = unsafe { trtx_builder_config_get_timing_cache(self.inner) };
+        if cache.is_null() {
+            return Ok(None);
+        }
+        serialize_timing_cache(cache).map(Some)
+    }
+
     /// Get the raw pointer (for internal use)
     pub(crate) fn as_ptr(&self) -> *mut TrtxBuilderConfig {
         self.inner
@@ -103,19 +689,13 @@ impl<'a> Builder<'a> {
     /// Create a new builder
     pub fn new(logger: &'a Logger) -> Result<Self> {
         let mut builder_ptr: *mut TrtxBuilder = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
-            trtx_builder_create(
-                logger.as_ptr(),
-                &mut builder_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
-            )
+            trtx_builder_create(logger.as_ptr(), &mut builder_ptr, std::ptr::null_mut(), 0)
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(Builder {
@@ -127,20 +707,19 @@ impl<'a> Builder<'a> {
     /// Create a network definition
     pub fn create_network(&self, flags: u32) -> Result<NetworkDefinition> {
         let mut network_ptr: *mut TrtxNetworkDefinition = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_builder_create_network(
                 self.inner,
                 flags,
                 &mut network_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(NetworkDefinition { inner: network_ptr })
@@ -149,59 +728,73 @@ impl<'a> Builder<'a> {
     /// Create a builder configuration
     pub fn create_config(&self) -> Result<BuilderConfig> {
         let mut config_ptr: *mut TrtxBuilderConfig = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
-            trtx_builder_create_builder_config(
+            trtx_builder_create_builder_config(self.inner, &mut config_ptr, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(BuilderConfig {
+            inner: config_ptr,
+            settings: BTreeMap::new(),
+            timing_cache: None,
+        })
+    }
+
+    /// Create an optimization profile for networks with dynamic input shapes
+    pub fn create_optimization_profile(&self) -> Result<OptimizationProfile<'_>> {
+        let mut profile_ptr: *mut TrtxOptimizationProfile = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_builder_create_optimization_profile(
                 self.inner,
-                &mut config_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                &mut profile_ptr,
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
-        Ok(BuilderConfig { inner: config_ptr })
+        Ok(OptimizationProfile {
+            inner: profile_ptr,
+            shapes: BTreeMap::new(),
+            _builder: PhantomData,
+        })
     }
 
     /// Build a serialized network (engine)
+    ///
+    /// The returned [`HostMemory`] is the buffer TensorRT serialized the
+    /// plan into; it can be written to disk or deserialized without copying.
     pub fn build_serialized_network(
         &self,
         network: &NetworkDefinition,
         config: &BuilderConfig,
-    ) -> Result<Vec<u8>> {
-        let mut data_ptr: *mut std::ffi::c_void = std::ptr::null_mut();
-        let mut size: usize = 0;
-        let mut error_msg = [0i8; 1024];
+    ) -> Result<HostMemory> {
+        let mut memory_ptr: *mut TrtxHostMemory = std::ptr::null_mut();
 
         let result = unsafe {
             trtx_builder_build_serialized_network(
                 self.inner,
                 network.as_ptr(),
                 config.as_ptr(),
-                &mut data_ptr,
-                &mut size,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                &mut memory_ptr,
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
-        // Copy data to Vec and free C buffer
-        let data = unsafe {
-            let slice = std::slice::from_raw_parts(data_ptr as *const u8, size);
-            let vec = slice.to_vec();
-            trtx_free_buffer(data_ptr);
-            vec
-        };
-
-        Ok(data)
+        Ok(unsafe { HostMemory::from_raw(memory_ptr) })
     }
 }
 
@@ -216,3 +809,106 @@ impl Drop for Builder<'_> {
 }
 
 unsafe impl Send for Builder<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_build_serialized_network_host_memory() {
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let network = builder
+            .create_network(network_flags::EXPLICIT_BATCH)
+            .unwrap();
+        let config = builder.create_config().unwrap();
+
+        let plan = builder.build_serialized_network(&network, &config).unwrap();
+
+        // Mock builder returns a 16-byte zeroed plan
+        #[cfg(feature = "mock")]
+        assert_eq!(&plan[..], &[0u8; 16]);
+        assert_eq!(plan.as_bytes().len(), plan.len());
+    }
+
+    #[test]
+    fn test_optimization_profile() {
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let mut config = builder.create_config().unwrap();
+        let before = config.settings_fingerprint();
+
+        let mut profile = builder.create_optimization_profile().unwrap();
+        profile
+            .set_shape_range(
+                "input",
+                &[1, 3, 224, 224],
+                &[4, 3, 224, 224],
+                &[8, 3, 224, 224],
+            )
+            .unwrap();
+        assert_eq!(config.add_optimization_profile(&profile).unwrap(), 0);
+        assert_ne!(config.settings_fingerprint(), before);
+    }
+
+    #[test]
+    fn test_builder_knobs() {
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let mut config = builder.create_config().unwrap();
+        let before = config.settings_fingerprint();
+
+        config.set_flag(BuilderFlag::Fp16, true).unwrap();
+        config.set_flag(BuilderFlag::SparseWeights, true).unwrap();
+        assert!(config.get_flag(BuilderFlag::Fp16));
+        config.set_flag(BuilderFlag::Fp16, false).unwrap();
+        assert!(!config.get_flag(BuilderFlag::Fp16));
+        assert!(config.get_flag(BuilderFlag::SparseWeights));
+
+        config.set_builder_optimization_level(5).unwrap();
+        assert!(config.set_builder_optimization_level(9).is_err());
+        config
+            .set_tactic_sources(tactic_sources::CUBLAS | tactic_sources::CUBLAS_LT)
+            .unwrap();
+        config.set_max_aux_streams(0).unwrap();
+        config
+            .set_profiling_verbosity(ProfilingVerbosity::Detailed)
+            .unwrap();
+        config
+            .set_hardware_compatibility_level(HardwareCompatibilityLevel::AmperePlus)
+            .unwrap();
+        config
+            .set_compute_capabilities(&[ComputeCapability::Sm86, ComputeCapability::Sm89])
+            .unwrap();
+
+        // Every knob feeds the engine cache key
+        let fingerprint = config.settings_fingerprint();
+        assert_ne!(fingerprint, before);
+        assert!(fingerprint.contains("builder_optimization_level=5;"));
+        assert!(fingerprint.contains("flag.Fp16=false;"));
+    }
+
+    #[test]
+    fn test_timing_cache_round_trip() {
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let network = builder
+            .create_network(network_flags::EXPLICIT_BATCH)
+            .unwrap();
+        let mut config = builder.create_config().unwrap();
+        assert!(config.serialize_timing_cache().unwrap().is_none());
+
+        let cache = config.create_timing_cache(&[]).unwrap();
+        assert!(config.set_timing_cache(cache, false).unwrap().is_none());
+        builder.build_serialized_network(&network, &config).unwrap();
+
+        // A cache restored from the serialized bytes matches the attached one
+        let blob = config.serialize_timing_cache().unwrap().unwrap();
+        let restored = config.create_timing_cache(&blob).unwrap();
+        assert_eq!(&restored.serialize().unwrap()[..], &blob[..]);
+
+        let mut merged = config.create_timing_cache(&[]).unwrap();
+        merged.combine(&restored, false).unwrap();
+        assert!(config.timing_cache().is_some());
+    }
+}
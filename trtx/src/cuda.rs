@@ -1,28 +1,627 @@
 //! CUDA memory management utilities
 
 use crate::error::{Error, Result};
+use crate::memory::DeviceAllocator;
+use std::future::Future;
+use std::marker::PhantomData;
+use std::pin::Pin;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex};
+use std::task::{Context, Poll, Waker};
 use trtx_sys::*;
 
-/// RAII wrapper for CUDA device memory
-pub struct DeviceBuffer {
+/// CUDA stream creation flags
+pub mod stream_flags {
+    /// Default stream behavior (synchronizes with the legacy default stream)
+    pub const DEFAULT: u32 = trtx_sys::TRTX_CUDA_STREAM_DEFAULT as u32;
+    /// Stream does not synchronize with the legacy default stream
+    pub const NON_BLOCKING: u32 = trtx_sys::TRTX_CUDA_STREAM_NON_BLOCKING as u32;
+}
+
+/// CUDA event creation flags
+pub mod event_flags {
+    /// Default event behavior (busy-waits in `synchronize`, records timing)
+    pub const DEFAULT: u32 = trtx_sys::TRTX_CUDA_EVENT_DEFAULT as u32;
+    /// `synchronize` blocks the thread instead of spinning
+    pub const BLOCKING_SYNC: u32 = trtx_sys::TRTX_CUDA_EVENT_BLOCKING_SYNC as u32;
+    /// No timing data; cheapest to record and query
+    pub const DISABLE_TIMING: u32 = trtx_sys::TRTX_CUDA_EVENT_DISABLE_TIMING as u32;
+}
+
+/// Pinned host allocation flags
+pub mod host_alloc_flags {
+    /// Page-locked memory usable from the current CUDA context
+    pub const DEFAULT: u32 = trtx_sys::TRTX_CUDA_HOST_ALLOC_DEFAULT as u32;
+    /// Page-locked memory usable from every CUDA context
+    pub const PORTABLE: u32 = trtx_sys::TRTX_CUDA_HOST_ALLOC_PORTABLE as u32;
+    /// Memory is also mapped into the device address space
+    pub const MAPPED: u32 = trtx_sys::TRTX_CUDA_HOST_ALLOC_MAPPED as u32;
+    /// Write-combined memory (fast H2D, very slow host reads)
+    pub const WRITE_COMBINED: u32 = trtx_sys::TRTX_CUDA_HOST_ALLOC_WRITE_COMBINED as u32;
+}
+
+/// Flags for pinning existing host allocations
+pub mod host_register_flags {
+    /// Page-locked memory usable from the current CUDA context
+    pub const DEFAULT: u32 = trtx_sys::TRTX_CUDA_HOST_REGISTER_DEFAULT as u32;
+    /// Page-locked memory usable from every CUDA context
+    pub const PORTABLE: u32 = trtx_sys::TRTX_CUDA_HOST_REGISTER_PORTABLE as u32;
+    /// Memory is also mapped into the device address space
+    pub const MAPPED: u32 = trtx_sys::TRTX_CUDA_HOST_REGISTER_MAPPED as u32;
+    /// The device only reads the memory
+    pub const READ_ONLY: u32 = trtx_sys::TRTX_CUDA_HOST_REGISTER_READ_ONLY as u32;
+}
+
+/// Plain-old-data element types that can be viewed as raw bytes
+///
+/// # Safety
+///
+/// Implementors must have no padding and must be valid for any bit pattern.
+pub unsafe trait Pod: Copy + Default + Send + Sync + 'static {}
+
+unsafe impl Pod for u8 {}
+unsafe impl Pod for i8 {}
+unsafe impl Pod for u16 {}
+unsafe impl Pod for i16 {}
+unsafe impl Pod for u32 {}
+unsafe impl Pod for i32 {}
+unsafe impl Pod for u64 {}
+unsafe impl Pod for i64 {}
+unsafe impl Pod for f32 {}
+unsafe impl Pod for f64 {}
+
+/// View a slice of [`Pod`] values as bytes
+pub(crate) fn as_bytes<T: Pod>(data: &[T]) -> &[u8] {
+    unsafe { std::slice::from_raw_parts(data.as_ptr() as *const u8, std::mem::size_of_val(data)) }
+}
+
+/// View bytes as a slice of [`Pod`] values, ignoring any trailing partial element
+///
+/// Panics if `bytes` is not suitably aligned for `T`.
+pub(crate) fn cast_slice<T: Pod>(bytes: &[u8]) -> &[T] {
+    let len = bytes.len() / std::mem::size_of::<T>();
+    if len == 0 {
+        return &[];
+    }
+    assert_eq!(
+        bytes.as_ptr() as usize % std::mem::align_of::<T>(),
+        0,
+        "misaligned host buffer"
+    );
+    unsafe { std::slice::from_raw_parts(bytes.as_ptr() as *const T, len) }
+}
+
+/// Mutable variant of [`cast_slice`]
+pub(crate) fn cast_slice_mut<T: Pod>(bytes: &mut [u8]) -> &mut [T] {
+    let len = bytes.len() / std::mem::size_of::<T>();
+    if len == 0 {
+        return &mut [];
+    }
+    assert_eq!(
+        bytes.as_ptr() as usize % std::mem::align_of::<T>(),
+        0,
+        "misaligned host buffer"
+    );
+    unsafe { std::slice::from_raw_parts_mut(bytes.as_mut_ptr() as *mut T, len) }
+}
+
+/// RAII wrapper for page-locked (pinned) host memory
+///
+/// Copies between pinned memory and the device use DMA directly and can run
+/// asynchronously, unlike copies from pageable memory which the driver stages.
+pub struct PinnedHostBuffer {
     ptr: *mut std::ffi::c_void,
     size: usize,
+    // Set when the buffer pins an existing allocation instead of owning one
+    registered: Option<Vec<u8>>,
 }
 
-impl DeviceBuffer {
-    /// Allocate CUDA device memory
+impl PinnedHostBuffer {
+    /// Allocate pinned host memory
     pub fn new(size: usize) -> Result<Self> {
+        Self::with_flags(size, host_alloc_flags::DEFAULT)
+    }
+
+    /// Allocate pinned host memory with explicit `host_alloc_flags`
+    pub fn with_flags(size: usize, flags: u32) -> Result<Self> {
         let mut ptr: *mut std::ffi::c_void = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
+
+        if size > 0 {
+            let result =
+                unsafe { trtx_cuda_host_alloc(&mut ptr, size, flags, std::ptr::null_mut(), 0) };
+
+            if result != TRTX_SUCCESS as i32 {
+                return Err(Error::last_ffi(result));
+            }
+        }
+
+        Ok(PinnedHostBuffer {
+            ptr,
+            size,
+            registered: None,
+        })
+    }
+
+    /// Allocate pinned host memory that kernels can also read and write in place
+    ///
+    /// On integrated GPUs and laptops sharing memory with the GPU, binding
+    /// [`PinnedHostBuffer::device_ptr`] directly avoids any copy at all.
+    pub fn mapped(size: usize) -> Result<Self> {
+        Self::with_flags(size, host_alloc_flags::MAPPED)
+    }
+
+    /// Pin an existing host allocation in place
+    ///
+    /// The vector is unpinned and released when the buffer is dropped.
+    pub fn register(data: Vec<u8>) -> Result<Self> {
+        Self::register_with_flags(data, host_register_flags::DEFAULT)
+    }
+
+    /// Pin an existing host allocation with explicit `host_register_flags`
+    pub fn register_with_flags(mut data: Vec<u8>, flags: u32) -> Result<Self> {
+        let size = data.len();
+        // An empty vector is not registered, and a null pointer keeps Drop from unregistering it
+        let ptr = if size == 0 {
+            std::ptr::null_mut()
+        } else {
+            let ptr = data.as_mut_ptr() as *mut std::ffi::c_void;
+            let result =
+                unsafe { trtx_cuda_host_register(ptr, size, flags, std::ptr::null_mut(), 0) };
+
+            if result != TRTX_SUCCESS as i32 {
+                return Err(Error::last_ffi(result));
+            }
+            ptr
+        };
+
+        Ok(PinnedHostBuffer {
+            ptr,
+            size,
+            registered: Some(data),
+        })
+    }
+
+    /// Get the raw host pointer
+    pub fn as_ptr(&self) -> *mut std::ffi::c_void {
+        self.ptr
+    }
+
+    /// Get the size in bytes
+    pub fn size(&self) -> usize {
+        self.size
+    }
+
+    /// Get the device address of the buffer
+    ///
+    /// Only valid for memory allocated or registered with the `MAPPED` flag;
+    /// other buffers return an error.
+    pub fn device_ptr(&self) -> Result<*mut std::ffi::c_void> {
+        if self.ptr.is_null() {
+            return Ok(std::ptr::null_mut());
+        }
+
+        let mut device_ptr: *mut std::ffi::c_void = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_host_get_device_pointer(self.ptr, &mut device_ptr, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(device_ptr)
+    }
+
+    /// View the buffer as bytes
+    pub fn as_slice(&self) -> &[u8] {
+        if self.ptr.is_null() {
+            return &[];
+        }
+        unsafe { std::slice::from_raw_parts(self.ptr as *const u8, self.size) }
+    }
+
+    /// View the buffer as mutable bytes
+    pub fn as_mut_slice(&mut self) -> &mut [u8] {
+        if self.ptr.is_null() {
+            return &mut [];
+        }
+        unsafe { std::slice::from_raw_parts_mut(self.ptr as *mut u8, self.size) }
+    }
+
+    /// View the buffer as typed elements
+    pub fn as_slice_of<T: Pod>(&self) -> &[T] {
+        cast_slice(self.as_slice())
+    }
+
+    /// View the buffer as mutable typed elements
+    pub fn as_mut_slice_of<T: Pod>(&mut self) -> &mut [T] {
+        cast_slice_mut(self.as_mut_slice())
+    }
+}
+
+impl Drop for PinnedHostBuffer {
+    fn drop(&mut self) {
+        if self.ptr.is_null() {
+            return;
+        }
+
+        unsafe {
+            if self.registered.is_some() {
+                let _ = trtx_cuda_host_unregister(self.ptr, std::ptr::null_mut(), 0);
+            } else {
+                let _ = trtx_cuda_free_host(self.ptr, std::ptr::null_mut(), 0);
+            }
+        }
+    }
+}
+
+unsafe impl Send for PinnedHostBuffer {}
+unsafe impl Sync for PinnedHostBuffer {}
+
+/// RAII wrapper for a CUDA stream
+///
+/// Work queued on different streams may overlap, so copies for one request can
+/// run while another request's kernels execute. A stream belongs to the
+/// device that was current when it was created.
+pub struct CudaStream {
+    inner: *mut TrtxCudaStream,
+    device: i32,
+}
+
+impl CudaStream {
+    /// Create a non-blocking stream with default priority
+    pub fn new() -> Result<Self> {
+        Self::with_options(stream_flags::NON_BLOCKING, 0)
+    }
+
+    /// Create a non-blocking stream with default priority on `device`
+    pub fn on_device(device: i32) -> Result<Self> {
+        let _device = DeviceGuard::new(device)?;
+        Self::new()
+    }
+
+    /// Create a stream with explicit flags and priority
+    ///
+    /// Lower numbers are higher priority; see [`CudaStream::priority_range`].
+    pub fn with_options(flags: u32, priority: i32) -> Result<Self> {
+        // Queried first, so a failure cannot leak the stream
+        let device = current_device()?;
+        let mut stream_ptr: *mut TrtxCudaStream = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_stream_create(flags, priority, &mut stream_ptr, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(CudaStream {
+            inner: stream_ptr,
+            device,
+        })
+    }
+
+    /// Get the device this stream belongs to
+    pub fn device(&self) -> i32 {
+        self.device
+    }
+
+    /// Get the (least, greatest) stream priority supported by the device
+    pub fn priority_range() -> Result<(i32, i32)> {
+        let mut least: i32 = 0;
+        let mut greatest: i32 = 0;
+
+        let result = unsafe {
+            trtx_cuda_get_stream_priority_range(&mut least, &mut greatest, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok((least, greatest))
+    }
+
+    /// Block until all work queued on this stream has completed
+    pub fn synchronize(&self) -> Result<()> {
+        let result = unsafe { trtx_cuda_stream_synchronize(self.inner, std::ptr::null_mut(), 0) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Make work queued after this call wait for `event`, without blocking the host
+    pub fn wait_event(&self, event: &CudaEvent) -> Result<()> {
+        let result = unsafe {
+            trtx_cuda_stream_wait_event(self.inner, event.inner, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get a future that resolves once all work queued so far has finished
+    ///
+    /// Completion is signalled by a host function queued on the stream
+    /// (`cudaLaunchHostFunc`), so no thread blocks or polls while waiting.
+    pub fn completion(&self) -> Result<StreamCompletion> {
+        let state = Arc::new(CompletionState {
+            done: AtomicBool::new(false),
+            waker: Mutex::new(None),
+        });
+        let user_data = Arc::into_raw(Arc::clone(&state)) as *mut std::ffi::c_void;
+
+        let result = unsafe {
+            trtx_cuda_launch_host_func(
+                self.inner,
+                Some(on_stream_complete),
+                user_data,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            // The callback will never run, so reclaim its reference here
+            drop(unsafe { Arc::from_raw(user_data as *const CompletionState) });
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(StreamCompletion { state })
+    }
+
+    /// Get the raw stream handle (a `cudaStream_t`)
+    pub fn as_ptr(&self) -> *mut std::ffi::c_void {
+        self.inner as *mut std::ffi::c_void
+    }
+
+    /// Get the raw stream handle (for internal use)
+    pub(crate) fn as_raw(&self) -> *mut TrtxCudaStream {
+        self.inner
+    }
+}
+
+impl Drop for CudaStream {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            let _device = DeviceGuard::new(self.device);
+            unsafe {
+                trtx_cuda_stream_destroy(self.inner);
+            }
+        }
+    }
+}
+
+unsafe impl Send for CudaStream {}
+unsafe impl Sync for CudaStream {}
+
+struct CompletionState {
+    done: AtomicBool,
+    waker: Mutex<Option<Waker>>,
+}
+
+/// Host function queued by [`CudaStream::completion`]; runs on a CUDA driver thread
+unsafe extern "C" fn on_stream_complete(user_data: *mut std::ffi::c_void) {
+    let state = Arc::from_raw(user_data as *const CompletionState);
+    state.done.store(true, Ordering::Release);
+    let waker = state.waker.lock().unwrap().take();
+    if let Some(waker) = waker {
+        waker.wake();
+    }
+}
+
+/// Future returned by [`CudaStream::completion`]
+///
+/// Resolves once the stream has reached the point where it was created.
+/// It does not report errors from the queued work; synchronize the stream
+/// afterwards (which returns immediately) to check for them.
+pub struct StreamCompletion {
+    state: Arc<CompletionState>,
+}
+
+impl StreamCompletion {
+    /// Whether the stream has reached this point yet
+    pub fn is_complete(&self) -> bool {
+        self.state.done.load(Ordering::Acquire)
+    }
+}
+
+impl Future for StreamCompletion {
+    type Output = ();
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+        if self.is_complete() {
+            return Poll::Ready(());
+        }
+        *self.state.waker.lock().unwrap() = Some(cx.waker().clone());
+        // The callback may have run between the check and storing the waker
+        if self.is_complete() {
+            return Poll::Ready(());
+        }
+        Poll::Pending
+    }
+}
+
+/// RAII wrapper for a CUDA event
+///
+/// Events mark a point in a stream. Querying one is a cheap, non-blocking
+/// way to see whether the work before it has finished, and unlike
+/// [`synchronize`] it does not wait for other streams.
+pub struct CudaEvent {
+    inner: *mut TrtxCudaEvent,
+}
+
+impl CudaEvent {
+    /// Create an event without timing data, the cheapest kind to record
+    pub fn new() -> Result<Self> {
+        Self::with_flags(event_flags::DISABLE_TIMING)
+    }
+
+    /// Create an event with explicit [`event_flags`]
+    pub fn with_flags(flags: u32) -> Result<Self> {
+        let mut event_ptr: *mut TrtxCudaEvent = std::ptr::null_mut();
 
         let result =
-            unsafe { trtx_cuda_malloc(&mut ptr, size, error_msg.as_mut_ptr(), error_msg.len()) };
+            unsafe { trtx_cuda_event_create(flags, &mut event_ptr, std::ptr::null_mut(), 0) };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
-        Ok(DeviceBuffer { ptr, size })
+        Ok(CudaEvent { inner: event_ptr })
+    }
+
+    /// Capture the work queued on `stream` so far
+    pub fn record(&self, stream: &CudaStream) -> Result<()> {
+        let result =
+            unsafe { trtx_cuda_event_record(self.inner, stream.inner, std::ptr::null_mut(), 0) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Check without blocking whether the recorded work has finished
+    pub fn query(&self) -> Result<bool> {
+        let mut complete: i32 = 0;
+
+        let result =
+            unsafe { trtx_cuda_event_query(self.inner, &mut complete, std::ptr::null_mut(), 0) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(complete != 0)
+    }
+
+    /// Block until the recorded work has finished
+    pub fn synchronize(&self) -> Result<()> {
+        let result = unsafe { trtx_cuda_event_synchronize(self.inner, std::ptr::null_mut(), 0) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get the milliseconds between `start` and this event
+    ///
+    /// Both events must have completed and been created with timing enabled.
+    pub fn elapsed_ms_since(&self, start: &CudaEvent) -> Result<f32> {
+        let mut ms: f32 = 0.0;
+
+        let result = unsafe {
+            trtx_cuda_event_elapsed_time(start.inner, self.inner, &mut ms, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(ms)
+    }
+}
+
+impl Drop for CudaEvent {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            unsafe {
+                trtx_cuda_event_destroy(self.inner);
+            }
+        }
+    }
+}
+
+unsafe impl Send for CudaEvent {}
+unsafe impl Sync for CudaEvent {}
+
+/// Allocate device memory directly with `cudaMalloc`
+pub(crate) fn device_malloc(size: usize) -> Result<*mut std::ffi::c_void> {
+    let mut ptr: *mut std::ffi::c_void = std::ptr::null_mut();
+
+    let result = unsafe { trtx_cuda_malloc(&mut ptr, size, std::ptr::null_mut(), 0) };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(ptr)
+}
+
+/// Release device memory obtained from [`device_malloc`]
+pub(crate) fn device_free(ptr: *mut std::ffi::c_void) {
+    if !ptr.is_null() {
+        unsafe {
+            let _ = trtx_cuda_free(ptr, std::ptr::null_mut(), 0);
+        }
+    }
+}
+
+/// RAII wrapper for CUDA device memory
+///
+/// Buffers either own a raw `cudaMalloc` allocation or borrow one from a
+/// [`DeviceAllocator`] that gets it back on drop. Memory lives on the device
+/// that was current at allocation, which is made current again to free it.
+pub struct DeviceBuffer {
+    ptr: *mut std::ffi::c_void,
+    size: usize,
+    device: i32,
+    allocator: Option<Arc<dyn DeviceAllocator>>,
+}
+
+impl DeviceBuffer {
+    /// Allocate CUDA device memory
+    pub fn new(size: usize) -> Result<Self> {
+        let device = current_device()?;
+        let ptr = device_malloc(size)?;
+
+        Ok(DeviceBuffer {
+            ptr,
+            size,
+            device,
+            allocator: None,
+        })
+    }
+
+    /// Allocate CUDA device memory on `device`
+    pub fn new_on(device: i32, size: usize) -> Result<Self> {
+        let _device = DeviceGuard::new(device)?;
+        Self::new(size)
+    }
+
+    /// Allocate device memory from `allocator`
+    pub fn new_in(size: usize, allocator: &Arc<dyn DeviceAllocator>) -> Result<Self> {
+        let device = current_device()?;
+        let ptr = allocator.allocate(size)?;
+
+        Ok(DeviceBuffer {
+            ptr,
+            size,
+            device,
+            allocator: Some(Arc::clone(allocator)),
+        })
+    }
+
+    /// Get the device the memory lives on
+    pub fn device(&self) -> i32 {
+        self.device
+    }
+
+    /// Get the allocator backing this buffer, if any
+    pub fn allocator(&self) -> Option<&Arc<dyn DeviceAllocator>> {
+        self.allocator.as_ref()
     }
 
     /// Get the raw device pointer
@@ -43,20 +642,18 @@ impl DeviceBuffer {
             ));
         }
 
-        let mut error_msg = [0i8; 1024];
-
         let result = unsafe {
             trtx_cuda_memcpy_host_to_device(
                 self.ptr,
                 data.as_ptr() as *const std::ffi::c_void,
                 data.len(),
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(())
@@ -70,20 +667,75 @@ impl DeviceBuffer {
             ));
         }
 
-        let mut error_msg = [0i8; 1024];
-
         let result = unsafe {
             trtx_cuda_memcpy_device_to_host(
                 data.as_mut_ptr() as *mut std::ffi::c_void,
                 self.ptr,
                 data.len(),
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Queue a host to device copy on `stream`
+    ///
+    /// # Safety
+    ///
+    /// `data` must stay alive and unmodified until `stream` has been synchronized.
+    /// For the copy to actually overlap with other work, `data` should be pinned.
+    pub unsafe fn copy_from_host_async(&mut self, data: &[u8], stream: &CudaStream) -> Result<()> {
+        if data.len() > self.size {
+            return Err(Error::InvalidArgument(
+                "Data size exceeds buffer size".to_string(),
+            ));
+        }
+
+        let result = trtx_cuda_memcpy_host_to_device_async(
+            self.ptr,
+            data.as_ptr() as *const std::ffi::c_void,
+            data.len(),
+            stream.as_raw(),
+            std::ptr::null_mut(),
+            0,
+        );
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Queue a device to host copy on `stream`
+    ///
+    /// # Safety
+    ///
+    /// `data` must stay alive and must not be read until `stream` has been synchronized.
+    pub unsafe fn copy_to_host_async(&self, data: &mut [u8], stream: &CudaStream) -> Result<()> {
+        if data.len() > self.size {
+            return Err(Error::InvalidArgument(
+                "Data size exceeds buffer size".to_string(),
+            ));
+        }
+
+        let result = trtx_cuda_memcpy_device_to_host_async(
+            data.as_mut_ptr() as *mut std::ffi::c_void,
+            self.ptr,
+            data.len(),
+            stream.as_raw(),
+            std::ptr::null_mut(),
+            0,
+        );
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
         }
 
         Ok(())
@@ -92,11 +744,14 @@ impl DeviceBuffer {
 
 impl Drop for DeviceBuffer {
     fn drop(&mut self) {
-        if !self.ptr.is_null() {
-            let mut error_msg = [0i8; 1024];
-            unsafe {
-                let _ = trtx_cuda_free(self.ptr, error_msg.as_mut_ptr(), error_msg.len());
-            }
+        if self.ptr.is_null() {
+            return;
+        }
+
+        let _device = DeviceGuard::new(self.device);
+        match self.allocator.take() {
+            Some(allocator) => unsafe { allocator.deallocate(self.ptr, self.size) },
+            None => device_free(self.ptr),
         }
     }
 }
@@ -104,18 +759,129 @@ impl Drop for DeviceBuffer {
 unsafe impl Send for DeviceBuffer {}
 
 /// Synchronize CUDA device
+///
+/// This waits for every stream on the device; prefer [`CudaStream::synchronize`].
 pub fn synchronize() -> Result<()> {
-    let mut error_msg = [0i8; 1024];
+    let result = unsafe { trtx_cuda_synchronize(std::ptr::null_mut(), 0) };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(())
+}
+
+/// Get the number of visible CUDA devices
+pub fn device_count() -> Result<usize> {
+    let mut count = 0;
+
+    let result = unsafe { trtx_cuda_get_device_count(&mut count, std::ptr::null_mut(), 0) };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(count.max(0) as usize)
+}
+
+/// Get the device current on the calling thread
+pub fn current_device() -> Result<i32> {
+    let mut device = 0;
 
-    let result = unsafe { trtx_cuda_synchronize(error_msg.as_mut_ptr(), error_msg.len()) };
+    let result = unsafe { trtx_cuda_get_device(&mut device, std::ptr::null_mut(), 0) };
 
     if result != TRTX_SUCCESS as i32 {
-        return Err(Error::from_ffi(result, &error_msg));
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(device)
+}
+
+/// Make `device` current on the calling thread
+///
+/// Engines, contexts, streams and buffers are created on the current
+/// device; prefer a scoped [`DeviceGuard`].
+pub fn set_device(device: i32) -> Result<()> {
+    let result = unsafe { trtx_cuda_set_device(device, std::ptr::null_mut(), 0) };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
     }
 
     Ok(())
 }
 
+/// Makes a device current on this thread until dropped
+///
+/// The previously current device is restored on drop. The guard is tied to
+/// its thread, since the current device is thread-local state.
+pub struct DeviceGuard {
+    // Device to restore, or None if the requested one was already current
+    previous: Option<i32>,
+    _thread: PhantomData<*const ()>,
+}
+
+impl DeviceGuard {
+    /// Make `device` current, remembering the device to restore
+    pub fn new(device: i32) -> Result<Self> {
+        let current = current_device()?;
+        let previous = if current == device {
+            None
+        } else {
+            set_device(device)?;
+            Some(current)
+        };
+
+        Ok(DeviceGuard {
+            previous,
+            _thread: PhantomData,
+        })
+    }
+}
+
+impl Drop for DeviceGuard {
+    fn drop(&mut self) {
+        if let Some(previous) = self.previous {
+            let _ = set_device(previous);
+        }
+    }
+}
+
+/// Properties that identify the GPU an engine plan was built for
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct DeviceIdentity {
+    /// Compute capability as (major, minor)
+    pub compute_capability: (i32, i32),
+    /// Device UUID as reported by the driver
+    pub uuid: [u8; 16],
+}
+
+/// Get the identity of the current CUDA device
+pub fn current_device_identity() -> Result<DeviceIdentity> {
+    let mut major = 0;
+    let mut minor = 0;
+    let mut uuid = [0u8; 16];
+
+    let result = unsafe {
+        trtx_cuda_get_device_identity(
+            &mut major,
+            &mut minor,
+            uuid.as_mut_ptr(),
+            std::ptr::null_mut(),
+            0,
+        )
+    };
+
+    if result != TRTX_SUCCESS as i32 {
+        return Err(Error::last_ffi(result));
+    }
+
+    Ok(DeviceIdentity {
+        compute_capability: (major, minor),
+        uuid,
+    })
+}
+
 /// Get the default CUDA stream
 pub fn get_default_stream() -> *mut std::ffi::c_void {
     unsafe { trtx_cuda_get_default_stream() }
@@ -134,6 +900,27 @@ mod tests {
         assert_eq!(buffer.size(), 1024);
     }
 
+    #[test]
+    fn test_device_guard_restores_device() {
+        if device_count().unwrap() < 2 {
+            return;
+        }
+        assert_eq!(current_device().unwrap(), 0);
+        {
+            let _guard = DeviceGuard::new(1).unwrap();
+            assert_eq!(current_device().unwrap(), 1);
+
+            let stream = CudaStream::new().unwrap();
+            assert_eq!(stream.device(), 1);
+        }
+        assert_eq!(current_device().unwrap(), 0);
+
+        let buffer = DeviceBuffer::new_on(1, 64).unwrap();
+        assert_eq!(buffer.device(), 1);
+        assert_eq!(current_device().unwrap(), 0);
+        assert!(DeviceGuard::new(7).is_err());
+    }
+
     #[test]
     fn test_device_buffer_copy() {
         let mut buffer = DeviceBuffer::new(256).unwrap();
@@ -147,6 +934,64 @@ mod tests {
         assert_eq!(host_data, output);
     }
 
+    #[test]
+    fn test_stream_async_copy() {
+        let stream = CudaStream::new().unwrap();
+        let mut buffer = DeviceBuffer::new(64).unwrap();
+
+        let host_data = vec![7u8; 64];
+        let mut output = vec![0u8; 64];
+        unsafe {
+            buffer.copy_from_host_async(&host_data, &stream).unwrap();
+            buffer.copy_to_host_async(&mut output, &stream).unwrap();
+        }
+        stream.synchronize().unwrap();
+
+        assert_eq!(host_data, output);
+        assert!(CudaStream::priority_range().is_ok());
+    }
+
+    #[test]
+    fn test_events_and_completion() {
+        let stream = CudaStream::new().unwrap();
+        let other = CudaStream::new().unwrap();
+        let event = CudaEvent::new().unwrap();
+
+        event.record(&stream).unwrap();
+        other.wait_event(&event).unwrap();
+        event.synchronize().unwrap();
+        assert!(event.query().unwrap());
+
+        let start = CudaEvent::with_flags(event_flags::DEFAULT).unwrap();
+        let end = CudaEvent::with_flags(event_flags::DEFAULT).unwrap();
+        start.record(&stream).unwrap();
+        end.record(&stream).unwrap();
+        end.synchronize().unwrap();
+        assert!(end.elapsed_ms_since(&start).unwrap() >= 0.0);
+
+        let completion = stream.completion().unwrap();
+        stream.synchronize().unwrap();
+        assert!(completion.is_complete());
+    }
+
+    #[test]
+    fn test_pinned_host_buffer() {
+        let mut pinned = PinnedHostBuffer::new(16).unwrap();
+        pinned
+            .as_mut_slice_of::<f32>()
+            .copy_from_slice(&[1.0, 2.0, 3.0, 4.0]);
+        assert_eq!(pinned.as_slice_of::<f32>(), &[1.0, 2.0, 3.0, 4.0]);
+
+        let registered = PinnedHostBuffer::register(vec![5u8; 32]).unwrap();
+        assert_eq!(registered.size(), 32);
+        assert!(registered.as_slice().iter().all(|&b| b == 5));
+
+        // Nothing to pin, so nothing to unpin on drop
+        let empty = PinnedHostBuffer::register(Vec::new()).unwrap();
+        assert!(empty.as_ptr().is_null());
+        assert!(empty.as_slice().is_empty());
+    }
+
     #[test]
     fn test_synchronize() {
         assert!(synchronize().is_ok());
@@ -0,0 +1,603 @@
+//! Typed host tensor data
+//!
+//! [`TensorData`] holds the values of one tensor in the element type the
+//! engine uses for it, so fp16 activations or int64 token IDs cross PCIe at
+//! their native width. When the caller's type differs from the engine's,
+//! floating-point data is converted with the vectorized routines in this
+//! module (F16C on x86-64, auto-vectorized bit manipulation elsewhere)
+//! straight into the staging buffer.
+
+use crate::cuda::{as_bytes, cast_slice, cast_slice_mut, Pod};
+use crate::error::{Error, Result};
+use crate::tensor::DataType;
+
+/// Values of one tensor in a concrete element type
+#[derive(Debug, Clone, PartialEq)]
+pub enum TensorData {
+    /// 32-bit floats
+    Float(Vec<f32>),
+    /// IEEE 754 half-precision values, as raw bits
+    Half(Vec<u16>),
+    /// bfloat16 values, as raw bits
+    Bf16(Vec<u16>),
+    /// Signed 8-bit integers
+    Int8(Vec<i8>),
+    /// Unsigned 8-bit integers
+    Uint8(Vec<u8>),
+    /// Booleans, one byte each (0 or 1)
+    Bool(Vec<u8>),
+    /// Signed 32-bit integers
+    Int32(Vec<i32>),
+    /// Signed 64-bit integers
+    Int64(Vec<i64>),
+}
+
+/// Apply `$body` to the vector inside any variant
+macro_rules! with_values {
+    ($data:expr, $values:ident => $body:expr) => {
+        match $data {
+            TensorData::Float($values) => $body,
+            TensorData::Half($values) => $body,
+            TensorData::Bf16($values) => $body,
+            TensorData::Int8($values) => $body,
+            TensorData::Uint8($values) => $body,
+            TensorData::Bool($values) => $body,
+            TensorData::Int32($values) => $body,
+            TensorData::Int64($values) => $body,
+        }
+    };
+}
+
+impl TensorData {
+    /// Create `len` zero values of `data_type`
+    ///
+    /// Sub-byte and 8-bit float types have no host representation here; bind
+    /// them through [`TensorView`](crate::TensorView) instead.
+    pub fn zeroed(data_type: DataType, len: usize) -> Result<Self> {
+        check_host_type(data_type)?;
+        Ok(match data_type {
+            DataType::Float => TensorData::Float(vec![0.0; len]),
+            DataType::Half => TensorData::Half(vec![0; len]),
+            DataType::Bf16 => TensorData::Bf16(vec![0; len]),
+            DataType::Int8 => TensorData::Int8(vec![0; len]),
+            DataType::Uint8 => TensorData::Uint8(vec![0; len]),
+            DataType::Bool => TensorData::Bool(vec![0; len]),
+            DataType::Int32 => TensorData::Int32(vec![0; len]),
+            DataType::Int64 => TensorData::Int64(vec![0; len]),
+            DataType::Fp8 | DataType::Int4 | DataType::Fp4 | DataType::E8m0 => {
+                unreachable!("checked above")
+            }
+        })
+    }
+
+    /// Get the element type
+    pub fn data_type(&self) -> DataType {
+        match self {
+            TensorData::Float(_) => DataType::Float,
+            TensorData::Half(_) => DataType::Half,
+            TensorData::Bf16(_) => DataType::Bf16,
+            TensorData::Int8(_) => DataType::Int8,
+            TensorData::Uint8(_) => DataType::Uint8,
+            TensorData::Bool(_) => DataType::Bool,
+            TensorData::Int32(_) => DataType::Int32,
+            TensorData::Int64(_) => DataType::Int64,
+        }
+    }
+
+    /// Get the number of elements
+    pub fn len(&self) -> usize {
+        with_values!(self, values => values.len())
+    }
+
+    /// Whether there are no elements
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// View the values as raw bytes in the engine's layout
+    pub fn as_bytes(&self) -> &[u8] {
+        with_values!(self, values => as_bytes(values))
+    }
+
+    /// View the values as `f32`, if that is their type
+    pub fn as_f32(&self) -> Option<&[f32]> {
+        match self {
+            TensorData::Float(values) => Some(values),
+            _ => None,
+        }
+    }
+
+    /// View the values as `i64`, if that is their type
+    pub fn as_i64(&self) -> Option<&[i64]> {
+        match self {
+            TensorData::Int64(values) => Some(values),
+            _ => None,
+        }
+    }
+
+    /// View the values as `i32`, if that is their type
+    pub fn as_i32(&self) -> Option<&[i32]> {
+        match self {
+            TensorData::Int32(values) => Some(values),
+            _ => None,
+        }
+    }
+
+    /// Convert the values to `data_type`
+    ///
+    /// Floating-point types convert among each other; anything else only
+    /// converts to itself.
+    pub fn to_type(&self, data_type: DataType) -> Result<TensorData> {
+        if data_type == self.data_type() {
+            return Ok(self.clone());
+        }
+        let mut converted = TensorData::zeroed(data_type, self.len())?;
+        let len = converted.len();
+        let bytes = with_values!(&mut converted, values => as_bytes_mut(values));
+        convert_into(self, data_type, &mut bytes[..], len)?;
+        Ok(converted)
+    }
+
+    /// Convert to `f32` values, the common case for reading results
+    pub fn to_f32(&self) -> Result<Vec<f32>> {
+        match self.to_type(DataType::Float)? {
+            TensorData::Float(values) => Ok(values),
+            _ => unreachable!("converted to Float"),
+        }
+    }
+
+    /// Concatenate same-typed tensors along their flattened values
+    pub(crate) fn concat<'a>(parts: impl IntoIterator<Item = &'a TensorData>) -> Result<Self> {
+        let mut parts = parts.into_iter();
+        let mut merged = parts
+            .next()
+            .cloned()
+            .ok_or_else(|| Error::InvalidArgument("Nothing to concatenate".to_string()))?;
+        for part in parts {
+            merged.extend_from(part)?;
+        }
+        Ok(merged)
+    }
+
+    fn extend_from(&mut self, other: &TensorData) -> Result<()> {
+        macro_rules! extend {
+            ($($variant:ident),*) => {
+                match (self, other) {
+                    $((TensorData::$variant(a), TensorData::$variant(b)) => a.extend_from_slice(b),)*
+                    (a, b) => {
+                        return Err(Error::InvalidArgument(format!(
+                            "Cannot concatenate {:?} and {:?} tensors",
+                            a.data_type(),
+                            b.data_type()
+                        )))
+                    }
+                }
+            };
+        }
+        extend!(Float, Half, Bf16, Int8, Uint8, Bool, Int32, Int64);
+        Ok(())
+    }
+
+    /// Copy out the elements in `range`
+    pub(crate) fn slice(&self, range: std::ops::Range<usize>) -> TensorData {
+        macro_rules! slice {
+            ($($variant:ident),*) => {
+                match self {
+                    $(TensorData::$variant(values) => TensorData::$variant(values[range].to_vec()),)*
+                }
+            };
+        }
+        slice!(Float, Half, Bf16, Int8, Uint8, Bool, Int32, Int64)
+    }
+
+    /// Replace the contents with `len` elements of `data_type` read from `bytes`
+    ///
+    /// Keeps the existing allocation when the type is unchanged.
+    pub(crate) fn assign_from_bytes(
+        &mut self,
+        data_type: DataType,
+        bytes: &[u8],
+        len: usize,
+    ) -> Result<()> {
+        fn assign<T: Pod>(values: &mut Vec<T>, bytes: &[u8], len: usize) {
+            values.clear();
+            values.extend_from_slice(&cast_slice::<T>(bytes)[..len]);
+        }
+
+        if self.data_type() != data_type {
+            *self = TensorData::zeroed(data_type, 0)?;
+        }
+        with_values!(self, values => assign(values, bytes, len));
+        Ok(())
+    }
+}
+
+fn as_bytes_mut<T: Pod>(values: &mut [T]) -> &mut [u8] {
+    let len = std::mem::size_of_val(values);
+    unsafe { std::slice::from_raw_parts_mut(values.as_mut_ptr() as *mut u8, len) }
+}
+
+impl From<Vec<f32>> for TensorData {
+    fn from(values: Vec<f32>) -> Self {
+        TensorData::Float(values)
+    }
+}
+
+impl From<Vec<i8>> for TensorData {
+    fn from(values: Vec<i8>) -> Self {
+        TensorData::Int8(values)
+    }
+}
+
+impl From<Vec<u8>> for TensorData {
+    fn from(values: Vec<u8>) -> Self {
+        TensorData::Uint8(values)
+    }
+}
+
+impl From<Vec<i32>> for TensorData {
+    fn from(values: Vec<i32>) -> Self {
+        TensorData::Int32(values)
+    }
+}
+
+impl From<Vec<i64>> for TensorData {
+    fn from(values: Vec<i64>) -> Self {
+        TensorData::Int64(values)
+    }
+}
+
+impl From<Vec<bool>> for TensorData {
+    fn from(values: Vec<bool>) -> Self {
+        TensorData::Bool(values.into_iter().map(u8::from).collect())
+    }
+}
+
+/// Fail for element types [`TensorData`] cannot hold
+pub(crate) fn check_host_type(data_type: DataType) -> Result<()> {
+    match data_type {
+        DataType::Fp8 | DataType::Int4 | DataType::Fp4 | DataType::E8m0 => {
+            Err(Error::InvalidArgument(format!(
+                "{data_type:?} tensors have no host representation; bind them with a TensorView"
+            )))
+        }
+        _ => Ok(()),
+    }
+}
+
+/// Whether `from` data can be fed to a tensor of type `to`
+pub(crate) fn can_convert(from: DataType, to: DataType) -> bool {
+    let float = |t| matches!(t, DataType::Float | DataType::Half | DataType::Bf16);
+    from == to || (float(from) && float(to))
+}
+
+/// Write the `len` values of `src` as `data_type` into `dst`
+///
+/// `dst` must be aligned for `data_type`, which pinned staging buffers are.
+pub(crate) fn convert_into(
+    src: &TensorData,
+    data_type: DataType,
+    dst: &mut [u8],
+    len: usize,
+) -> Result<()> {
+    if src.data_type() == data_type {
+        let bytes = src.as_bytes();
+        dst[..bytes.len()].copy_from_slice(bytes);
+        return Ok(());
+    }
+
+    match (src, data_type) {
+        (TensorData::Float(values), DataType::Half) => {
+            f32_to_f16(values, &mut cast_slice_mut::<u16>(dst)[..len])
+        }
+        (TensorData::Float(values), DataType::Bf16) => {
+            f32_to_bf16(values, &mut cast_slice_mut::<u16>(dst)[..len])
+        }
+        (TensorData::Half(bits), DataType::Float) => {
+            f16_to_f32(bits, &mut cast_slice_mut::<f32>(dst)[..len])
+        }
+        (TensorData::Bf16(bits), DataType::Float) => {
+            bf16_to_f32(bits, &mut cast_slice_mut::<f32>(dst)[..len])
+        }
+        (TensorData::Half(bits), DataType::Bf16) => recode_via_f32(
+            bits,
+            &mut cast_slice_mut::<u16>(dst)[..len],
+            f16_to_f32,
+            f32_to_bf16,
+        ),
+        (TensorData::Bf16(bits), DataType::Half) => recode_via_f32(
+            bits,
+            &mut cast_slice_mut::<u16>(dst)[..len],
+            bf16_to_f32,
+            f32_to_f16,
+        ),
+        _ => {
+            return Err(Error::InvalidArgument(format!(
+                "Cannot convert {:?} data to {data_type:?}",
+                src.data_type()
+            )))
+        }
+    }
+    Ok(())
+}
+
+/// Convert between 16-bit float formats through a stack buffer of `f32`
+fn recode_via_f32(
+    src: &[u16],
+    dst: &mut [u16],
+    widen: fn(&[u16], &mut [f32]),
+    narrow: fn(&[f32], &mut [u16]),
+) {
+    const CHUNK: usize = 256;
+    assert_eq!(src.len(), dst.len(), "recode_via_f32 length mismatch");
+
+    let mut values = [0.0f32; CHUNK];
+    for (src, dst) in src.chunks(CHUNK).zip(dst.chunks_mut(CHUNK)) {
+        let values = &mut values[..src.len()];
+        widen(src, values);
+        narrow(values, dst);
+    }
+}
+
+/// Convert `f32` values to IEEE half precision, rounding to nearest even
+///
+/// # Panics
+///
+/// Panics if the slices differ in length.
+pub fn f32_to_f16(src: &[f32], dst: &mut [u16]) {
+    assert_eq!(src.len(), dst.len(), "f32_to_f16 length mismatch");
+
+    #[cfg(target_arch = "x86_64")]
+    if std::is_x86_feature_detected!("f16c") && std::is_x86_feature_detected!("avx") {
+        // SAFETY: the required CPU features were just detected
+        unsafe { x86::f32_to_f16(src, dst) };
+        return;
+    }
+
+    for (d, &s) in dst.iter_mut().zip(src) {
+        *d = f32_to_f16_scalar(s);
+    }
+}
+
+/// Convert IEEE half precision values to `f32` (exact)
+///
+/// # Panics
+///
+/// Panics if the slices differ in length.
+pub fn f16_to_f32(src: &[u16], dst: &mut [f32]) {
+    assert_eq!(src.len(), dst.len(), "f16_to_f32 length mismatch");
+
+    #[cfg(target_arch = "x86_64")]
+    if std::is_x86_feature_detected!("f16c") && std::is_x86_feature_detected!("avx") {
+        // SAFETY: the required CPU features were just detected
+        unsafe { x86::f16_to_f32(src, dst) };
+        return;
+    }
+
+    for (d, &s) in dst.iter_mut().zip(src) {
+        *d = f16_to_f32_scalar(s);
+    }
+}
+
+/// Convert `f32` values to bfloat16, rounding to nearest even
+///
+/// Branch-free integer arithmetic, which the compiler vectorizes.
+///
+/// # Panics
+///
+/// Panics if the slices differ in length.
+pub fn f32_to_bf16(src: &[f32], dst: &mut [u16]) {
+    assert_eq!(src.len(), dst.len(), "f32_to_bf16 length mismatch");
+    for (d, &s) in dst.iter_mut().zip(src) {
+        let bits = s.to_bits();
+        let rounded = bits.wrapping_add(0x7fff + ((bits >> 16) & 1)) >> 16;
+        // Keep NaNs quiet instead of letting rounding turn them into infinities
+        let is_nan = (bits & 0x7fff_ffff) > 0x7f80_0000;
+        *d = if is_nan {
+            ((bits >> 16) | 0x40) as u16
+        } else {
+            rounded as u16
+        };
+    }
+}
+
+/// Convert bfloat16 values to `f32` (exact)
+///
+/// # Panics
+///
+/// Panics if the slices differ in length.
+pub fn bf16_to_f32(src: &[u16], dst: &mut [f32]) {
+    assert_eq!(src.len(), dst.len(), "bf16_to_f32 length mismatch");
+    for (d, &s) in dst.iter_mut().zip(src) {
+        *d = f32::from_bits((s as u32) << 16);
+    }
+}
+
+fn f32_to_f16_scalar(value: f32) -> u16 {
+    let x = value.to_bits();
+    let sign = ((x >> 16) & 0x8000) as u16;
+    let exp = ((x >> 23) & 0xff) as i32;
+    let man = x & 0x007f_ffff;
+
+    if exp == 0xff {
+        // Infinity, or NaN with its payload's top bits kept and the quiet bit set
+        let nan = if man != 0 {
+            0x0200 | (man >> 13) as u16
+        } else {
+            0
+        };
+        return sign | 0x7c00 | nan;
+    }
+
+    let half_exp = exp - 127 + 15;
+    if half_exp >= 0x1f {
+        return sign | 0x7c00;
+    }
+
+    // Round to nearest even: up if the round bit is set and either a lower
+    // bit or the result's lowest bit is set
+    let round = |value: u32, dropped: u32, round_bit: u32| {
+        if dropped & round_bit != 0 && dropped & (3 * round_bit - 1) != 0 {
+            value + 1
+        } else {
+            value
+        }
+    };
+
+    if half_exp <= 0 {
+        if half_exp < -10 {
+            return sign;
+        }
+        let man = man | 0x0080_0000;
+        let shift = (14 - half_exp) as u32;
+        return sign | round(man >> shift, man, 1 << (shift - 1)) as u16;
+    }
+
+    // A carry out of the mantissa correctly bumps the exponent
+    let half = ((half_exp as u32) << 10) | (man >> 13);
+    sign | round(half, man, 0x1000) as u16
+}
+
+fn f16_to_f32_scalar(half: u16) -> f32 {
+    let sign = ((half & 0x8000) as u32) << 16;
+    let exp = ((half >> 10) & 0x1f) as u32;
+    let man = (half & 0x03ff) as u32;
+
+    let bits = match (exp, man) {
+        (0, 0) => sign,
+        (0, _) => {
+            // Subnormal: move the leading one up to the implicit bit
+            let shift = man.leading_zeros() - 21;
+            sign | ((113 - shift) << 23) | (((man << shift) & 0x03ff) << 13)
+        }
+        (0x1f, _) => sign | 0x7f80_0000 | (man << 13),
+        _ => sign | ((exp + 112) << 23) | (man << 13),
+    };
+    f32::from_bits(bits)
+}
+
+#[cfg(target_arch = "x86_64")]
+mod x86 {
+    use std::arch::x86_64::*;
+
+    #[target_feature(enable = "avx,f16c")]
+    pub(super) unsafe fn f32_to_f16(src: &[f32], dst: &mut [u16]) {
+        let chunks = src.len() / 8;
+        for i in 0..chunks {
+            let values = _mm256_loadu_ps(src.as_ptr().add(i * 8));
+            let halves = _mm256_cvtps_ph::<_MM_FROUND_TO_NEAREST_INT>(values);
+            _mm_storeu_si128(dst.as_mut_ptr().add(i * 8) as *mut __m128i, halves);
+        }
+        for i in chunks * 8..src.len() {
+            dst[i] = super::f32_to_f16_scalar(src[i]);
+        }
+    }
+
+    #[target_feature(enable = "avx,f16c")]
+    pub(super) unsafe fn f16_to_f32(src: &[u16], dst: &mut [f32]) {
+        let chunks = src.len() / 8;
+        for i in 0..chunks {
+            let halves = _mm_loadu_si128(src.as_ptr().add(i * 8) as *const __m128i);
+            _mm256_storeu_ps(dst.as_mut_ptr().add(i * 8), _mm256_cvtph_ps(halves));
+        }
+        for i in chunks * 8..src.len() {
+            dst[i] = super::f16_to_f32_scalar(src[i]);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_half_conversions_match_reference() {
+        let values = [
+            0.0f32,
+            -0.0,
+            1.0,
+            -2.5,
+            0.1,
+            65504.0,
+            65520.0,
+            1e-5,
+            5.960_464_5e-8,
+            2.980_232_2e-8,
+            f32::INFINITY,
+            f32::MIN_POSITIVE,
+            1.000_976_6,
+        ];
+        let expected: [u16; 13] = [
+            0x0000, 0x8000, 0x3c00, 0xc100, 0x2e66, 0x7bff, 0x7c00, 0x00a8, 0x0001, 0x0000, 0x7c00,
+            0x0000, 0x3c01,
+        ];
+        for (&value, &bits) in values.iter().zip(&expected) {
+            assert_eq!(f32_to_f16_scalar(value), bits, "{value}");
+        }
+
+        // The vectorized path agrees with the scalar one, tails included
+        let inputs = (0..1003)
+            .map(|i| (i as f32 - 500.0) * 0.37)
+            .collect::<Vec<_>>();
+        let mut halves = vec![0u16; inputs.len()];
+        f32_to_f16(&inputs, &mut halves);
+        for (&value, &half) in inputs.iter().zip(&halves) {
+            assert_eq!(half, f32_to_f16_scalar(value));
+        }
+        let mut back = vec![0f32; inputs.len()];
+        f16_to_f32(&halves, &mut back);
+        for (&half, &value) in halves.iter().zip(&back) {
+            assert_eq!(value.to_bits(), f16_to_f32_scalar(half).to_bits());
+            assert_eq!(f32_to_f16_scalar(value), half);
+        }
+        assert!(f16_to_f32_scalar(0x7e00).is_nan());
+        assert_eq!(f16_to_f32_scalar(0x0001), 5.960_464_5e-8);
+    }
+
+    #[test]
+    fn test_bf16_conversions() {
+        // 1 + 2^-8 and 1 + 3 * 2^-8 sit exactly halfway between two bf16 values
+        let (low_tie, high_tie) = (f32::from_bits(0x3f80_8000), f32::from_bits(0x3f81_8000));
+        let values = [1.0f32, -3.0, low_tie, high_tie, f32::NAN];
+        let mut bits = [0u16; 5];
+        f32_to_bf16(&values, &mut bits);
+        // Ties round to even: the first down, the second up
+        assert_eq!(&bits[..4], &[0x3f80, 0xc040, 0x3f80, 0x3f82]);
+        let mut back = [0f32; 5];
+        bf16_to_f32(&bits, &mut back);
+        assert_eq!(&back[..2], &[1.0, -3.0]);
+        assert!(back[4].is_nan());
+    }
+
+    #[test]
+    fn test_tensor_data_conversions() {
+        let data = TensorData::from(vec![0.5f32, -1.0, 2.0]);
+        assert_eq!(data.as_bytes().len(), 12);
+
+        let half = data.to_type(DataType::Half).unwrap();
+        assert_eq!(half, TensorData::Half(vec![0x3800, 0xbc00, 0x4000]));
+        assert_eq!(half.to_f32().unwrap(), vec![0.5, -1.0, 2.0]);
+        assert!(TensorData::from(vec![1i64]).to_f32().is_err());
+
+        let merged = TensorData::concat([&half, &half]).unwrap();
+        assert_eq!(merged.len(), 6);
+        assert_eq!(merged.slice(3..6), half);
+        assert!(TensorData::concat([&half, &data]).is_err());
+
+        // 16-bit formats convert into each other over more than one chunk
+        let values = (0..1000).map(|i| i as f32 * 0.25).collect::<Vec<_>>();
+        let bf16 = TensorData::from(values.clone())
+            .to_type(DataType::Bf16)
+            .unwrap();
+        let mut staged = crate::cuda::PinnedHostBuffer::new(values.len() * 2).unwrap();
+        convert_into(&bf16, DataType::Half, staged.as_mut_slice(), values.len()).unwrap();
+        let mut roundtrip = vec![0.0f32; values.len()];
+        f16_to_f32(staged.as_slice_of(), &mut roundtrip);
+        assert_eq!(roundtrip, bf16.to_f32().unwrap());
+
+        let mut out = TensorData::Float(Vec::new());
+        out.assign_from_bytes(DataType::Int64, as_bytes(&[7i64, 8]), 2)
+            .unwrap();
+        assert_eq!(out.as_i64(), Some(&[7i64, 8][..]));
+    }
+}
@@ -0,0 +1,235 @@
+//! On-disk cache of built engine plans
+//!
+//! Building an engine from ONNX can take minutes, while deserializing a plan
+//! takes a fraction of a second. [`EngineCache`] stores plans in a directory
+//! under a key that covers everything the plan depends on: the ONNX bytes,
+//! the GPU it was tuned for, the TensorRT-RTX version and the builder
+//! settings. Any change to one of those produces a different key, so stale
+//! plans are never loaded.
+
+use crate::builder::BuilderConfig;
+use crate::cuda::current_device_identity;
+use crate::error::Result;
+use crate::runtime::tensorrt_version;
+use sha2::{Digest, Sha256};
+use std::fmt::Write as _;
+use std::io::Write as _;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicU64, Ordering};
+
+/// Bumped whenever the key layout below changes
+const KEY_FORMAT_VERSION: u32 = 1;
+
+/// Extension of plan files inside the cache directory
+const PLAN_EXTENSION: &str = "plan";
+
+/// Environment variable that enables the cache for [`run_onnx_with_tensorrt`](crate::run_onnx_with_tensorrt)
+pub const ENGINE_CACHE_DIR_ENV: &str = "TRTX_ENGINE_CACHE_DIR";
+
+/// Identifies one cached plan
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+pub struct CacheKey(String);
+
+impl CacheKey {
+    /// Get the key as a hex string (also the plan's file stem)
+    pub fn as_str(&self) -> &str {
+        &self.0
+    }
+}
+
+impl std::fmt::Display for CacheKey {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.write_str(&self.0)
+    }
+}
+
+/// Directory of serialized engine plans keyed by model, GPU and build settings
+#[derive(Debug, Clone)]
+pub struct EngineCache {
+    dir: PathBuf,
+}
+
+impl EngineCache {
+    /// Open (and create if needed) a cache rooted at `dir`
+    pub fn new<P: AsRef<Path>>(dir: P) -> Result<Self> {
+        let dir = dir.as_ref().to_path_buf();
+        std::fs::create_dir_all(&dir)?;
+        Ok(EngineCache { dir })
+    }
+
+    /// Open the cache named by `TRTX_ENGINE_CACHE_DIR`, if it is set
+    pub fn from_env() -> Result<Option<Self>> {
+        match std::env::var_os(ENGINE_CACHE_DIR_ENV) {
+            Some(dir) if !dir.is_empty() => Self::new(dir).map(Some),
+            _ => Ok(None),
+        }
+    }
+
+    /// Get the cache directory
+    pub fn dir(&self) -> &Path {
+        &self.dir
+    }
+
+    /// Compute the key for building `onnx_bytes` with `config` on the current device
+    pub fn key(&self, onnx_bytes: &[u8], config: &BuilderConfig) -> Result<CacheKey> {
+        let device = current_device_identity()?;
+
+        let mut hasher = Sha256::new();
+        hasher.update(KEY_FORMAT_VERSION.to_le_bytes());
+        hasher.update(Sha256::digest(onnx_bytes));
+        hasher.update(device.compute_capability.0.to_le_bytes());
+        hasher.update(device.compute_capability.1.to_le_bytes());
+        hasher.update(device.uuid);
+        hasher.update(tensorrt_version().to_le_bytes());
+        hasher.update(config.settings_fingerprint().as_bytes());
+
+        let mut key = String::with_capacity(64);
+        for byte in hasher.finalize() {
+            let _ = write!(key, "{byte:02x}");
+        }
+        Ok(CacheKey(key))
+    }
+
+    /// Get the path a plan with `key` is stored at
+    pub fn plan_path(&self, key: &CacheKey) -> PathBuf {
+        self.dir.join(format!("{key}.{PLAN_EXTENSION}"))
+    }
+
+    /// Get the path of the cached plan for `key`, if there is one
+    pub fn lookup(&self, key: &CacheKey) -> Option<PathBuf> {
+        let path = self.plan_path(key);
+        path.is_file().then_some(path)
+    }
+
+    /// Store a plan under `key`
+    ///
+    /// The plan is written to a temporary file in the cache directory and
+    /// renamed into place, so concurrent readers and writers (including other
+    /// processes) never observe a partially written plan.
+    pub fn store(&self, key: &CacheKey, plan: &[u8]) -> Result<PathBuf> {
+        let path = self.plan_path(key);
+        write_atomically(&path, plan)?;
+        Ok(path)
+    }
+
+    /// Remove the cached plan for `key`, if any
+    pub fn remove(&self, key: &CacheKey) -> Result<()> {
+        match std::fs::remove_file(self.plan_path(key)) {
+            Err(e) if e.kind() != std::io::ErrorKind::NotFound => Err(e.into()),
+            _ => Ok(()),
+        }
+    }
+}
+
+/// Write `data` to `path` through a temporary file so readers never see a partial file
+///
+/// The temporary file sits next to `path` under a name unique to this
+/// process and call, so concurrent writers of the same or of similarly
+/// named files never share one.
+pub(crate) fn write_atomically(path: &Path, data: &[u8]) -> Result<()> {
+    static TMP_COUNTER: AtomicU64 = AtomicU64::new(0);
+
+    let mut tmp_name = std::ffi::OsString::from(".");
+    tmp_name.push(path.file_name().unwrap_or_default());
+    tmp_name.push(format!(
+        ".{}.{}.tmp",
+        std::process::id(),
+        TMP_COUNTER.fetch_add(1, Ordering::Relaxed)
+    ));
+    let tmp_path = path.with_file_name(tmp_name);
+
+    let written = (|| {
+        if let Some(dir) = path.parent().filter(|dir| !dir.as_os_str().is_empty()) {
+            std::fs::create_dir_all(dir)?;
+        }
+        let mut file = std::fs::File::create(&tmp_path)?;
+        file.write_all(data)?;
+        file.sync_all()?;
+        std::fs::rename(&tmp_path, path)
+    })();
+
+    if let Err(e) = written {
+        let _ = std::fs::remove_file(&tmp_path);
+        return Err(e.into());
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::builder::MemoryPoolType;
+    use crate::{Builder, Logger};
+
+    fn scratch_dir(name: &str) -> PathBuf {
+        let dir = std::env::temp_dir().join(format!("trtx-{name}-{}", std::process::id()));
+        let _ = std::fs::remove_dir_all(&dir);
+        dir
+    }
+
+    #[test]
+    fn test_key_covers_model_and_config() {
+        let dir = scratch_dir("cache-key");
+        let cache = EngineCache::new(&dir).unwrap();
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let mut config = builder.create_config().unwrap();
+
+        let key = cache.key(b"model-a", &config).unwrap();
+        assert_eq!(key.as_str().len(), 64);
+        assert_eq!(key, cache.key(b"model-a", &config).unwrap());
+        assert_ne!(key, cache.key(b"model-b", &config).unwrap());
+
+        config
+            .set_memory_pool_limit(MemoryPoolType::Workspace, 1 << 20)
+            .unwrap();
+        assert_ne!(key, cache.key(b"model-a", &config).unwrap());
+
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn test_store_and_lookup() {
+        let dir = scratch_dir("cache-store");
+        let cache = EngineCache::new(&dir).unwrap();
+        let key = CacheKey("ab".repeat(32));
+
+        assert!(cache.lookup(&key).is_none());
+        let path = cache.store(&key, b"plan bytes").unwrap();
+        assert_eq!(cache.lookup(&key), Some(path.clone()));
+        assert_eq!(std::fs::read(&path).unwrap(), b"plan bytes");
+
+        // Only the plan itself is left behind, no temporary files
+        assert_eq!(std::fs::read_dir(&dir).unwrap().count(), 1);
+
+        cache.remove(&key).unwrap();
+        assert!(cache.lookup(&key).is_none());
+        cache.remove(&key).unwrap();
+
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn test_write_atomically_concurrent_writers() {
+        let dir = scratch_dir("atomic-write");
+        // Same stem, different extensions, and several writers per file
+        let paths = [dir.join("model.cache"), dir.join("model.rtcache")];
+        std::thread::scope(|scope| {
+            for (i, path) in paths.iter().enumerate() {
+                for _ in 0..4 {
+                    scope.spawn(move || {
+                        for _ in 0..16 {
+                            write_atomically(path, &[i as u8; 4096]).unwrap();
+                        }
+                    });
+                }
+            }
+        });
+
+        for (i, path) in paths.iter().enumerate() {
+            assert_eq!(std::fs::read(path).unwrap(), vec![i as u8; 4096]);
+        }
+        assert_eq!(std::fs::read_dir(&dir).unwrap().count(), 2);
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+}
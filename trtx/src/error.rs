@@ -1,6 +1,6 @@
 //! Error types for TensorRT-RTX operations
 
-use std::ffi::NulError;
+use std::ffi::{CStr, NulError};
 use thiserror::Error;
 
 /// Result type for TensorRT-RTX operations
@@ -43,10 +43,23 @@ pub enum Error {
 }
 
 impl Error {
-    /// Create error from FFI error code and message buffer
-    pub(crate) fn from_ffi(code: i32, error_msg: &[i8]) -> Self {
-        let msg = Self::parse_error_msg(error_msg);
+    /// Create error from FFI error code and the calling thread's last error message
+    ///
+    /// Takes the message, so a later failure without one cannot report it again.
+    pub(crate) fn last_ffi(code: i32) -> Self {
+        // SAFETY: trtx_get_last_error never returns NULL and the string lives in
+        // thread-local storage until the next failure or clear on this thread
+        let msg = unsafe {
+            let msg = CStr::from_ptr(trtx_sys::trtx_get_last_error())
+                .to_string_lossy()
+                .into_owned();
+            trtx_sys::trtx_clear_last_error();
+            msg
+        };
+        Self::from_code(code, msg)
+    }
 
+    fn from_code(code: i32, msg: String) -> Self {
         match code {
             code if code == trtx_sys::TRTX_ERROR_INVALID_ARGUMENT as i32 => {
                 Error::InvalidArgument(msg)
@@ -57,17 +70,6 @@ impl Error {
             _ => Error::Unknown(msg),
         }
     }
-
-    /// Parse error message from C string buffer
-    fn parse_error_msg(buffer: &[i8]) -> String {
-        // Find null terminator
-        let len = buffer.iter().position(|&c| c == 0).unwrap_or(buffer.len());
-
-        // Convert i8 to u8 safely
-        let bytes: Vec<u8> = buffer[..len].iter().map(|&c| c as u8).collect();
-
-        String::from_utf8_lossy(&bytes).into_owned()
-    }
 }
 
 #[cfg(test)]
@@ -81,19 +83,14 @@ mod tests {
     }
 
     #[test]
-    fn test_parse_error_msg() {
-        let msg = b"test error\0".map(|b| b as i8);
-        let parsed = Error::parse_error_msg(&msg);
-        assert_eq!(parsed, "test error");
-    }
-
-    #[test]
-    fn test_from_ffi() {
-        let msg = b"test\0".map(|b| b as i8);
-        let err = Error::from_ffi(trtx_sys::TRTX_ERROR_INVALID_ARGUMENT as i32, &msg);
-        match err {
-            Error::InvalidArgument(s) => assert_eq!(s, "test"),
-            _ => panic!("Wrong error type"),
-        }
+    fn test_last_ffi() {
+        let result = unsafe { trtx_sys::trtx_cuda_set_device(-1, std::ptr::null_mut(), 0) };
+        assert_ne!(result, trtx_sys::TRTX_SUCCESS as i32);
+        let err = Error::last_ffi(result);
+        assert!(err.to_string().contains("invalid device ordinal"));
+
+        // The message was taken with the first error
+        let err = Error::last_ffi(result);
+        assert!(!err.to_string().contains("invalid device ordinal"));
     }
 }
@@ -36,6 +36,17 @@
 //! 4. Bind input/output tensors
 //! 5. Execute inference with [`ExecutionContext::enqueue_v3`]
 //!
+//! For serving, [`InferenceSession`] wraps the inference phase: it is
+//! created once from ONNX bytes or a plan and keeps the engine, execution
+//! contexts and IO buffers warm across [`InferenceSession::run`] calls.
+//! Pointing [`SessionConfig::engine_cache`] at an [`EngineCache`] directory
+//! lets later processes skip the build entirely. Many small concurrent
+//! requests can be merged into larger batches by a [`DynamicBatcher`] in
+//! front of the session. A [`BuildService`] builds many engines in parallel
+//! with one shared, persisted timing cache. [`benchmark`] reports latency
+//! percentiles, throughput and a copy/compute breakdown for an engine; a
+//! [`Profiler`] and [`EngineInspector`] break a slow engine down by layer.
+//!
 //! # Example
 //!
 //! ```rust,no_run
@@ -91,19 +102,60 @@
 // Allow unnecessary casts - they're needed for real mode (u32) but not mock mode (i32)
 #![cfg_attr(feature = "mock", allow(clippy::unnecessary_cast))]
 
+pub mod batching;
+pub mod bench;
+pub mod build_service;
 pub mod builder;
 pub mod cuda;
+pub mod data;
+pub mod engine_cache;
 pub mod error;
 pub mod executor;
 pub mod logger;
+pub mod memory;
 pub mod onnx_parser;
+pub mod pool;
+pub mod profiler;
+pub mod refit;
+pub mod registry;
+pub mod replicated;
 pub mod runtime;
+pub mod runtime_cache;
+pub mod session;
+pub mod tensor;
+pub mod view;
 
 // Re-export commonly used types
-pub use builder::{Builder, BuilderConfig, NetworkDefinition};
-pub use cuda::{synchronize, DeviceBuffer};
+pub use batching::{BatcherConfig, BatcherStats, DynamicBatcher, PendingOutputs};
+pub use bench::{benchmark, BenchmarkConfig, BenchmarkReport, LatencySummary};
+pub use build_service::{BuildJob, BuildOutcome, BuildService, BuildServiceConfig, BuiltPlan};
+pub use builder::{
+    Builder, BuilderConfig, BuilderFlag, ComputeCapability, HardwareCompatibilityLevel, HostMemory,
+    NetworkDefinition, OptimizationProfile, ProfilingVerbosity, TimingCache,
+};
+pub use cuda::{
+    current_device, device_count, set_device, synchronize, CudaEvent, CudaStream, DeviceBuffer,
+    DeviceGuard, PinnedHostBuffer, StreamCompletion,
+};
+pub use data::TensorData;
+pub use engine_cache::EngineCache;
 pub use error::{Error, Result};
 pub use executor::{run_onnx_with_tensorrt, run_onnx_zeroed, TensorInput, TensorOutput};
-pub use logger::{LogHandler, Logger, Severity, StderrLogger};
-pub use onnx_parser::OnnxParser;
-pub use runtime::{CudaEngine, ExecutionContext, Runtime};
+pub use logger::{LogHandler, Logger, Severity, StderrLogger, MAX_QUEUED_MESSAGE_LEN};
+pub use memory::{CachingDeviceAllocator, DeviceAllocator, PinnedBufferPool, ScratchArena};
+pub use onnx_parser::{ModelSupport, OnnxParser, Subgraph};
+pub use pool::{ContextLease, ExecutionPool, Lease, PooledContext};
+pub use profiler::{EngineInspector, LayerInformationFormat, LayerStats, LayerTimings, Profiler};
+pub use refit::{Refitter, Weights};
+pub use registry::{
+    EngineRegistry, LoadTimings, ModelSource, ModelSpec, ModelStatus, RegistryConfig,
+};
+pub use replicated::ReplicatedSession;
+pub use runtime::{
+    AllocationStrategy, CudaEngine, CudaGraphStats, ExecutionContext, Runtime, TensorBinding,
+    WeightStreamingBudget, WeightStreamingInfo,
+};
+pub use runtime_cache::RuntimeCache;
+pub use session::{InferenceSession, SessionConfig, ShapeRange};
+pub use tensor::{BindingTable, DataType, ProfileSelector, TensorFormat, TensorIOMode, TensorInfo};
+pub use view::{TensorView, TensorViewMut};
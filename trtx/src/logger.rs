@@ -1,8 +1,13 @@
 //! Logger interface for TensorRT-RTX
 
 use crate::error::Result;
+use std::cell::UnsafeCell;
 use std::ffi::{c_void, CStr};
 use std::os::raw::c_char;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, OnceLock};
+use std::thread::{JoinHandle, Thread};
+use std::time::Duration;
 use trtx_sys::*;
 
 /// Severity level for log messages
@@ -53,45 +58,76 @@ impl LogHandler for StderrLogger {
 }
 
 /// Logger wrapper that interfaces with TensorRT-RTX
+///
+/// By default every message is handed to the [`LogHandler`] on the TensorRT
+/// thread that emitted it. [`set_min_severity`](Self::set_min_severity)
+/// drops less severe messages on the C++ side, before they reach Rust, and
+/// [`Logger::asynchronous`] queues messages for a background thread so a
+/// slow handler never stalls a build or deserialization.
 pub struct Logger {
     inner: *mut TrtxLogger,
-    // Keep the handler alive
-    _handler: Box<dyn LogHandler>,
+    // Target of the native callback; boxed so its address stays stable
+    sink: Box<LogSink>,
+    drain: Option<JoinHandle<()>>,
+}
+
+/// Where the native callback forwards messages
+enum LogSink {
+    Direct(Box<dyn LogHandler>),
+    Queued(Arc<LogQueue>),
 }
 
 impl Logger {
     /// Create a new logger with a custom handler
     pub fn new<H: LogHandler + 'static>(handler: H) -> Result<Self> {
-        let handler_box: Box<dyn LogHandler> = Box::new(handler);
-        let user_data = Box::into_raw(Box::new(handler_box)) as *mut c_void;
+        Self::with_sink(Box::new(LogSink::Direct(Box::new(handler))), None)
+    }
+
+    /// Create a logger whose handler runs on a background thread
+    ///
+    /// Messages are copied into a bounded lock-free queue of `capacity`
+    /// slots (rounded up to a power of two), so logging never allocates,
+    /// locks or waits for the handler. Messages longer than
+    /// [`MAX_QUEUED_MESSAGE_LEN`] bytes are truncated. When the queue is
+    /// full, messages are dropped and counted; the handler is told how many
+    /// with a warning once the queue drains.
+    pub fn asynchronous<H: LogHandler + 'static>(handler: H, capacity: usize) -> Result<Self> {
+        let queue = Arc::new(LogQueue::new(capacity));
+        let drain = {
+            let queue = Arc::clone(&queue);
+            std::thread::Builder::new()
+                .name("trtx-logger".to_string())
+                .spawn(move || queue.drain(&handler))?
+        };
+        let _ = queue.consumer.set(drain.thread().clone());
+
+        let sink = Box::new(LogSink::Queued(Arc::clone(&queue)));
+        Self::with_sink(sink, Some(drain)).inspect_err(|_| queue.close())
+    }
+
+    fn with_sink(sink: Box<LogSink>, drain: Option<JoinHandle<()>>) -> Result<Self> {
+        let user_data = sink.as_ref() as *const LogSink as *mut c_void;
 
         let mut logger_ptr: *mut TrtxLogger = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_logger_create(
                 Some(Self::log_callback),
                 user_data,
                 &mut logger_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            // Clean up user_data
-            unsafe {
-                let _ = Box::from_raw(user_data as *mut Box<dyn LogHandler>);
-            }
-            return Err(crate::error::Error::from_ffi(result, &error_msg));
+            return Err(crate::error::Error::last_ffi(result));
         }
 
-        // Reconstruct the handler box for keeping alive
-        let handler_box = unsafe { Box::from_raw(user_data as *mut Box<dyn LogHandler>) };
-
         Ok(Logger {
             inner: logger_ptr,
-            _handler: *handler_box,
+            sink,
+            drain,
         })
     }
 
@@ -100,6 +136,31 @@ impl Logger {
         Self::new(StderrLogger)
     }
 
+    /// Drop messages less severe than `severity` before they leave TensorRT
+    ///
+    /// [`Severity::Verbose`] (the default) passes everything; e.g.
+    /// [`Severity::Warning`] passes warnings and errors only. Can be changed
+    /// at any time, including while another thread is building.
+    pub fn set_min_severity(&self, severity: Severity) -> Result<()> {
+        let result = unsafe {
+            trtx_logger_set_min_severity(self.inner, severity as i32, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(crate::error::Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get the number of messages an asynchronous logger dropped because its queue was full
+    pub fn dropped_messages(&self) -> u64 {
+        match self.sink.as_ref() {
+            LogSink::Direct(_) => 0,
+            LogSink::Queued(queue) => queue.dropped.load(Ordering::Relaxed),
+        }
+    }
+
     /// Get the raw pointer (for internal use)
     pub(crate) fn as_ptr(&self) -> *mut TrtxLogger {
         self.inner
@@ -116,7 +177,7 @@ impl Logger {
         }
 
         unsafe {
-            let handler = &*(user_data as *const Box<dyn LogHandler>);
+            let sink = &*(user_data as *const LogSink);
             let msg_str = CStr::from_ptr(msg);
 
             #[cfg(feature = "mock")]
@@ -138,8 +199,14 @@ impl Logger {
                 _ => Severity::Verbose, // Default fallback
             };
 
-            if let Ok(msg) = msg_str.to_str() {
-                handler.log(severity, msg);
+            match sink {
+                LogSink::Direct(handler) => {
+                    if let Ok(msg) = msg_str.to_str() {
+                        handler.log(severity, msg);
+                    }
+                }
+                // Raw bytes only; the drain thread does the UTF-8 handling
+                LogSink::Queued(queue) => queue.push(severity, msg_str.to_bytes()),
             }
         }
     }
@@ -152,6 +219,179 @@ impl Drop for Logger {
                 trtx_logger_destroy(self.inner);
             }
         }
+        // Nothing can log any more; flush what is queued and stop the thread
+        if let LogSink::Queued(queue) = self.sink.as_ref() {
+            queue.close();
+        }
+        if let Some(drain) = self.drain.take() {
+            let _ = drain.join();
+        }
+    }
+}
+
+/// Longest message an asynchronous [`Logger`] queues without truncating, in bytes
+pub const MAX_QUEUED_MESSAGE_LEN: usize = 1000;
+
+/// One queued message, stored inline so pushing never allocates
+struct QueuedMessage {
+    severity: Severity,
+    len: usize,
+    bytes: [u8; MAX_QUEUED_MESSAGE_LEN],
+}
+
+struct QueueSlot {
+    // Vyukov's sequence number: equal to the position when the slot is free
+    // for that position's producer, position + 1 once it holds a message
+    sequence: AtomicUsize,
+    message: UnsafeCell<QueuedMessage>,
+}
+
+/// Bounded lock-free queue with many producers and a single consumer
+struct LogQueue {
+    slots: Box<[QueueSlot]>,
+    mask: usize,
+    enqueue_pos: AtomicUsize,
+    dequeue_pos: AtomicUsize,
+    dropped: AtomicU64,
+    // Set while the consumer is about to park, so producers know to wake it
+    sleeping: AtomicBool,
+    closed: AtomicBool,
+    consumer: OnceLock<Thread>,
+}
+
+// Slots are handed between threads through their sequence numbers
+unsafe impl Sync for LogQueue {}
+
+impl LogQueue {
+    fn new(capacity: usize) -> Self {
+        let capacity = capacity.max(2).next_power_of_two();
+        let slots = (0..capacity)
+            .map(|i| QueueSlot {
+                sequence: AtomicUsize::new(i),
+                message: UnsafeCell::new(QueuedMessage {
+                    severity: Severity::Verbose,
+                    len: 0,
+                    bytes: [0; MAX_QUEUED_MESSAGE_LEN],
+                }),
+            })
+            .collect();
+
+        LogQueue {
+            slots,
+            mask: capacity - 1,
+            enqueue_pos: AtomicUsize::new(0),
+            dequeue_pos: AtomicUsize::new(0),
+            dropped: AtomicU64::new(0),
+            sleeping: AtomicBool::new(false),
+            closed: AtomicBool::new(false),
+            consumer: OnceLock::new(),
+        }
+    }
+
+    /// Queue a message, or count it as dropped if the queue is full
+    fn push(&self, severity: Severity, bytes: &[u8]) {
+        let mut pos = self.enqueue_pos.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let sequence = slot.sequence.load(Ordering::Acquire);
+            match sequence.wrapping_sub(pos) as isize {
+                0 => match self.enqueue_pos.compare_exchange_weak(
+                    pos,
+                    pos.wrapping_add(1),
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        // SAFETY: winning the position gives exclusive access to the slot
+                        let message = unsafe { &mut *slot.message.get() };
+                        let len = bytes.len().min(MAX_QUEUED_MESSAGE_LEN);
+                        message.severity = severity;
+                        message.len = len;
+                        message.bytes[..len].copy_from_slice(&bytes[..len]);
+                        slot.sequence.store(pos.wrapping_add(1), Ordering::Release);
+                        break;
+                    }
+                    Err(current) => pos = current,
+                },
+                // The consumer has not freed this slot yet: the queue is full
+                diff if diff < 0 => {
+                    self.dropped.fetch_add(1, Ordering::Relaxed);
+                    return;
+                }
+                _ => pos = self.enqueue_pos.load(Ordering::Relaxed),
+            }
+        }
+
+        if self.sleeping.load(Ordering::SeqCst) && self.sleeping.swap(false, Ordering::SeqCst) {
+            if let Some(consumer) = self.consumer.get() {
+                consumer.unpark();
+            }
+        }
+    }
+
+    /// Hand the oldest message to `f`; only the drain thread calls this
+    fn pop(&self, f: impl FnOnce(&QueuedMessage)) -> bool {
+        let pos = self.dequeue_pos.load(Ordering::Relaxed);
+        let slot = &self.slots[pos & self.mask];
+        if slot.sequence.load(Ordering::Acquire) != pos.wrapping_add(1) {
+            return false;
+        }
+
+        // SAFETY: the producer published the slot and will not touch it
+        // again until the sequence below frees it
+        f(unsafe { &*slot.message.get() });
+        slot.sequence
+            .store(pos.wrapping_add(self.mask + 1), Ordering::Release);
+        self.dequeue_pos
+            .store(pos.wrapping_add(1), Ordering::Relaxed);
+        true
+    }
+
+    fn close(&self) {
+        self.closed.store(true, Ordering::SeqCst);
+        if let Some(consumer) = self.consumer.get() {
+            consumer.unpark();
+        }
+    }
+
+    /// Body of the drain thread
+    fn drain(&self, handler: &dyn LogHandler) {
+        let mut reported_drops = 0;
+        loop {
+            // Checked before draining, so nothing pushed before `close` is lost
+            let closed = self.closed.load(Ordering::SeqCst);
+            while self.pop(|message| {
+                let text = String::from_utf8_lossy(&message.bytes[..message.len]);
+                handler.log(message.severity, &text);
+            }) {}
+
+            let dropped = self.dropped.load(Ordering::Relaxed);
+            if dropped != reported_drops {
+                handler.log(
+                    Severity::Warning,
+                    &format!(
+                        "Log queue full: dropped {} message(s)",
+                        dropped - reported_drops
+                    ),
+                );
+                reported_drops = dropped;
+            }
+            if closed {
+                return;
+            }
+
+            self.sleeping.store(true, Ordering::SeqCst);
+            if self.is_empty() && !self.closed.load(Ordering::SeqCst) {
+                // Timed, in case a wakeup races with going to sleep
+                std::thread::park_timeout(Duration::from_millis(50));
+            }
+            self.sleeping.store(false, Ordering::SeqCst);
+        }
+    }
+
+    fn is_empty(&self) -> bool {
+        let pos = self.dequeue_pos.load(Ordering::Relaxed);
+        self.slots[pos & self.mask].sequence.load(Ordering::Acquire) != pos.wrapping_add(1)
     }
 }
 
@@ -164,13 +404,11 @@ mod tests {
     use super::*;
     use std::sync::{Arc, Mutex};
 
-    #[allow(dead_code)]
     #[derive(Clone)]
     struct TestLogger {
         messages: Arc<Mutex<Vec<(Severity, String)>>>,
     }
 
-    #[allow(dead_code)]
     impl TestLogger {
         fn new() -> Self {
             Self {
@@ -199,4 +437,69 @@ mod tests {
         assert!(Severity::Warning < Severity::Info);
         assert!(Severity::Info < Severity::Verbose);
     }
+
+    #[test]
+    fn test_min_severity_filter() {
+        let handler = TestLogger::new();
+        let logger = Logger::new(handler.clone()).unwrap();
+
+        // The mock builder logs one info and one verbose message
+        drop(crate::Builder::new(&logger).unwrap());
+        let severities = |h: &TestLogger| h.get_messages().iter().map(|m| m.0).collect::<Vec<_>>();
+        assert_eq!(
+            severities(&handler),
+            vec![Severity::Info, Severity::Verbose]
+        );
+
+        logger.set_min_severity(Severity::Info).unwrap();
+        drop(crate::Builder::new(&logger).unwrap());
+        assert_eq!(severities(&handler).len(), 3);
+        assert_eq!(severities(&handler)[2], Severity::Info);
+
+        logger.set_min_severity(Severity::Warning).unwrap();
+        drop(crate::Builder::new(&logger).unwrap());
+        assert_eq!(severities(&handler).len(), 3);
+    }
+
+    #[test]
+    fn test_asynchronous_logger() {
+        let handler = TestLogger::new();
+        let logger = Logger::asynchronous(handler.clone(), 16).unwrap();
+        for _ in 0..3 {
+            drop(crate::Builder::new(&logger).unwrap());
+        }
+        assert_eq!(logger.dropped_messages(), 0);
+
+        // Dropping the logger flushes the queue
+        drop(logger);
+        let messages = handler.get_messages();
+        assert_eq!(messages.len(), 6);
+        assert_eq!(
+            messages[0],
+            (Severity::Info, "Mock builder created".to_string())
+        );
+    }
+
+    #[test]
+    fn test_log_queue_bounds() {
+        let queue = LogQueue::new(3);
+        assert_eq!(queue.slots.len(), 4);
+        let long = vec![b'x'; MAX_QUEUED_MESSAGE_LEN + 10];
+        queue.push(Severity::Error, &long);
+        for i in 0..4u8 {
+            queue.push(Severity::Info, &[b'0' + i]);
+        }
+        assert_eq!(queue.dropped.load(Ordering::Relaxed), 1);
+
+        let mut popped = Vec::new();
+        while queue.pop(|m| popped.push((m.severity, m.bytes[..m.len].to_vec()))) {}
+        assert_eq!(popped.len(), 4);
+        assert_eq!(popped[0].1.len(), MAX_QUEUED_MESSAGE_LEN);
+        assert_eq!(popped[3], (Severity::Info, b"2".to_vec()));
+        assert!(queue.is_empty());
+
+        // Wraps around once slots are freed
+        queue.push(Severity::Warning, b"again");
+        assert!(queue.pop(|m| assert_eq!(&m.bytes[..m.len], b"again")));
+    }
 }
@@ -0,0 +1,711 @@
+//! Memory pools for transfer staging and device allocations
+//!
+//! Pinning host memory is expensive (it goes through the driver and locks
+//! pages), so per-request staging buffers are recycled through size classes
+//! instead of being allocated and pinned on every call.
+//!
+//! `cudaMalloc`/`cudaFree` implicitly synchronize the device, so device
+//! buffers on the hot path come from a [`DeviceAllocator`] instead.
+//!
+//! Activation memory of execution contexts can be shared through a
+//! [`ScratchArena`], so N contexts need only as many scratch blocks as are
+//! in use at the same time.
+
+use crate::cuda::{self, host_alloc_flags, CudaStream, DeviceBuffer, PinnedHostBuffer, Pod};
+use crate::error::{Error, Result};
+use crate::pool::{Lease, SlotPool};
+use std::collections::HashMap;
+use std::ffi::c_void;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use trtx_sys::*;
+
+/// Smallest size class (4 KiB, one page)
+const MIN_CLASS_SHIFT: u32 = 12;
+
+/// Default number of idle buffers kept per size class
+const DEFAULT_MAX_CACHED_PER_CLASS: usize = 8;
+
+/// Size-class pool of pinned host buffers
+///
+/// Requests are rounded up to the next power of two (at least 4 KiB) and
+/// served from a free list for that class. Cloning the pool is cheap and
+/// shares the same free lists.
+#[derive(Clone)]
+pub struct PinnedBufferPool {
+    inner: Arc<PinnedPoolInner>,
+}
+
+struct PinnedPoolInner {
+    flags: u32,
+    max_cached_per_class: usize,
+    // Indexed by size class shift
+    classes: Mutex<Vec<Vec<PinnedHostBuffer>>>,
+}
+
+impl PinnedBufferPool {
+    /// Create an empty pool of default pinned buffers
+    pub fn new() -> Self {
+        Self::with_options(host_alloc_flags::DEFAULT, DEFAULT_MAX_CACHED_PER_CLASS)
+    }
+
+    /// Create an empty pool with explicit `host_alloc_flags` and idle buffer limit
+    pub fn with_options(flags: u32, max_cached_per_class: usize) -> Self {
+        PinnedBufferPool {
+            inner: Arc::new(PinnedPoolInner {
+                flags,
+                max_cached_per_class,
+                classes: Mutex::new(Vec::new()),
+            }),
+        }
+    }
+
+    /// Process-wide pool used by the executor
+    pub fn global() -> &'static PinnedBufferPool {
+        static GLOBAL: OnceLock<PinnedBufferPool> = OnceLock::new();
+        GLOBAL.get_or_init(PinnedBufferPool::new)
+    }
+
+    /// Get a pinned buffer of at least `len` bytes
+    pub fn acquire(&self, len: usize) -> Result<PooledPinnedBuffer> {
+        let class = size_class(len);
+
+        let cached = {
+            let mut classes = self.inner.classes.lock().unwrap();
+            classes.get_mut(class as usize).and_then(|free| free.pop())
+        };
+
+        let buffer = match cached {
+            Some(buffer) => buffer,
+            None => PinnedHostBuffer::with_flags(1usize << class, self.inner.flags)?,
+        };
+
+        Ok(PooledPinnedBuffer {
+            buffer: Some(buffer),
+            len,
+            class,
+            pool: Arc::clone(&self.inner),
+        })
+    }
+
+    /// Total bytes held by idle buffers
+    pub fn cached_bytes(&self) -> usize {
+        let classes = self.inner.classes.lock().unwrap();
+        classes
+            .iter()
+            .flat_map(|free| free.iter())
+            .map(PinnedHostBuffer::size)
+            .sum()
+    }
+
+    /// Release every idle buffer back to the driver
+    pub fn clear(&self) {
+        self.inner.classes.lock().unwrap().clear();
+    }
+}
+
+impl Default for PinnedBufferPool {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Round a request up to its size class shift
+fn size_class(len: usize) -> u32 {
+    len.max(1)
+        .next_power_of_two()
+        .trailing_zeros()
+        .max(MIN_CLASS_SHIFT)
+}
+
+/// Pinned buffer leased from a [`PinnedBufferPool`]
+///
+/// Derefs to the first `len` bytes and returns to the pool on drop.
+pub struct PooledPinnedBuffer {
+    buffer: Option<PinnedHostBuffer>,
+    len: usize,
+    class: u32,
+    pool: Arc<PinnedPoolInner>,
+}
+
+impl PooledPinnedBuffer {
+    /// Get the raw host pointer
+    pub fn as_ptr(&self) -> *mut std::ffi::c_void {
+        self.buffer().as_ptr()
+    }
+
+    /// Get the requested length in bytes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Check whether the requested length is zero
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Get the underlying pinned allocation (sized to the full class)
+    pub fn buffer(&self) -> &PinnedHostBuffer {
+        self.buffer.as_ref().expect("buffer present until drop")
+    }
+
+    /// View the leased bytes as typed elements
+    pub fn as_slice_of<T: Pod>(&self) -> &[T] {
+        crate::cuda::cast_slice(self)
+    }
+
+    /// View the leased bytes as mutable typed elements
+    pub fn as_mut_slice_of<T: Pod>(&mut self) -> &mut [T] {
+        crate::cuda::cast_slice_mut(self)
+    }
+}
+
+impl std::ops::Deref for PooledPinnedBuffer {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        &self.buffer().as_slice()[..self.len]
+    }
+}
+
+impl std::ops::DerefMut for PooledPinnedBuffer {
+    fn deref_mut(&mut self) -> &mut [u8] {
+        let len = self.len;
+        &mut self
+            .buffer
+            .as_mut()
+            .expect("buffer present until drop")
+            .as_mut_slice()[..len]
+    }
+}
+
+impl Drop for PooledPinnedBuffer {
+    fn drop(&mut self) {
+        if let Some(buffer) = self.buffer.take() {
+            let mut classes = self.pool.classes.lock().unwrap();
+            let class = self.class as usize;
+            if classes.len() <= class {
+                classes.resize_with(class + 1, Vec::new);
+            }
+            if classes[class].len() < self.pool.max_cached_per_class {
+                classes[class].push(buffer);
+            }
+        }
+    }
+}
+
+/// Smallest device allocation bucket
+const MIN_DEVICE_BUCKET: usize = 512;
+
+/// Above this size buckets grow linearly instead of by powers of two
+const LARGE_DEVICE_BUCKET: usize = 1 << 20;
+
+/// Statistics reported by a [`DeviceAllocator`]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct AllocatorStats {
+    /// Bytes currently handed out to callers
+    pub bytes_in_use: usize,
+    /// Largest value `bytes_in_use` has reached
+    pub high_water_mark: usize,
+    /// Bytes held in free lists, ready for reuse
+    pub cached_bytes: usize,
+    /// Allocations served without calling into the driver
+    pub hits: u64,
+    /// Allocations that had to call into the driver
+    pub misses: u64,
+}
+
+impl AllocatorStats {
+    /// Fraction of allocations served from the cache
+    pub fn hit_rate(&self) -> f64 {
+        let total = self.hits + self.misses;
+        if total == 0 {
+            return 0.0;
+        }
+        self.hits as f64 / total as f64
+    }
+}
+
+/// Source of device memory for [`DeviceBuffer`](crate::cuda::DeviceBuffer)
+pub trait DeviceAllocator: Send + Sync {
+    /// Allocate at least `size` bytes of device memory
+    fn allocate(&self, size: usize) -> Result<*mut c_void>;
+
+    /// Return memory obtained from [`DeviceAllocator::allocate`]
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must come from `allocate` on this allocator with the same `size`,
+    /// and no queued GPU work may still access it unless the allocator is
+    /// stream-ordered.
+    unsafe fn deallocate(&self, ptr: *mut c_void, size: usize);
+
+    /// Snapshot of allocator statistics
+    fn stats(&self) -> AllocatorStats;
+}
+
+/// Shared counters behind [`AllocatorStats`]
+#[derive(Default)]
+struct AllocatorCounters {
+    bytes_in_use: AtomicUsize,
+    high_water_mark: AtomicUsize,
+    hits: AtomicU64,
+    misses: AtomicU64,
+}
+
+impl AllocatorCounters {
+    fn record_in_use(&self, size: usize) {
+        let in_use = self.bytes_in_use.fetch_add(size, Ordering::Relaxed) + size;
+        self.high_water_mark.fetch_max(in_use, Ordering::Relaxed);
+    }
+
+    fn record_allocate(&self, size: usize, hit: bool) {
+        self.record_in_use(size);
+        if hit {
+            self.hits.fetch_add(1, Ordering::Relaxed);
+        } else {
+            self.misses.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+
+    fn record_deallocate(&self, size: usize) {
+        self.bytes_in_use.fetch_sub(size, Ordering::Relaxed);
+    }
+
+    fn snapshot(&self, cached_bytes: usize) -> AllocatorStats {
+        AllocatorStats {
+            bytes_in_use: self.bytes_in_use.load(Ordering::Relaxed),
+            high_water_mark: self.high_water_mark.load(Ordering::Relaxed),
+            cached_bytes,
+            hits: self.hits.load(Ordering::Relaxed),
+            misses: self.misses.load(Ordering::Relaxed),
+        }
+    }
+}
+
+/// Allocator that calls `cudaMalloc`/`cudaFree` every time
+#[derive(Default)]
+pub struct CudaAllocator {
+    counters: AllocatorCounters,
+}
+
+impl CudaAllocator {
+    /// Create a pass-through allocator
+    pub fn new() -> Self {
+        Self::default()
+    }
+}
+
+impl DeviceAllocator for CudaAllocator {
+    fn allocate(&self, size: usize) -> Result<*mut c_void> {
+        let ptr = cuda::device_malloc(size)?;
+        self.counters.record_allocate(size, false);
+        Ok(ptr)
+    }
+
+    unsafe fn deallocate(&self, ptr: *mut c_void, size: usize) {
+        cuda::device_free(ptr);
+        self.counters.record_deallocate(size);
+    }
+
+    fn stats(&self) -> AllocatorStats {
+        self.counters.snapshot(0)
+    }
+}
+
+/// Size-bucketed caching allocator
+///
+/// Freed blocks are kept in per-bucket free lists and handed back out
+/// without touching the driver. Buckets are powers of two up to 1 MiB and
+/// 1 MiB multiples above that. Callers must synchronize the stream that used
+/// a buffer before dropping it, since a cached block can be reused at once.
+/// Blocks are cached per device and only handed out on the device that is
+/// current when they are requested.
+pub struct CachingDeviceAllocator {
+    // (device, bucket size) -> free device pointers (stored as usize so the map is Send)
+    free: Mutex<HashMap<(i32, usize), Vec<usize>>>,
+    // Bytes held in `free`; only changed with its lock held, read without it for stats
+    cached_bytes: AtomicUsize,
+    max_cached_bytes: usize,
+    counters: AllocatorCounters,
+}
+
+impl CachingDeviceAllocator {
+    /// Create a caching allocator with no cache limit
+    pub fn new() -> Self {
+        Self::with_max_cached_bytes(usize::MAX)
+    }
+
+    /// Create a caching allocator that frees blocks once the cache exceeds `max_cached_bytes`
+    pub fn with_max_cached_bytes(max_cached_bytes: usize) -> Self {
+        CachingDeviceAllocator {
+            free: Mutex::new(HashMap::new()),
+            cached_bytes: AtomicUsize::new(0),
+            max_cached_bytes,
+            counters: AllocatorCounters::default(),
+        }
+    }
+
+    /// Release every cached block back to the driver
+    pub fn empty_cache(&self) {
+        let drained: Vec<((i32, usize), Vec<usize>)> = {
+            let mut free = self.free.lock().unwrap();
+            self.cached_bytes.store(0, Ordering::Relaxed);
+            free.drain().collect()
+        };
+        for ((device, _), ptrs) in drained {
+            let _device = cuda::DeviceGuard::new(device);
+            for ptr in ptrs {
+                cuda::device_free(ptr as *mut c_void);
+            }
+        }
+    }
+}
+
+impl Default for CachingDeviceAllocator {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Round a device request up to its bucket size
+fn device_bucket(size: usize) -> usize {
+    if size <= MIN_DEVICE_BUCKET {
+        MIN_DEVICE_BUCKET
+    } else if size <= LARGE_DEVICE_BUCKET {
+        size.next_power_of_two()
+    } else {
+        size.div_ceil(LARGE_DEVICE_BUCKET) * LARGE_DEVICE_BUCKET
+    }
+}
+
+impl DeviceAllocator for CachingDeviceAllocator {
+    fn allocate(&self, size: usize) -> Result<*mut c_void> {
+        let bucket = device_bucket(size);
+        let device = cuda::current_device()?;
+
+        let cached = {
+            let mut free = self.free.lock().unwrap();
+            let cached = free.get_mut(&(device, bucket)).and_then(|ptrs| ptrs.pop());
+            if cached.is_some() {
+                self.cached_bytes.fetch_sub(bucket, Ordering::Relaxed);
+            }
+            cached
+        };
+
+        if let Some(ptr) = cached {
+            self.counters.record_allocate(bucket, true);
+            return Ok(ptr as *mut c_void);
+        }
+
+        let ptr = match cuda::device_malloc(bucket) {
+            Ok(ptr) => ptr,
+            Err(Error::Cuda(_)) | Err(Error::OutOfMemory(_)) => {
+                // Give cached blocks back to the driver and retry once
+                self.empty_cache();
+                cuda::device_malloc(bucket)?
+            }
+            Err(e) => return Err(e),
+        };
+
+        self.counters.record_allocate(bucket, false);
+        Ok(ptr)
+    }
+
+    unsafe fn deallocate(&self, ptr: *mut c_void, size: usize) {
+        let bucket = device_bucket(size);
+        self.counters.record_deallocate(bucket);
+
+        // DeviceBuffer makes the owning device current before giving memory back
+        let device = match cuda::current_device() {
+            Ok(device) => device,
+            Err(_) => {
+                cuda::device_free(ptr);
+                return;
+            }
+        };
+
+        // Checking the limit and caching the block is one step under the lock
+        let mut free = self.free.lock().unwrap();
+        let cached_bytes = self.cached_bytes.load(Ordering::Relaxed);
+        if cached_bytes.saturating_add(bucket) > self.max_cached_bytes {
+            drop(free);
+            cuda::device_free(ptr);
+            return;
+        }
+        free.entry((device, bucket)).or_default().push(ptr as usize);
+        self.cached_bytes
+            .store(cached_bytes + bucket, Ordering::Relaxed);
+    }
+
+    fn stats(&self) -> AllocatorStats {
+        self.counters
+            .snapshot(self.cached_bytes.load(Ordering::Relaxed))
+    }
+}
+
+impl Drop for CachingDeviceAllocator {
+    fn drop(&mut self) {
+        self.empty_cache();
+    }
+}
+
+/// Stream-ordered allocator built on `cudaMallocAsync` and the device memory pool
+///
+/// Allocation and release are queued on `stream`, so buffers can be dropped
+/// while work that uses them is still in flight. The driver pool does the
+/// caching; hits and misses are not visible and are not reported.
+pub struct StreamOrderedAllocator {
+    stream: Arc<CudaStream>,
+    counters: AllocatorCounters,
+}
+
+impl StreamOrderedAllocator {
+    /// Create an allocator that orders allocations on `stream`
+    pub fn new(stream: Arc<CudaStream>) -> Self {
+        StreamOrderedAllocator {
+            stream,
+            counters: AllocatorCounters::default(),
+        }
+    }
+
+    /// Create an allocator and keep up to `release_threshold` bytes reserved in the pool
+    ///
+    /// Without a threshold the driver returns pool memory to the OS at every
+    /// synchronization, which defeats the purpose of pooling.
+    pub fn with_release_threshold(stream: Arc<CudaStream>, release_threshold: u64) -> Result<Self> {
+        let result = unsafe {
+            trtx_cuda_mem_pool_set_release_threshold(release_threshold, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(Self::new(stream))
+    }
+
+    /// Get the stream allocations are ordered on
+    pub fn stream(&self) -> &Arc<CudaStream> {
+        &self.stream
+    }
+}
+
+impl DeviceAllocator for StreamOrderedAllocator {
+    fn allocate(&self, size: usize) -> Result<*mut c_void> {
+        let mut ptr: *mut c_void = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_malloc_async(
+                &mut ptr,
+                size,
+                self.stream.as_raw(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        self.counters.record_in_use(size);
+        Ok(ptr)
+    }
+
+    unsafe fn deallocate(&self, ptr: *mut c_void, size: usize) {
+        let _ = trtx_cuda_free_async(ptr, self.stream.as_raw(), std::ptr::null_mut(), 0);
+        self.counters.record_deallocate(size);
+    }
+
+    fn stats(&self) -> AllocatorStats {
+        self.counters.snapshot(0)
+    }
+}
+
+/// Process-wide caching allocator used by the executor
+pub fn default_device_allocator() -> &'static Arc<dyn DeviceAllocator> {
+    static DEFAULT: OnceLock<Arc<dyn DeviceAllocator>> = OnceLock::new();
+    DEFAULT.get_or_init(|| Arc::new(CachingDeviceAllocator::new()))
+}
+
+/// Fixed set of equally sized device blocks for context activation memory
+///
+/// Contexts created with [`AllocationStrategy::UserManaged`](crate::runtime::AllocationStrategy)
+/// lease a block only while they have work in flight. One arena can serve
+/// contexts of several engines as long as the block size covers each
+/// engine's [`get_device_memory_size`](crate::CudaEngine::get_device_memory_size).
+pub struct ScratchArena {
+    blocks: SlotPool<DeviceBuffer>,
+    block_size: usize,
+}
+
+impl ScratchArena {
+    /// Allocate `count` blocks of `block_size` bytes from `allocator`
+    pub fn new(
+        block_size: usize,
+        count: usize,
+        allocator: &Arc<dyn DeviceAllocator>,
+    ) -> Result<Self> {
+        if count == 0 {
+            return Err(Error::InvalidArgument(
+                "Scratch arena needs at least one block".to_string(),
+            ));
+        }
+
+        let blocks = (0..count)
+            .map(|_| DeviceBuffer::new_in(block_size.max(1), allocator))
+            .collect::<Result<Vec<_>>>()?;
+
+        Ok(ScratchArena {
+            blocks: SlotPool::new(blocks),
+            block_size,
+        })
+    }
+
+    /// Get the size of each block in bytes
+    pub fn block_size(&self) -> usize {
+        self.block_size
+    }
+
+    /// Number of blocks in the arena
+    pub fn len(&self) -> usize {
+        self.blocks.len()
+    }
+
+    /// Whether the arena has no blocks (never true once constructed)
+    pub fn is_empty(&self) -> bool {
+        self.blocks.len() == 0
+    }
+
+    /// Number of blocks not currently leased
+    pub fn available(&self) -> usize {
+        self.blocks.available()
+    }
+
+    /// Lease a block, waiting if all are in use
+    ///
+    /// The caller must make sure GPU work using the block has finished
+    /// before dropping the lease.
+    pub fn acquire(&self) -> Lease<'_, DeviceBuffer> {
+        self.blocks.acquire()
+    }
+
+    /// Lease a block if one is free
+    pub fn try_acquire(&self) -> Option<Lease<'_, DeviceBuffer>> {
+        self.blocks.try_acquire()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_size_class() {
+        assert_eq!(size_class(0), MIN_CLASS_SHIFT);
+        assert_eq!(size_class(4096), 12);
+        assert_eq!(size_class(4097), 13);
+        assert_eq!(size_class(1 << 20), 20);
+    }
+
+    #[test]
+    fn test_pinned_pool_reuse() {
+        let pool = PinnedBufferPool::new();
+
+        let first_ptr = {
+            let mut buffer = pool.acquire(100).unwrap();
+            assert_eq!(buffer.len(), 100);
+            buffer.fill(1);
+            buffer.as_ptr()
+        };
+        assert_eq!(pool.cached_bytes(), 4096);
+
+        // Same class is served from the free list
+        let buffer = pool.acquire(200).unwrap();
+        assert_eq!(buffer.as_ptr(), first_ptr);
+        assert_eq!(pool.cached_bytes(), 0);
+        drop(buffer);
+
+        pool.clear();
+        assert_eq!(pool.cached_bytes(), 0);
+    }
+
+    #[test]
+    fn test_device_bucket() {
+        assert_eq!(device_bucket(1), 512);
+        assert_eq!(device_bucket(513), 1024);
+        assert_eq!(device_bucket(LARGE_DEVICE_BUCKET), LARGE_DEVICE_BUCKET);
+        assert_eq!(
+            device_bucket(LARGE_DEVICE_BUCKET + 1),
+            2 * LARGE_DEVICE_BUCKET
+        );
+        assert_eq!(
+            device_bucket(3 * LARGE_DEVICE_BUCKET - 5),
+            3 * LARGE_DEVICE_BUCKET
+        );
+    }
+
+    #[test]
+    fn test_caching_allocator_reuse() {
+        let allocator: Arc<dyn DeviceAllocator> = Arc::new(CachingDeviceAllocator::new());
+
+        let first = crate::cuda::DeviceBuffer::new_in(1000, &allocator).unwrap();
+        let first_ptr = first.as_ptr();
+        drop(first);
+
+        let stats = allocator.stats();
+        assert_eq!(stats.bytes_in_use, 0);
+        assert_eq!(stats.cached_bytes, 1024);
+        assert_eq!(stats.misses, 1);
+
+        // Same bucket comes back from the free list
+        let second = crate::cuda::DeviceBuffer::new_in(900, &allocator).unwrap();
+        assert_eq!(second.as_ptr(), first_ptr);
+
+        let stats = allocator.stats();
+        assert_eq!(stats.bytes_in_use, 1024);
+        assert_eq!(stats.high_water_mark, 1024);
+        assert_eq!(stats.hits, 1);
+        assert_eq!(stats.hit_rate(), 0.5);
+    }
+
+    #[test]
+    fn test_caching_allocator_concurrent_limit() {
+        let allocator = Arc::new(CachingDeviceAllocator::with_max_cached_bytes(4096));
+        std::thread::scope(|scope| {
+            for _ in 0..4 {
+                scope.spawn(|| {
+                    for i in 0..200 {
+                        let ptr = allocator.allocate(1024).unwrap();
+                        unsafe { allocator.deallocate(ptr, 1024) };
+                        if i % 16 == 0 {
+                            allocator.empty_cache();
+                        }
+                        assert!(allocator.stats().cached_bytes <= 4096);
+                    }
+                });
+            }
+        });
+
+        // The counter still matches the blocks in the free lists
+        let cached: usize = allocator.free.lock().unwrap().values().map(Vec::len).sum();
+        assert_eq!(allocator.stats().cached_bytes, cached * 1024);
+        allocator.empty_cache();
+        assert_eq!(allocator.stats().cached_bytes, 0);
+    }
+
+    #[test]
+    fn test_stream_ordered_allocator() {
+        let stream = Arc::new(CudaStream::new().unwrap());
+        let allocator: Arc<dyn DeviceAllocator> =
+            Arc::new(StreamOrderedAllocator::with_release_threshold(stream, u64::MAX).unwrap());
+
+        let mut buffer = crate::cuda::DeviceBuffer::new_in(64, &allocator).unwrap();
+        buffer.copy_from_host(&[3u8; 64]).unwrap();
+        assert_eq!(allocator.stats().bytes_in_use, 64);
+        drop(buffer);
+        assert_eq!(allocator.stats().bytes_in_use, 0);
+        assert_eq!(allocator.stats().high_water_mark, 64);
+    }
+}
@@ -1,33 +1,67 @@
 //! ONNX model parser for TensorRT
+//!
+//! Models over 2 GB keep their weights in external data files next to the
+//! model. [`OnnxParser::parse_mapped`] memory-maps those files and hands the
+//! initializers to TensorRT in place, so they are never copied into a heap
+//! buffer first.
 
 use crate::builder::NetworkDefinition;
 use crate::error::{Error, Result};
 use crate::logger::Logger;
+use std::ffi::CString;
+use std::path::Path;
 use trtx_sys::*;
 
 /// ONNX model parser
+///
+/// The network references weights owned by the parser, so the parser must
+/// stay alive until the network has been built.
 pub struct OnnxParser {
     inner: *mut TrtxOnnxParser,
 }
 
+/// A part of a model that TensorRT either supports or does not
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Subgraph {
+    /// Whether TensorRT can run every node of this subgraph
+    pub supported: bool,
+    /// Indices of the subgraph's nodes in the ONNX graph
+    pub nodes: Vec<i64>,
+}
+
+/// How much of a model TensorRT supports, from [`OnnxParser::supports_model`]
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ModelSupport {
+    /// Whether the whole model is supported
+    pub supported: bool,
+    /// The model split into supported and unsupported subgraphs
+    pub subgraphs: Vec<Subgraph>,
+}
+
+fn path_cstring(path: &Path) -> Result<CString> {
+    let path_str = path.to_str().ok_or_else(|| {
+        Error::InvalidArgument(format!("Model path is not valid UTF-8: {}", path.display()))
+    })?;
+    Ok(CString::new(path_str)?)
+}
+
 impl OnnxParser {
     /// Create a new ONNX parser for the given network
     pub fn new(network: &NetworkDefinition, logger: &Logger) -> Result<Self> {
         let mut parser_ptr: *mut TrtxOnnxParser = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_onnx_parser_create(
                 network.as_ptr(),
                 logger.as_ptr(),
                 &mut parser_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(OnnxParser { inner: parser_ptr })
@@ -35,24 +69,149 @@ impl OnnxParser {
 
     /// Parse an ONNX model from bytes
     pub fn parse(&self, model_bytes: &[u8]) -> Result<()> {
-        let mut error_msg = [0i8; 1024];
+        self.parse_bytes(model_bytes, None)
+    }
+
+    /// Parse ONNX bytes whose external data files live next to `model_path`
+    pub fn parse_with_path<P: AsRef<Path>>(&self, model_bytes: &[u8], model_path: P) -> Result<()> {
+        self.parse_bytes(model_bytes, Some(&path_cstring(model_path.as_ref())?))
+    }
 
+    fn parse_bytes(&self, model_bytes: &[u8], model_path: Option<&CString>) -> Result<()> {
         let result = unsafe {
             trtx_onnx_parser_parse(
                 self.inner,
                 model_bytes.as_ptr() as *const std::ffi::c_void,
                 model_bytes.len(),
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                model_path.map_or(std::ptr::null(), |path| path.as_ptr()),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(())
     }
+
+    /// Parse a model file, letting TensorRT read it and its external data
+    pub fn parse_from_file<P: AsRef<Path>>(&self, path: P) -> Result<()> {
+        let path_cstr = path_cstring(path.as_ref())?;
+
+        let result = unsafe {
+            trtx_onnx_parser_parse_from_file(
+                self.inner,
+                path_cstr.as_ptr(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Parse a model file with its external data memory-mapped and loaded in parallel
+    ///
+    /// Initializers stored in external data files (resolved relative to the
+    /// model's directory) are faulted in on `threads` threads, one per core
+    /// if 0, and passed to TensorRT without a copy. The mappings are held
+    /// by the parser until it is dropped.
+    pub fn parse_mapped<P: AsRef<Path>>(&self, path: P, threads: usize) -> Result<()> {
+        let path_cstr = path_cstring(path.as_ref())?;
+        let threads = i32::try_from(threads).unwrap_or(i32::MAX);
+
+        let result = unsafe {
+            trtx_onnx_parser_parse_mapped(
+                self.inner,
+                path_cstr.as_ptr(),
+                threads,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Check which parts of a model TensorRT supports, without building anything
+    ///
+    /// `model_path` locates external data, as for [`parse_with_path`](Self::parse_with_path).
+    pub fn supports_model(
+        &self,
+        model_bytes: &[u8],
+        model_path: Option<&Path>,
+    ) -> Result<ModelSupport> {
+        let model_path = model_path.map(path_cstring).transpose()?;
+        let mut supported = 0;
+
+        let result = unsafe {
+            trtx_onnx_parser_supports_model(
+                self.inner,
+                model_bytes.as_ptr() as *const std::ffi::c_void,
+                model_bytes.len(),
+                model_path
+                    .as_ref()
+                    .map_or(std::ptr::null(), |path| path.as_ptr()),
+                &mut supported,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        let mut count = 0;
+        let result = unsafe { trtx_onnx_parser_get_nb_subgraphs(self.inner, &mut count) };
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        let subgraphs = (0..count)
+            .map(|index| {
+                let mut supported = 0;
+                let mut nodes: *const i64 = std::ptr::null();
+                let mut nb_nodes = 0;
+                let result = unsafe {
+                    trtx_onnx_parser_get_subgraph(
+                        self.inner,
+                        index,
+                        &mut supported,
+                        &mut nodes,
+                        &mut nb_nodes,
+                    )
+                };
+                if result != TRTX_SUCCESS as i32 {
+                    return Err(Error::last_ffi(result));
+                }
+                let nodes = if nodes.is_null() {
+                    Vec::new()
+                } else {
+                    unsafe { std::slice::from_raw_parts(nodes, nb_nodes.max(0) as usize) }.to_vec()
+                };
+                Ok(Subgraph {
+                    supported: supported != 0,
+                    nodes,
+                })
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        Ok(ModelSupport {
+            supported: supported != 0,
+            subgraphs,
+        })
+    }
 }
 
 impl Drop for OnnxParser {
@@ -74,6 +233,31 @@ mod tests {
     use crate::Builder;
     use crate::Logger;
 
+    #[test]
+    fn test_onnx_parser_files_and_support() {
+        let logger = Logger::stderr().unwrap();
+        let builder = Builder::new(&logger).unwrap();
+        let network = builder
+            .create_network(network_flags::EXPLICIT_BATCH)
+            .unwrap();
+        let parser = OnnxParser::new(&network, &logger).unwrap();
+
+        let path = std::env::temp_dir().join(format!("trtx-model-{}.onnx", std::process::id()));
+        std::fs::write(&path, [0u8; 100]).unwrap();
+        parser.parse_from_file(&path).unwrap();
+        parser.parse_mapped(&path, 4).unwrap();
+        parser.parse_with_path(&[0u8; 100], &path).unwrap();
+        std::fs::remove_file(&path).unwrap();
+        assert!(parser.parse_mapped(&path, 0).is_err());
+
+        let support = parser.supports_model(&[0u8; 100], None).unwrap();
+        assert!(!support.supported);
+        assert_eq!(support.subgraphs.len(), 2);
+        assert!(support.subgraphs[0].supported);
+        assert_eq!(support.subgraphs[0].nodes, vec![0, 1]);
+        assert!(!support.subgraphs[1].supported);
+    }
+
     #[test]
     #[ignore] // Requires TensorRT runtime initialization (can hang in test context)
     fn test_onnx_parser_creation() {
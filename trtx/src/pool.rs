@@ -0,0 +1,678 @@
+//! Pools of execution contexts for concurrent inference on one engine
+//!
+//! An [`ExecutionPool`] creates several execution contexts for a shared
+//! [`CudaEngine`], each with its own CUDA stream and preallocated device
+//! buffers for every IO tensor, and hands them out to worker threads.
+//! Contexts are taken from and returned to a lock-free free-list, so
+//! acquiring one is a single compare-and-swap when any is idle; only callers
+//! of [`ExecutionPool::acquire`] that find the pool empty block.
+//!
+//! With [`ExecutionPool::with_scratch_arena`] the contexts own no activation
+//! memory of their own: each lease also takes a block from a shared
+//! [`ScratchArena`], so eight contexts with two blocks use a quarter of the
+//! activation VRAM, and one arena can serve several models.
+//!
+//! ```rust,no_run
+//! use std::sync::Arc;
+//! use trtx::{ExecutionPool, Logger, Runtime};
+//!
+//! # fn main() -> trtx::Result<()> {
+//! # let logger = Logger::stderr()?;
+//! # let runtime = Runtime::new(&logger)?;
+//! # let plan = std::fs::read("model.engine")?;
+//! let engine = Arc::new(runtime.deserialize_cuda_engine(&plan)?);
+//! let pool = ExecutionPool::new(engine, 4)?;
+//!
+//! std::thread::scope(|s| {
+//!     for _ in 0..8 {
+//!         s.spawn(|| -> trtx::Result<()> {
+//!             let mut lease = pool.acquire()?;
+//!             // ... copy inputs into lease.buffer("input") on lease.stream() ...
+//!             unsafe { lease.enqueue()? };
+//!             lease.stream().synchronize()
+//!         });
+//!     }
+//! });
+//! # Ok(())
+//! # }
+//! ```
+
+use crate::cuda::{CudaStream, DeviceBuffer};
+use crate::error::{Error, Result};
+use crate::memory::{default_device_allocator, DeviceAllocator, ScratchArena};
+use crate::profiler::Profiler;
+use crate::runtime::{AllocationStrategy, CudaEngine, CudaGraphStats, ExecutionContext};
+use crate::tensor::{ProfileSelector, TensorInfo};
+use std::cell::UnsafeCell;
+use std::future::Future;
+use std::marker::PhantomData;
+use std::ops::{Deref, DerefMut};
+use std::pin::Pin;
+use std::sync::atomic::{AtomicU32, AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+use std::task::{Context, Poll, Waker};
+
+/// End-of-list marker in [`SlotPool`]'s index links
+const NIL: u32 = u32::MAX;
+
+/// Fixed set of items handed out exclusively through a lock-free free-list
+///
+/// The free-list is a Treiber stack of item indices. Its head packs the
+/// index of the top item with a tag that is bumped on every update, so a
+/// stale compare-and-swap cannot succeed after the same index was popped and
+/// pushed again (the ABA problem).
+pub(crate) struct SlotPool<T> {
+    items: Box<[UnsafeCell<T>]>,
+    next: Box<[AtomicU32]>,
+    // (tag << 32) | index of the first free item
+    head: AtomicU64,
+    available: AtomicUsize,
+    // Only touched when the pool runs dry
+    waiters: AtomicUsize,
+    wait_lock: Mutex<()>,
+    released: Condvar,
+    // Tasks of `acquire_async` callers that found the pool empty
+    async_waiters: AtomicUsize,
+    wakers: Mutex<Vec<Waker>>,
+}
+
+// SAFETY: an item is only reachable through the lease of whoever popped its
+// index, so items are never shared between threads, only moved.
+unsafe impl<T: Send> Send for SlotPool<T> {}
+unsafe impl<T: Send> Sync for SlotPool<T> {}
+
+impl<T> SlotPool<T> {
+    pub(crate) fn new(items: Vec<T>) -> Self {
+        assert!(items.len() < NIL as usize, "too many pool items");
+        let len = items.len();
+        let next = (0..len)
+            .map(|i| AtomicU32::new(if i + 1 < len { i as u32 + 1 } else { NIL }))
+            .collect();
+        let head = if len == 0 { NIL } else { 0 };
+
+        SlotPool {
+            items: items.into_iter().map(UnsafeCell::new).collect(),
+            next,
+            head: AtomicU64::new(head as u64),
+            available: AtomicUsize::new(len),
+            waiters: AtomicUsize::new(0),
+            wait_lock: Mutex::new(()),
+            released: Condvar::new(),
+            async_waiters: AtomicUsize::new(0),
+            wakers: Mutex::new(Vec::new()),
+        }
+    }
+
+    /// Number of items in the pool
+    pub(crate) fn len(&self) -> usize {
+        self.items.len()
+    }
+
+    /// Number of items not currently leased
+    pub(crate) fn available(&self) -> usize {
+        self.available.load(Ordering::Relaxed)
+    }
+
+    /// Lease an item if one is free, without blocking
+    pub(crate) fn try_acquire(&self) -> Option<Lease<'_, T>> {
+        self.pop().map(|index| Lease {
+            pool: self,
+            index,
+            _item: PhantomData,
+        })
+    }
+
+    /// Lease an item, waiting for one to be released if all are taken
+    pub(crate) fn acquire(&self) -> Lease<'_, T> {
+        if let Some(lease) = self.try_acquire() {
+            return lease;
+        }
+
+        // Registering as a waiter before re-checking pairs with `release`
+        // checking for waiters after pushing, so a wakeup cannot be lost
+        self.waiters.fetch_add(1, Ordering::SeqCst);
+        let mut guard = self.wait_lock.lock().unwrap();
+        let index = loop {
+            if let Some(index) = self.pop() {
+                break index;
+            }
+            guard = self.released.wait(guard).unwrap();
+        };
+        drop(guard);
+        self.waiters.fetch_sub(1, Ordering::SeqCst);
+
+        Lease {
+            pool: self,
+            index,
+            _item: PhantomData,
+        }
+    }
+
+    /// Lease an item, yielding to the executor while all are taken
+    pub(crate) fn acquire_async(&self) -> AcquireFuture<'_, T> {
+        AcquireFuture { pool: self }
+    }
+
+    fn pop(&self) -> Option<usize> {
+        let mut head = self.head.load(Ordering::SeqCst);
+        loop {
+            let index = head as u32;
+            if index == NIL {
+                return None;
+            }
+            let next = self.next[index as usize].load(Ordering::Relaxed);
+            let new_head = (((head >> 32) + 1) << 32) | next as u64;
+            match self.head.compare_exchange_weak(
+                head,
+                new_head,
+                Ordering::SeqCst,
+                Ordering::SeqCst,
+            ) {
+                Ok(_) => {
+                    self.available.fetch_sub(1, Ordering::Relaxed);
+                    return Some(index as usize);
+                }
+                Err(current) => head = current,
+            }
+        }
+    }
+
+    fn release(&self, index: usize) {
+        let mut head = self.head.load(Ordering::Relaxed);
+        loop {
+            self.next[index].store(head as u32, Ordering::Relaxed);
+            let new_head = (((head >> 32) + 1) << 32) | index as u64;
+            match self.head.compare_exchange_weak(
+                head,
+                new_head,
+                Ordering::SeqCst,
+                Ordering::Relaxed,
+            ) {
+                Ok(_) => break,
+                Err(current) => head = current,
+            }
+        }
+        self.available.fetch_add(1, Ordering::Relaxed);
+
+        if self.waiters.load(Ordering::SeqCst) > 0 {
+            // Taking the lock orders this notify after the waiter's re-check
+            drop(self.wait_lock.lock().unwrap());
+            self.released.notify_one();
+        }
+
+        if self.async_waiters.load(Ordering::SeqCst) > 0 {
+            // Wake every task: some wakers may belong to futures that have
+            // since acquired an item or been dropped, so waking just one
+            // could strand a live waiter
+            let wakers = std::mem::take(&mut *self.wakers.lock().unwrap());
+            self.async_waiters.fetch_sub(wakers.len(), Ordering::SeqCst);
+            for waker in wakers {
+                waker.wake();
+            }
+        }
+    }
+}
+
+/// Future returned by [`SlotPool::acquire_async`]
+pub(crate) struct AcquireFuture<'p, T> {
+    pool: &'p SlotPool<T>,
+}
+
+impl<'p, T> Future for AcquireFuture<'p, T> {
+    type Output = Lease<'p, T>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Lease<'p, T>> {
+        let pool = self.pool;
+        if let Some(lease) = pool.try_acquire() {
+            return Poll::Ready(lease);
+        }
+
+        {
+            let mut wakers = pool.wakers.lock().unwrap();
+            wakers.push(cx.waker().clone());
+            pool.async_waiters.fetch_add(1, Ordering::SeqCst);
+        }
+        // Re-check after registering, pairing with `release` checking for
+        // waiters after pushing
+        match pool.try_acquire() {
+            Some(lease) => Poll::Ready(lease),
+            None => Poll::Pending,
+        }
+    }
+}
+
+/// Exclusive use of one pool item; returned to the pool on drop
+pub struct Lease<'p, T> {
+    pool: &'p SlotPool<T>,
+    index: usize,
+    // Send/Sync like the `&mut T` this lease stands for
+    _item: PhantomData<&'p mut T>,
+}
+
+impl<T> Deref for Lease<'_, T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        // SAFETY: the popped index is owned by this lease until drop
+        unsafe { &*self.pool.items[self.index].get() }
+    }
+}
+
+impl<T> DerefMut for Lease<'_, T> {
+    fn deref_mut(&mut self) -> &mut T {
+        // SAFETY: as above
+        unsafe { &mut *self.pool.items[self.index].get() }
+    }
+}
+
+impl<T> Drop for Lease<'_, T> {
+    fn drop(&mut self) {
+        self.pool.release(self.index);
+    }
+}
+
+/// An execution context with its own stream and bound IO buffers
+///
+/// Every IO tensor's address is already set to its buffer. Buffers of
+/// dynamic tensors are sized for the largest shapes of optimization profile
+/// 0, so any shape within that profile fits without rebinding.
+pub struct PooledContext {
+    // Declared before the buffers so the context is gone before its memory
+    context: ExecutionContext<'static>,
+    stream: CudaStream,
+    buffers: Vec<(String, DeviceBuffer)>,
+    // Address of the scratch block last set on the context, if user-managed
+    scratch_address: usize,
+}
+
+impl PooledContext {
+    /// Get the stream this context enqueues on
+    pub fn stream(&self) -> &CudaStream {
+        &self.stream
+    }
+
+    /// Get the device buffer bound to `name`
+    pub fn buffer(&self, name: &str) -> Option<&DeviceBuffer> {
+        self.buffers
+            .iter()
+            .find(|(tensor, _)| tensor == name)
+            .map(|(_, buffer)| buffer)
+    }
+
+    /// Get the device buffer bound to `name` for writing
+    pub fn buffer_mut(&mut self, name: &str) -> Option<&mut DeviceBuffer> {
+        self.buffers
+            .iter_mut()
+            .find(|(tensor, _)| tensor == name)
+            .map(|(_, buffer)| buffer)
+    }
+
+    /// Set the shape of a dynamic input (see [`ExecutionContext::set_input_shape`])
+    pub fn set_input_shape(&mut self, name: &str, shape: &[i64]) -> Result<()> {
+        self.context.set_input_shape(name, shape)
+    }
+
+    /// Get a tensor's shape as resolved from the input shapes set so far
+    pub fn get_tensor_shape(&self, name: &str) -> Result<Vec<i64>> {
+        self.context.get_tensor_shape(name)
+    }
+
+    /// Bind a tensor to caller-owned memory instead of the pool's buffer
+    ///
+    /// # Safety
+    ///
+    /// Same contract as [`ExecutionContext::set_tensor_address`]. The memory
+    /// stays bound after the lease is returned, so rebind the pool's buffer
+    /// (its [`DeviceBuffer::as_ptr`]) before dropping the lease.
+    pub unsafe fn set_tensor_address(
+        &mut self,
+        name: &str,
+        data: *mut std::ffi::c_void,
+    ) -> Result<()> {
+        self.context.set_tensor_address(name, data)
+    }
+
+    /// Bind the tensor at `index` in the engine's [`BindingTable`](crate::BindingTable)
+    ///
+    /// # Safety
+    ///
+    /// Same contract as [`set_tensor_address`](Self::set_tensor_address).
+    pub unsafe fn set_tensor_address_at(
+        &mut self,
+        index: usize,
+        data: *mut std::ffi::c_void,
+    ) -> Result<()> {
+        self.context.set_tensor_address_at(index, data)
+    }
+
+    /// Replay enqueues from CUDA graphs (see [`ExecutionContext::enable_cuda_graphs`])
+    pub fn enable_cuda_graphs(&mut self, max_graphs: usize) -> Result<()> {
+        self.context.enable_cuda_graphs(max_graphs)
+    }
+
+    /// Get counters of the context's CUDA graph cache
+    pub fn cuda_graph_stats(&self) -> CudaGraphStats {
+        self.context.cuda_graph_stats()
+    }
+
+    /// Report per-layer times to `profiler` (see [`ExecutionContext::set_profiler`])
+    ///
+    /// The profiler stays attached after the lease is returned.
+    pub fn set_profiler(&mut self, profiler: Arc<dyn Profiler>) -> Result<()> {
+        self.context.set_profiler(profiler)
+    }
+
+    /// Detach the profiler set with [`set_profiler`](Self::set_profiler)
+    pub fn clear_profiler(&mut self) -> Result<()> {
+        self.context.clear_profiler()
+    }
+
+    /// Enqueue inference on this context's stream
+    ///
+    /// # Safety
+    ///
+    /// Inputs must have been written to the bound buffers (or queued on
+    /// [`stream`](Self::stream)) and outputs must not be read before the
+    /// stream is synchronized.
+    pub unsafe fn enqueue(&mut self) -> Result<()> {
+        self.context.enqueue_v3(&self.stream)
+    }
+}
+
+/// Several execution contexts of one engine, shareable across threads
+pub struct ExecutionPool {
+    // Contexts borrow the engine, so they must be dropped first
+    contexts: SlotPool<PooledContext>,
+    scratch: Option<Arc<ScratchArena>>,
+    tensors: Vec<TensorInfo>,
+    engine: Arc<CudaEngine>,
+}
+
+impl ExecutionPool {
+    /// Create `size` contexts with buffers from the default device allocator
+    pub fn new(engine: Arc<CudaEngine>, size: usize) -> Result<Self> {
+        Self::with_allocator(engine, size, default_device_allocator())
+    }
+
+    /// Create `size` contexts with buffers from `allocator`
+    pub fn with_allocator(
+        engine: Arc<CudaEngine>,
+        size: usize,
+        allocator: &Arc<dyn DeviceAllocator>,
+    ) -> Result<Self> {
+        Self::create(engine, size, allocator, None)
+    }
+
+    /// Create `size` contexts that borrow activation memory from `arena`
+    ///
+    /// Each lease holds one arena block for as long as it lives, so at most
+    /// `arena.len()` leases (across every pool sharing the arena) exist at
+    /// once. The arena's blocks must be at least
+    /// [`CudaEngine::get_device_memory_size`] bytes.
+    pub fn with_scratch_arena(
+        engine: Arc<CudaEngine>,
+        size: usize,
+        allocator: &Arc<dyn DeviceAllocator>,
+        arena: Arc<ScratchArena>,
+    ) -> Result<Self> {
+        let required = engine.get_device_memory_size()?;
+        if arena.block_size() < required {
+            return Err(Error::InvalidArgument(format!(
+                "Scratch blocks of {} bytes are smaller than the {required} bytes the engine needs",
+                arena.block_size()
+            )));
+        }
+        Self::create(engine, size, allocator, Some(arena))
+    }
+
+    fn create(
+        engine: Arc<CudaEngine>,
+        size: usize,
+        allocator: &Arc<dyn DeviceAllocator>,
+        scratch: Option<Arc<ScratchArena>>,
+    ) -> Result<Self> {
+        if size == 0 {
+            return Err(Error::InvalidArgument(
+                "Pool needs at least one execution context".to_string(),
+            ));
+        }
+
+        // SAFETY: the Arc keeps the engine at a fixed address, and the pool
+        // holds it until every context has been dropped
+        let engine_ref: &'static CudaEngine = unsafe { &*Arc::as_ptr(&engine) };
+        let tensors = engine.io_tensors()?;
+
+        // Largest shape of each dynamic input in profile 0
+        let max_shapes = tensors
+            .iter()
+            .map(|info| {
+                if !info.is_input() || info.is_static() {
+                    return Ok(None);
+                }
+                engine
+                    .get_profile_shape(&info.name, 0, ProfileSelector::Max)
+                    .map(Some)
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        let contexts = (0..size)
+            .map(|_| {
+                let strategy = match scratch {
+                    Some(_) => AllocationStrategy::UserManaged,
+                    None => AllocationStrategy::Static,
+                };
+                let mut context = engine_ref.create_execution_context_with(strategy)?;
+                for (info, shape) in tensors.iter().zip(&max_shapes) {
+                    if let Some(shape) = shape {
+                        context.set_input_shape(&info.name, shape)?;
+                    }
+                }
+
+                let mut buffers = Vec::with_capacity(tensors.len());
+                for info in &tensors {
+                    let shape = context.get_tensor_shape(&info.name)?;
+                    let size = info.size_in_bytes_for(&shape).ok_or_else(|| {
+                        Error::Runtime(format!(
+                            "Cannot size buffer for '{}' with shape {shape:?}",
+                            info.name
+                        ))
+                    })?;
+                    let buffer = DeviceBuffer::new_in(size.max(1), allocator)?;
+                    unsafe {
+                        context.set_tensor_address(&info.name, buffer.as_ptr())?;
+                    }
+                    buffers.push((info.name.clone(), buffer));
+                }
+
+                Ok(PooledContext {
+                    context,
+                    stream: CudaStream::new()?,
+                    buffers,
+                    scratch_address: 0,
+                })
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        Ok(ExecutionPool {
+            contexts: SlotPool::new(contexts),
+            scratch,
+            tensors,
+            engine,
+        })
+    }
+
+    /// Get the engine the contexts belong to
+    pub fn engine(&self) -> &Arc<CudaEngine> {
+        &self.engine
+    }
+
+    /// Describe the IO tensors in engine order
+    pub fn tensors(&self) -> &[TensorInfo] {
+        &self.tensors
+    }
+
+    /// Number of contexts in the pool
+    pub fn size(&self) -> usize {
+        self.contexts.len()
+    }
+
+    /// Number of contexts not currently leased
+    pub fn available(&self) -> usize {
+        self.contexts.available()
+    }
+
+    /// Get the arena contexts borrow activation memory from, if any
+    pub fn scratch_arena(&self) -> Option<&Arc<ScratchArena>> {
+        self.scratch.as_ref()
+    }
+
+    /// Lease a context, waiting if all are in use (or all scratch blocks are)
+    pub fn acquire(&self) -> Result<ContextLease<'_>> {
+        let context = self.contexts.acquire();
+        let scratch = self.scratch.as_ref().map(|arena| arena.acquire());
+        Self::lease(context, scratch)
+    }
+
+    /// Lease a context if one is idle, along with a scratch block if needed
+    pub fn try_acquire(&self) -> Result<Option<ContextLease<'_>>> {
+        let Some(context) = self.contexts.try_acquire() else {
+            return Ok(None);
+        };
+        let scratch = match &self.scratch {
+            Some(arena) => match arena.try_acquire() {
+                Some(block) => Some(block),
+                None => return Ok(None),
+            },
+            None => None,
+        };
+        Self::lease(context, scratch).map(Some)
+    }
+
+    fn lease<'p>(
+        mut context: Lease<'p, PooledContext>,
+        scratch: Option<Lease<'p, DeviceBuffer>>,
+    ) -> Result<ContextLease<'p>> {
+        if let Some(block) = &scratch {
+            let address = block.as_ptr() as usize;
+            if context.scratch_address != address {
+                // SAFETY: the block is leased for as long as the context is,
+                // and the lease waits for the stream before giving it back
+                unsafe {
+                    context
+                        .context
+                        .set_device_memory(block.as_ptr(), block.size())?;
+                }
+                context.scratch_address = address;
+            }
+        }
+        Ok(ContextLease { context, scratch })
+    }
+}
+
+/// A leased [`PooledContext`], returned to its pool on drop
+///
+/// If the context uses a shared scratch block, dropping the lease first
+/// waits for the context's stream so no other context can reuse the block
+/// while work is still in flight.
+pub struct ContextLease<'p> {
+    context: Lease<'p, PooledContext>,
+    scratch: Option<Lease<'p, DeviceBuffer>>,
+}
+
+impl Deref for ContextLease<'_> {
+    type Target = PooledContext;
+
+    fn deref(&self) -> &PooledContext {
+        &self.context
+    }
+}
+
+impl DerefMut for ContextLease<'_> {
+    fn deref_mut(&mut self) -> &mut PooledContext {
+        &mut self.context
+    }
+}
+
+impl Drop for ContextLease<'_> {
+    fn drop(&mut self) {
+        if self.scratch.is_some() {
+            let _ = self.context.stream.synchronize();
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{Logger, Runtime};
+
+    #[test]
+    fn test_slot_pool_concurrent() {
+        let pool = SlotPool::new(vec![0u64; 3]);
+        std::thread::scope(|s| {
+            for _ in 0..8 {
+                s.spawn(|| {
+                    for _ in 0..1000 {
+                        *pool.acquire() += 1;
+                    }
+                });
+            }
+        });
+
+        assert_eq!(pool.available(), 3);
+        let leases: Vec<_> = (0..3).map(|_| pool.try_acquire().unwrap()).collect();
+        assert!(pool.try_acquire().is_none());
+        assert_eq!(leases.iter().map(|l| **l).sum::<u64>(), 8000);
+    }
+
+    #[test]
+    fn test_execution_pool() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = Arc::new(runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap());
+        let pool = ExecutionPool::new(engine, 2).unwrap();
+        assert_eq!((pool.size(), pool.available()), (2, 2));
+
+        {
+            let mut lease = pool.acquire().unwrap();
+            // Sized for the profile's max batch of 8
+            let input = lease.buffer("input").unwrap();
+            assert_eq!(input.size(), 8 * 3 * 224 * 224 * 4);
+            assert_eq!(lease.buffer("output").unwrap().size(), 8 * 1000 * 4);
+
+            lease.set_input_shape("input", &[2, 3, 224, 224]).unwrap();
+            assert_eq!(lease.get_tensor_shape("output").unwrap(), vec![2, 1000]);
+            unsafe { lease.enqueue().unwrap() };
+            lease.stream().synchronize().unwrap();
+            assert_eq!(pool.available(), 1);
+        }
+        assert_eq!(pool.available(), 2);
+    }
+
+    #[test]
+    fn test_execution_pool_shared_scratch() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = Arc::new(runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap());
+        let allocator = default_device_allocator();
+        let required = engine.get_device_memory_size().unwrap();
+
+        let small = Arc::new(ScratchArena::new(required - 1, 1, allocator).unwrap());
+        assert!(ExecutionPool::with_scratch_arena(engine.clone(), 3, allocator, small).is_err());
+
+        let arena = Arc::new(ScratchArena::new(required, 1, allocator).unwrap());
+        let pool = ExecutionPool::with_scratch_arena(engine, 3, allocator, arena.clone()).unwrap();
+
+        {
+            let mut lease = pool.acquire().unwrap();
+            assert_eq!(arena.available(), 0);
+            // Contexts are idle but the only scratch block is taken
+            assert!(pool.try_acquire().unwrap().is_none());
+            assert_eq!(pool.available(), 2);
+
+            unsafe { lease.enqueue().unwrap() };
+        }
+        assert_eq!((pool.available(), arena.available()), (3, 1));
+        assert!(pool.try_acquire().unwrap().is_some());
+    }
+}
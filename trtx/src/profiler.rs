@@ -0,0 +1,411 @@
+//! Per-layer profiling and engine inspection
+//!
+//! A [`Profiler`] attached with [`ExecutionContext::set_profiler`] receives
+//! the time TensorRT measured for every layer of every enqueue. [`LayerTimings`]
+//! is a ready-made profiler that aggregates those reports across runs.
+//!
+//! An [`EngineInspector`] describes the layers of a built engine, including
+//! the kernels and tactics TensorRT picked when the engine was built with
+//! [`ProfilingVerbosity::Detailed`](crate::builder::ProfilingVerbosity::Detailed),
+//! so hot layers can be lined up with what actually runs:
+//!
+//! ```rust,no_run
+//! use std::sync::Arc;
+//! use trtx::profiler::{LayerInformationFormat, LayerTimings};
+//! # fn main() -> trtx::Result<()> {
+//! # let logger = trtx::Logger::stderr()?;
+//! # let runtime = trtx::Runtime::new(&logger)?;
+//! # let engine = runtime.deserialize_cuda_engine(&std::fs::read("model.engine")?)?;
+//! # let stream = trtx::CudaStream::new()?;
+//! let timings = Arc::new(LayerTimings::new());
+//! let mut context = engine.create_execution_context()?;
+//! context.set_profiler(timings.clone())?;
+//! // ... bind tensors and enqueue a few times ...
+//! # unsafe { context.enqueue_v3(&stream)? };
+//! for layer in timings.hottest(5) {
+//!     println!("{}: {:.3} ms per run", layer.name, layer.mean_ms());
+//! }
+//!
+//! let inspector = engine.create_engine_inspector()?;
+//! println!("{}", inspector.engine_information(LayerInformationFormat::Json)?);
+//! # Ok(())
+//! # }
+//! ```
+//!
+//! [`ExecutionContext::set_profiler`]: crate::ExecutionContext::set_profiler
+
+use crate::error::{Error, Result};
+use crate::runtime::{CudaEngine, ExecutionContext};
+use std::collections::HashMap;
+use std::ffi::{c_void, CStr};
+use std::marker::PhantomData;
+use std::os::raw::c_char;
+use std::sync::{Arc, Mutex};
+use trtx_sys::*;
+
+/// Receives per-layer times from profiled enqueues
+///
+/// Called on the thread that enqueues, once per layer in execution order,
+/// after the layer's work has finished.
+pub trait Profiler: Send + Sync {
+    /// Called with the time one layer took in one enqueue
+    fn report_layer_time(&self, layer_name: &str, ms: f32);
+}
+
+/// Accumulated times of one layer
+#[derive(Debug, Clone, PartialEq)]
+pub struct LayerStats {
+    /// Layer name as reported by TensorRT
+    pub name: String,
+    /// Runs the layer was reported for
+    pub count: u64,
+    /// Sum of the reported times in milliseconds
+    pub total_ms: f64,
+    /// Fastest reported time in milliseconds
+    pub min_ms: f64,
+    /// Slowest reported time in milliseconds
+    pub max_ms: f64,
+}
+
+impl LayerStats {
+    /// Average time per run in milliseconds
+    pub fn mean_ms(&self) -> f64 {
+        if self.count == 0 {
+            0.0
+        } else {
+            self.total_ms / self.count as f64
+        }
+    }
+}
+
+/// Profiler that aggregates per-layer times across runs
+///
+/// Share it through an `Arc` with several contexts to aggregate them all.
+#[derive(Debug, Default)]
+pub struct LayerTimings {
+    state: Mutex<TimingState>,
+}
+
+#[derive(Debug, Default)]
+struct TimingState {
+    // In the order layers were first reported, i.e. execution order
+    layers: Vec<LayerStats>,
+    index: HashMap<String, usize>,
+}
+
+impl LayerTimings {
+    /// Create an empty aggregate
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Get the stats of every layer reported so far, in execution order
+    pub fn layers(&self) -> Vec<LayerStats> {
+        self.lock().layers.clone()
+    }
+
+    /// Get the `n` layers with the highest total time, slowest first
+    pub fn hottest(&self, n: usize) -> Vec<LayerStats> {
+        let mut layers = self.layers();
+        layers.sort_by(|a, b| b.total_ms.total_cmp(&a.total_ms));
+        layers.truncate(n);
+        layers
+    }
+
+    /// Get the total time of all layers in milliseconds
+    pub fn total_ms(&self) -> f64 {
+        self.lock().layers.iter().map(|layer| layer.total_ms).sum()
+    }
+
+    /// Forget everything aggregated so far
+    pub fn reset(&self) {
+        let mut state = self.lock();
+        state.layers.clear();
+        state.index.clear();
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, TimingState> {
+        self.state
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+}
+
+impl Profiler for LayerTimings {
+    fn report_layer_time(&self, layer_name: &str, ms: f32) {
+        let ms = f64::from(ms);
+        let mut state = self.lock();
+        let state = &mut *state;
+
+        match state.index.get(layer_name) {
+            Some(&i) => {
+                let layer = &mut state.layers[i];
+                layer.count += 1;
+                layer.total_ms += ms;
+                layer.min_ms = layer.min_ms.min(ms);
+                layer.max_ms = layer.max_ms.max(ms);
+            }
+            None => {
+                state
+                    .index
+                    .insert(layer_name.to_string(), state.layers.len());
+                state.layers.push(LayerStats {
+                    name: layer_name.to_string(),
+                    count: 1,
+                    total_ms: ms,
+                    min_ms: ms,
+                    max_ms: ms,
+                });
+            }
+        }
+    }
+}
+
+/// Native profiler forwarding to a Rust [`Profiler`]
+pub(crate) struct ProfilerHandle {
+    inner: *mut TrtxProfiler,
+    // Keep the callback target alive
+    _profiler: Box<Arc<dyn Profiler>>,
+}
+
+impl ProfilerHandle {
+    pub(crate) fn new(profiler: Arc<dyn Profiler>) -> Result<Self> {
+        let profiler = Box::new(profiler);
+        let user_data = profiler.as_ref() as *const Arc<dyn Profiler> as *mut c_void;
+
+        let mut profiler_ptr: *mut TrtxProfiler = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_profiler_create(
+                Some(Self::report_callback),
+                user_data,
+                &mut profiler_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(ProfilerHandle {
+            inner: profiler_ptr,
+            _profiler: profiler,
+        })
+    }
+
+    pub(crate) fn as_ptr(&self) -> *mut TrtxProfiler {
+        self.inner
+    }
+
+    /// C callback function that bridges to the Rust trait
+    extern "C" fn report_callback(user_data: *mut c_void, layer_name: *const c_char, ms: f32) {
+        if user_data.is_null() || layer_name.is_null() {
+            return;
+        }
+
+        unsafe {
+            let profiler = &*(user_data as *const Arc<dyn Profiler>);
+            if let Ok(name) = CStr::from_ptr(layer_name).to_str() {
+                profiler.report_layer_time(name, ms);
+            }
+        }
+    }
+}
+
+impl Drop for ProfilerHandle {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            unsafe {
+                trtx_profiler_destroy(self.inner);
+            }
+        }
+    }
+}
+
+/// Output format of [`EngineInspector`] queries
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum LayerInformationFormat {
+    /// One line of text per layer
+    OneLine = 0,
+    /// A JSON object per layer
+    Json = 1,
+}
+
+/// Describes the layers of a built engine
+///
+/// How much is reported depends on the engine's
+/// [`ProfilingVerbosity`](crate::builder::ProfilingVerbosity): layer names
+/// only by default, and precisions, tensor formats and the chosen tactics
+/// with `Detailed`.
+pub struct EngineInspector<'a> {
+    inner: *mut TrtxEngineInspector,
+    _engine: PhantomData<&'a CudaEngine>,
+}
+
+impl<'a> EngineInspector<'a> {
+    pub(crate) fn from_raw(inner: *mut TrtxEngineInspector) -> Self {
+        EngineInspector {
+            inner,
+            _engine: PhantomData,
+        }
+    }
+
+    /// Report the shapes currently set on `context` instead of the profile's ranges
+    pub fn set_execution_context(&mut self, context: &'a ExecutionContext<'_>) -> Result<()> {
+        let result = unsafe {
+            trtx_engine_inspector_set_execution_context(
+                self.inner,
+                context.as_ptr(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Describe one layer; `layer_index` is below [`CudaEngine::get_nb_layers`]
+    pub fn layer_information(
+        &self,
+        layer_index: i32,
+        format: LayerInformationFormat,
+    ) -> Result<String> {
+        let mut info: *const c_char = std::ptr::null();
+
+        let result = unsafe {
+            trtx_engine_inspector_get_layer_information(
+                self.inner,
+                layer_index,
+                format as i32,
+                &mut info,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Self::copy_info(info)
+    }
+
+    /// Describe the whole engine: every layer plus its IO bindings
+    pub fn engine_information(&self, format: LayerInformationFormat) -> Result<String> {
+        let mut info: *const c_char = std::ptr::null();
+
+        let result = unsafe {
+            trtx_engine_inspector_get_engine_information(
+                self.inner,
+                format as i32,
+                &mut info,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Self::copy_info(info)
+    }
+
+    // The inspector reuses its buffer, so the string is copied right away
+    fn copy_info(info: *const c_char) -> Result<String> {
+        if info.is_null() {
+            return Err(Error::Runtime(
+                "Engine inspector returned no data".to_string(),
+            ));
+        }
+        let info = unsafe { CStr::from_ptr(info) };
+        Ok(info.to_str()?.to_string())
+    }
+}
+
+impl Drop for EngineInspector<'_> {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            unsafe {
+                trtx_engine_inspector_destroy(self.inner);
+            }
+        }
+    }
+}
+
+unsafe impl Send for EngineInspector<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::cuda::CudaStream;
+    use crate::{Logger, Runtime};
+
+    #[test]
+    fn test_layer_timings_aggregate() {
+        let timings = LayerTimings::new();
+        timings.report_layer_time("conv", 2.0);
+        timings.report_layer_time("relu", 0.5);
+        timings.report_layer_time("conv", 4.0);
+
+        let layers = timings.layers();
+        assert_eq!(layers.len(), 2);
+        assert_eq!(layers[0].name, "conv");
+        assert_eq!(
+            (layers[0].count, layers[0].min_ms, layers[0].max_ms),
+            (2, 2.0, 4.0)
+        );
+        assert_eq!(layers[0].mean_ms(), 3.0);
+        assert_eq!(timings.total_ms(), 6.5);
+        assert_eq!(timings.hottest(1)[0].name, "conv");
+
+        timings.reset();
+        assert!(timings.layers().is_empty());
+    }
+
+    #[test]
+    fn test_profiled_enqueue_and_inspector() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let stream = CudaStream::new().unwrap();
+
+        let timings = Arc::new(LayerTimings::new());
+        let mut context = engine.create_execution_context().unwrap();
+        context.set_profiler(timings.clone()).unwrap();
+        // Profiled runs bypass graph replay so every layer keeps reporting
+        context.enable_cuda_graphs(1).unwrap();
+        for _ in 0..3 {
+            unsafe { context.enqueue_v3(&stream).unwrap() };
+        }
+        let layers = timings.layers();
+        assert_eq!(layers.len() as i32, engine.get_nb_layers().unwrap());
+        assert!(layers.iter().all(|layer| layer.count == 3));
+        assert_eq!(context.cuda_graph_stats().replays, 0);
+
+        context.clear_profiler().unwrap();
+        unsafe { context.enqueue_v3(&stream).unwrap() };
+        assert_eq!(timings.layers()[0].count, 3);
+
+        let mut inspector = engine.create_engine_inspector().unwrap();
+        inspector.set_execution_context(&context).unwrap();
+        let layer = inspector
+            .layer_information(0, LayerInformationFormat::Json)
+            .unwrap();
+        assert!(layer.contains(&format!("\"Name\":\"{}\"", layers[0].name)));
+        let engine_info = inspector
+            .engine_information(LayerInformationFormat::Json)
+            .unwrap();
+        assert!(engine_info.starts_with("{\"Layers\":["));
+        assert!(inspector
+            .layer_information(99, LayerInformationFormat::OneLine)
+            .is_err());
+    }
+}
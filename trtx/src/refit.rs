@@ -0,0 +1,340 @@
+//! Refitting the weights of a built engine
+//!
+//! Engines built with [`BuilderFlag::Refit`](crate::BuilderFlag::Refit) (or
+//! `RefitIdentical`) can take new weights in place, in seconds, without
+//! rebuilding the plan or recreating their execution contexts:
+//!
+//! ```rust,no_run
+//! use trtx::refit::Refitter;
+//! # fn main() -> trtx::Result<()> {
+//! # let logger = trtx::Logger::stderr()?;
+//! # let runtime = trtx::Runtime::new(&logger)?;
+//! # let engine = runtime.deserialize_cuda_engine(&std::fs::read("model.engine")?)?;
+//! let onnx = std::fs::read("finetuned.onnx")?;
+//! let mut refitter = Refitter::new(&engine, &logger)?;
+//! refitter.set_weights_from_onnx(&onnx)?;
+//! refitter.refit()?;
+//! # Ok(())
+//! # }
+//! ```
+
+use crate::cuda::{CudaStream, DeviceBuffer, DeviceGuard};
+use crate::data::TensorData;
+use crate::error::{Error, Result};
+use crate::logger::Logger;
+use crate::runtime::CudaEngine;
+use crate::tensor::DataType;
+use std::ffi::{CStr, CString};
+use std::marker::PhantomData;
+use trtx_sys::*;
+
+/// New values for one named weight, on the host or the device
+///
+/// TensorRT reads the memory when the refit runs, so `'a` keeps it alive
+/// for as long as the [`Refitter`] it is staged on.
+#[derive(Debug, Clone, Copy)]
+pub struct Weights<'a> {
+    data_type: DataType,
+    values: *const std::ffi::c_void,
+    count: usize,
+    location: i32,
+    _data: PhantomData<&'a [u8]>,
+}
+
+impl<'a> Weights<'a> {
+    /// Weights held in host memory
+    pub fn host(data: &'a TensorData) -> Self {
+        Weights {
+            data_type: data.data_type(),
+            values: data.as_bytes().as_ptr() as *const std::ffi::c_void,
+            count: data.len(),
+            location: TRTX_TENSOR_LOCATION_HOST as i32,
+            _data: PhantomData,
+        }
+    }
+
+    /// `count` weights of `data_type` at the start of `buffer`
+    ///
+    /// Device weights are applied without a host round trip.
+    pub fn device(buffer: &'a DeviceBuffer, data_type: DataType, count: usize) -> Result<Self> {
+        let needed = (count * data_type.size_in_bits()).div_ceil(8);
+        if needed > buffer.size() {
+            return Err(Error::InvalidArgument(format!(
+                "{count} {data_type:?} weights need {needed} bytes, buffer holds {}",
+                buffer.size()
+            )));
+        }
+        // SAFETY: the buffer is large enough and borrowed for 'a
+        Ok(unsafe { Self::from_device_ptr(buffer.as_ptr(), data_type, count) })
+    }
+
+    /// `count` weights of `data_type` at a raw device address
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must point to at least that many weights of device memory,
+    /// which must stay valid for `'a`.
+    pub unsafe fn from_device_ptr(
+        ptr: *const std::ffi::c_void,
+        data_type: DataType,
+        count: usize,
+    ) -> Self {
+        Weights {
+            data_type,
+            values: ptr,
+            count,
+            location: TRTX_TENSOR_LOCATION_DEVICE as i32,
+            _data: PhantomData,
+        }
+    }
+}
+
+/// Swaps new weights into a live engine (IRefitter)
+///
+/// Stage weights with [`set_named_weights`](Self::set_named_weights) or
+/// [`set_weights_from_onnx`](Self::set_weights_from_onnx), then apply them
+/// with [`refit`](Self::refit). Execution contexts of the engine stay valid,
+/// but inference enqueued on other streams while a refit runs may see a mix
+/// of old and new weights: order the refit on the inference stream with
+/// [`refit_async`](Self::refit_async), or wait for in-flight runs first.
+/// Contexts replaying CUDA graphs should disable and re-enable them so the
+/// graphs are captured again.
+pub struct Refitter<'a> {
+    inner: *mut TrtxRefitter,
+    // Own the weights they converted from ONNX, so they live until the refitter goes
+    parser_refitters: Vec<*mut TrtxParserRefitter>,
+    logger: &'a Logger,
+    device: i32,
+    _engine: PhantomData<&'a CudaEngine>,
+}
+
+impl<'a> Refitter<'a> {
+    /// Create a refitter for an engine built with a refit flag
+    pub fn new(engine: &'a CudaEngine, logger: &'a Logger) -> Result<Self> {
+        let _device = DeviceGuard::new(engine.device())?;
+        let mut refitter_ptr: *mut TrtxRefitter = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_refitter_create(
+                engine.as_ptr(),
+                logger.as_ptr(),
+                &mut refitter_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(Refitter {
+            inner: refitter_ptr,
+            parser_refitters: Vec::new(),
+            logger,
+            device: engine.device(),
+            _engine: PhantomData,
+        })
+    }
+
+    /// Stage new values for the weights called `name`
+    ///
+    /// The type and count must match the weights the engine was built with.
+    pub fn set_named_weights(&mut self, name: &str, weights: Weights<'a>) -> Result<()> {
+        let name_cstr = CString::new(name)?;
+        let count = i64::try_from(weights.count)
+            .map_err(|_| Error::InvalidArgument(format!("Too many weights for '{name}'")))?;
+
+        let result = unsafe {
+            trtx_refitter_set_named_weights(
+                self.inner,
+                name_cstr.as_ptr(),
+                weights.data_type as i32,
+                weights.values,
+                count,
+                weights.location,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Stage every initializer of an ONNX model with the engine's graph (IParserRefitter)
+    pub fn set_weights_from_onnx(&mut self, onnx_bytes: &'a [u8]) -> Result<()> {
+        let mut parser_ptr: *mut TrtxParserRefitter = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_parser_refitter_create(
+                self.inner,
+                self.logger.as_ptr(),
+                &mut parser_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+        self.parser_refitters.push(parser_ptr);
+
+        let result = unsafe {
+            trtx_parser_refitter_refit_from_bytes(
+                parser_ptr,
+                onnx_bytes.as_ptr() as *const std::ffi::c_void,
+                onnx_bytes.len(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Names of every refittable weight in the engine
+    pub fn weight_names(&self) -> Result<Vec<String>> {
+        self.names(false)
+    }
+
+    /// Names of the weights that still have to be staged before a refit
+    pub fn missing_weights(&self) -> Result<Vec<String>> {
+        self.names(true)
+    }
+
+    fn names(&self, missing_only: bool) -> Result<Vec<String>> {
+        let mut count = 0;
+        let result = unsafe {
+            trtx_refitter_get_weight_names(
+                self.inner,
+                missing_only as i32,
+                0,
+                std::ptr::null_mut(),
+                &mut count,
+            )
+        };
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        let mut names = vec![std::ptr::null(); count.max(0) as usize];
+        let result = unsafe {
+            trtx_refitter_get_weight_names(
+                self.inner,
+                missing_only as i32,
+                count,
+                names.as_mut_ptr(),
+                &mut count,
+            )
+        };
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        names
+            .iter()
+            .take(count.max(0) as usize)
+            .map(|&name| Ok(unsafe { CStr::from_ptr(name) }.to_str()?.to_string()))
+            .collect()
+    }
+
+    /// Apply the staged weights, ordered on `stream`
+    ///
+    /// Staged memory must stay untouched until the stream reaches this point.
+    pub fn refit_async(&mut self, stream: &CudaStream) -> Result<()> {
+        let _device = DeviceGuard::new(self.device)?;
+        let result = unsafe {
+            trtx_refitter_refit_cuda_engine_async(
+                self.inner,
+                stream.as_ptr(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Apply the staged weights and wait until the engine uses them
+    pub fn refit(&mut self) -> Result<()> {
+        let stream = CudaStream::on_device(self.device)?;
+        self.refit_async(&stream)?;
+        stream.synchronize()
+    }
+}
+
+impl Drop for Refitter<'_> {
+    fn drop(&mut self) {
+        unsafe {
+            for &parser in &self.parser_refitters {
+                trtx_parser_refitter_destroy(parser);
+            }
+            if !self.inner.is_null() {
+                trtx_refitter_destroy(self.inner);
+            }
+        }
+    }
+}
+
+unsafe impl Send for Refitter<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::Runtime;
+
+    #[test]
+    fn test_refit_named_weights() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let weights = TensorData::from(vec![0.25f32; 8]);
+
+        let mut refitter = Refitter::new(&engine, &logger).unwrap();
+        let names = refitter.weight_names().unwrap();
+        assert_eq!(names.len(), 4);
+        assert!(refitter
+            .set_named_weights("missing", Weights::host(&weights))
+            .is_err());
+
+        refitter
+            .set_named_weights(&names[0], Weights::host(&weights))
+            .unwrap();
+        assert_eq!(refitter.missing_weights().unwrap(), names[1..].to_vec());
+        assert!(refitter.refit().is_err());
+
+        for name in &names[1..] {
+            refitter
+                .set_named_weights(name, Weights::host(&weights))
+                .unwrap();
+        }
+        refitter.refit().unwrap();
+    }
+
+    #[test]
+    fn test_refit_from_onnx() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let onnx = [0u8; 100];
+
+        let mut refitter = Refitter::new(&engine, &logger).unwrap();
+        refitter.set_weights_from_onnx(&onnx).unwrap();
+        assert!(refitter.missing_weights().unwrap().is_empty());
+        refitter.refit().unwrap();
+        assert!(refitter.set_weights_from_onnx(&[]).is_err());
+    }
+}
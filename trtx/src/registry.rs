@@ -0,0 +1,501 @@
+//! Loading models in the background and warming them up before they serve
+//!
+//! Deserializing several engines one after the other on the main thread
+//! delays startup by the sum of their load times, and each model's first
+//! request then pays for lazy kernel loading and, on TensorRT-RTX, JIT
+//! compilation. An [`EngineRegistry`] loads [`ModelSpec`]s on background
+//! threads, several at once and each with its own runtime, runs a warm-up
+//! ([`InferenceSession::warm_up`]) on every model, and only then reports it
+//! ready, together with the time each phase took.
+//!
+//! ```rust,no_run
+//! use trtx::{EngineRegistry, Logger, ModelSource, ModelSpec, RegistryConfig};
+//! # fn main() -> trtx::Result<()> {
+//! let registry = EngineRegistry::new(|_name| Logger::stderr(), RegistryConfig::default())?;
+//! registry.load(ModelSpec::new("detector", ModelSource::PlanFile("detector.engine".into())))?;
+//! registry.load(ModelSpec::new("embedder", ModelSource::PlanFile("embedder.engine".into())))?;
+//!
+//! // ... finish starting up while the models load ...
+//! let detector = registry.wait("detector")?;
+//! # let _ = detector;
+//! # Ok(())
+//! # }
+//! ```
+
+use crate::error::{Error, Result};
+use crate::session::{InferenceSession, SessionConfig};
+use crate::Logger;
+use std::any::Any;
+use std::collections::{HashMap, VecDeque};
+use std::panic::{self, AssertUnwindSafe};
+use std::path::PathBuf;
+use std::sync::{Arc, Condvar, Mutex, MutexGuard};
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant};
+
+/// Callback creating the logger each model's session owns, given the model name
+pub type LoggerFn = dyn Fn(&str) -> Result<Logger> + Send + Sync;
+
+/// Where a model's engine comes from
+#[derive(Debug, Clone)]
+pub enum ModelSource {
+    /// ONNX bytes, built with the spec's [`SessionConfig`]
+    Onnx(Arc<[u8]>),
+    /// ONNX file, parsed with its external data memory-mapped
+    OnnxFile(PathBuf),
+    /// Serialized plan bytes
+    Plan(Arc<[u8]>),
+    /// Serialized plan on disk, memory-mapped
+    PlanFile(PathBuf),
+}
+
+/// One model to load
+#[derive(Clone)]
+pub struct ModelSpec {
+    /// Name the model is registered and looked up under
+    pub name: String,
+    /// Where the engine comes from
+    pub source: ModelSource,
+    /// Settings of the model's session
+    pub config: SessionConfig,
+    /// Warm-up rounds; each runs every context once. `0` skips the warm-up
+    pub warmup_iterations: usize,
+    /// Shapes of dynamic inputs during warm-up; unlisted ones use the opt shape of profile 0
+    pub warmup_shapes: Vec<(String, Vec<i64>)>,
+}
+
+impl ModelSpec {
+    /// Load `source` with default session settings and one warm-up round
+    pub fn new(name: impl Into<String>, source: ModelSource) -> Self {
+        ModelSpec {
+            name: name.into(),
+            source,
+            config: SessionConfig::default(),
+            warmup_iterations: 1,
+            warmup_shapes: Vec::new(),
+        }
+    }
+
+    /// Use `config` for the model's session
+    pub fn config(mut self, config: SessionConfig) -> Self {
+        self.config = config;
+        self
+    }
+
+    /// Run `iterations` warm-up rounds before the model is ready
+    pub fn warmup(mut self, iterations: usize) -> Self {
+        self.warmup_iterations = iterations;
+        self
+    }
+
+    /// Warm up with `shape` for the dynamic input `name`
+    pub fn warmup_shape(mut self, name: impl Into<String>, shape: Vec<i64>) -> Self {
+        self.warmup_shapes.push((name.into(), shape));
+        self
+    }
+}
+
+impl std::fmt::Debug for ModelSpec {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ModelSpec")
+            .field("name", &self.name)
+            .field("source", &self.source)
+            .field("warmup_iterations", &self.warmup_iterations)
+            .field("warmup_shapes", &self.warmup_shapes)
+            .finish()
+    }
+}
+
+/// Time a model spent in each phase before it was ready
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct LoadTimings {
+    /// Waiting for a free loader thread
+    pub queued: Duration,
+    /// Building or deserializing the engine and creating its contexts
+    pub load: Duration,
+    /// Warm-up inferences
+    pub warmup: Duration,
+}
+
+impl LoadTimings {
+    /// Time from [`EngineRegistry::load`] until the model was ready
+    pub fn time_to_ready(&self) -> Duration {
+        self.queued + self.load + self.warmup
+    }
+}
+
+/// Where a model is in its loading
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum ModelStatus {
+    /// Waiting for a loader thread
+    Queued,
+    /// Engine being built or deserialized
+    Loading,
+    /// Warm-up inferences running
+    WarmingUp,
+    /// Serving; see [`EngineRegistry::get`]
+    Ready(LoadTimings),
+    /// Loading or warm-up failed with this message
+    Failed(String),
+}
+
+impl ModelStatus {
+    /// Whether the model is ready or has failed, so its status will not change again
+    pub fn is_settled(&self) -> bool {
+        matches!(self, ModelStatus::Ready(_) | ModelStatus::Failed(_))
+    }
+}
+
+/// Configuration for [`EngineRegistry`]
+#[derive(Debug, Clone, Default)]
+pub struct RegistryConfig {
+    /// Models loading at once; `0` uses the available parallelism
+    pub workers: usize,
+}
+
+struct Entry {
+    status: ModelStatus,
+    session: Option<Arc<InferenceSession>>,
+}
+
+struct State {
+    models: HashMap<String, Entry>,
+    queue: VecDeque<(ModelSpec, Instant)>,
+    shutdown: bool,
+}
+
+struct Shared {
+    logger: Box<LoggerFn>,
+    state: Mutex<State>,
+    // Signals queued work to the loader threads
+    work_ready: Condvar,
+    // Signals status changes to waiters
+    status_changed: Condvar,
+}
+
+/// Loads and warms up models on background threads
+///
+/// Dropping the registry waits for the models being loaded and discards
+/// those still queued; sessions already handed out stay usable.
+pub struct EngineRegistry {
+    shared: Arc<Shared>,
+    workers: Vec<JoinHandle<()>>,
+}
+
+impl EngineRegistry {
+    /// Start the loader threads; `logger` creates each model's logger
+    pub fn new(
+        logger: impl Fn(&str) -> Result<Logger> + Send + Sync + 'static,
+        config: RegistryConfig,
+    ) -> Result<Self> {
+        let workers = match config.workers {
+            0 => std::thread::available_parallelism().map_or(1, |n| n.get()),
+            n => n,
+        };
+
+        let mut registry = EngineRegistry {
+            shared: Arc::new(Shared {
+                logger: Box::new(logger),
+                state: Mutex::new(State {
+                    models: HashMap::new(),
+                    queue: VecDeque::new(),
+                    shutdown: false,
+                }),
+                work_ready: Condvar::new(),
+                status_changed: Condvar::new(),
+            }),
+            workers: Vec::with_capacity(workers),
+        };
+        for i in 0..workers {
+            let shared = Arc::clone(&registry.shared);
+            // On failure, dropping `registry` stops the workers already started
+            let worker = std::thread::Builder::new()
+                .name(format!("trtx-loader-{i}"))
+                .spawn(move || shared.work())?;
+            registry.workers.push(worker);
+        }
+
+        Ok(registry)
+    }
+
+    /// Queue a model for loading and return at once
+    ///
+    /// Fails if a model with the same name is already registered.
+    pub fn load(&self, spec: ModelSpec) -> Result<()> {
+        let mut state = self.shared.lock();
+        if state.models.contains_key(&spec.name) {
+            return Err(Error::InvalidArgument(format!(
+                "Model '{}' is already registered",
+                spec.name
+            )));
+        }
+        state.models.insert(
+            spec.name.clone(),
+            Entry {
+                status: ModelStatus::Queued,
+                session: None,
+            },
+        );
+        state.queue.push_back((spec, Instant::now()));
+        drop(state);
+
+        self.shared.work_ready.notify_one();
+        Ok(())
+    }
+
+    /// Get the status of a model, or None if it was never registered
+    pub fn status(&self, name: &str) -> Option<ModelStatus> {
+        let state = self.shared.lock();
+        state.models.get(name).map(|entry| entry.status.clone())
+    }
+
+    /// Get the statuses of every registered model, sorted by name
+    pub fn statuses(&self) -> Vec<(String, ModelStatus)> {
+        let state = self.shared.lock();
+        let mut statuses: Vec<_> = state
+            .models
+            .iter()
+            .map(|(name, entry)| (name.clone(), entry.status.clone()))
+            .collect();
+        statuses.sort_by(|a, b| a.0.cmp(&b.0));
+        statuses
+    }
+
+    /// Get a model's session if it is ready, without waiting
+    pub fn get(&self, name: &str) -> Option<Arc<InferenceSession>> {
+        let state = self.shared.lock();
+        state
+            .models
+            .get(name)
+            .and_then(|entry| entry.session.clone())
+    }
+
+    /// Wait until a model is ready and get its session
+    pub fn wait(&self, name: &str) -> Result<Arc<InferenceSession>> {
+        let mut state = self.shared.lock();
+        loop {
+            let entry = state.models.get(name).ok_or_else(|| {
+                Error::InvalidArgument(format!("Model '{name}' is not registered"))
+            })?;
+            match (&entry.status, &entry.session) {
+                (ModelStatus::Ready(_), Some(session)) => return Ok(Arc::clone(session)),
+                (ModelStatus::Failed(message), _) => {
+                    return Err(Error::Runtime(format!(
+                        "Model '{name}' failed to load: {message}"
+                    )))
+                }
+                _ => {}
+            }
+            state = self.shared.wait_for_status(state);
+        }
+    }
+
+    /// Wait until every registered model is ready or has failed
+    ///
+    /// Returns the final statuses, sorted by name.
+    pub fn wait_all(&self) -> Vec<(String, ModelStatus)> {
+        let mut state = self.shared.lock();
+        while !state.models.values().all(|entry| entry.status.is_settled()) {
+            state = self.shared.wait_for_status(state);
+        }
+        drop(state);
+        self.statuses()
+    }
+}
+
+impl Drop for EngineRegistry {
+    fn drop(&mut self) {
+        self.shared.lock().shutdown = true;
+        self.shared.work_ready.notify_all();
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
+
+impl Shared {
+    fn lock(&self) -> MutexGuard<'_, State> {
+        self.state
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+
+    fn wait_for_status<'a>(&self, state: MutexGuard<'a, State>) -> MutexGuard<'a, State> {
+        self.status_changed
+            .wait(state)
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+
+    fn set_status(&self, name: &str, status: ModelStatus, session: Option<InferenceSession>) {
+        let mut state = self.lock();
+        if let Some(entry) = state.models.get_mut(name) {
+            entry.status = status;
+            entry.session = session.map(Arc::new);
+        }
+        drop(state);
+        self.status_changed.notify_all();
+    }
+
+    /// Loader thread: load queued models until shutdown
+    fn work(&self) {
+        loop {
+            let (spec, queued_at) = {
+                let mut state = self.lock();
+                loop {
+                    if state.shutdown {
+                        return;
+                    }
+                    if let Some(next) = state.queue.pop_front() {
+                        break next;
+                    }
+                    state = self
+                        .work_ready
+                        .wait(state)
+                        .unwrap_or_else(|poisoned| poisoned.into_inner());
+                }
+            };
+
+            // A panicking load still settles its status, or its waiters would hang
+            let loaded = panic::catch_unwind(AssertUnwindSafe(|| self.load(&spec, queued_at)));
+            let (status, session) = match loaded {
+                Ok(Ok((session, timings))) => (ModelStatus::Ready(timings), Some(session)),
+                Ok(Err(e)) => (ModelStatus::Failed(e.to_string()), None),
+                Err(payload) => (ModelStatus::Failed(panic_message(&*payload)), None),
+            };
+            self.set_status(&spec.name, status, session);
+        }
+    }
+
+    /// Load and warm up one model, reporting the phases as it goes
+    fn load(
+        &self,
+        spec: &ModelSpec,
+        queued_at: Instant,
+    ) -> Result<(InferenceSession, LoadTimings)> {
+        let mut timings = LoadTimings {
+            queued: queued_at.elapsed(),
+            ..LoadTimings::default()
+        };
+        self.set_status(&spec.name, ModelStatus::Loading, None);
+
+        let start = Instant::now();
+        let session = self.load_session(spec)?;
+        timings.load = start.elapsed();
+
+        if spec.warmup_iterations > 0 {
+            self.set_status(&spec.name, ModelStatus::WarmingUp, None);
+            let start = Instant::now();
+            session.warm_up(&spec.warmup_shapes, spec.warmup_iterations)?;
+            timings.warmup = start.elapsed();
+        }
+        Ok((session, timings))
+    }
+
+    fn load_session(&self, spec: &ModelSpec) -> Result<InferenceSession> {
+        let logger = (self.logger)(&spec.name)?;
+        let config = spec.config.clone();
+        match &spec.source {
+            ModelSource::Onnx(bytes) => InferenceSession::from_onnx(logger, bytes, config),
+            ModelSource::OnnxFile(path) => InferenceSession::from_onnx_file(logger, path, config),
+            ModelSource::Plan(bytes) => InferenceSession::from_plan(logger, bytes, config),
+            ModelSource::PlanFile(path) => InferenceSession::from_plan_file(logger, path, config),
+        }
+    }
+}
+
+fn panic_message(payload: &(dyn Any + Send)) -> String {
+    let message = payload
+        .downcast_ref::<&str>()
+        .copied()
+        .or_else(|| payload.downcast_ref::<String>().map(String::as_str))
+        .unwrap_or("unknown panic");
+    format!("loading panicked: {message}")
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::executor::TensorInput;
+
+    #[test]
+    fn test_registry_loads_and_warms_models() {
+        let config = RegistryConfig { workers: 2 };
+        let registry = EngineRegistry::new(|_| Logger::stderr(), config).unwrap();
+
+        let session_config = SessionConfig {
+            num_contexts: 2,
+            cuda_graphs: true,
+            ..SessionConfig::default()
+        };
+        registry
+            .load(
+                ModelSpec::new("onnx", ModelSource::Onnx(vec![0u8; 100].into()))
+                    .config(session_config)
+                    .warmup(2)
+                    .warmup_shape("input", vec![4, 3, 224, 224]),
+            )
+            .unwrap();
+        registry
+            .load(ModelSpec::new("plan", ModelSource::Plan(vec![0u8; 16].into())).warmup(0))
+            .unwrap();
+        registry
+            .load(ModelSpec::new(
+                "missing",
+                ModelSource::PlanFile("/nonexistent/model.engine".into()),
+            ))
+            .unwrap();
+        assert!(registry
+            .load(ModelSpec::new(
+                "plan",
+                ModelSource::Plan(vec![0u8; 16].into())
+            ))
+            .is_err());
+
+        let statuses = registry.wait_all();
+        assert_eq!(statuses.len(), 3);
+        assert!(matches!(statuses[0].1, ModelStatus::Failed(_)));
+        assert!(registry.wait("missing").is_err());
+        assert!(registry.wait("unknown").is_err());
+
+        let Some(ModelStatus::Ready(timings)) = registry.status("plan") else {
+            panic!("plan is not ready");
+        };
+        assert_eq!(timings.warmup, Duration::ZERO);
+
+        // Warm-up already captured the graph of both contexts at this shape
+        let session = registry.wait("onnx").unwrap();
+        let input = TensorInput {
+            name: "input".to_string(),
+            shape: vec![4, 3, 224, 224],
+            data: vec![0.5f32; 4 * 3 * 224 * 224].into(),
+        };
+        session.run(&[input]).unwrap();
+        assert!(registry.get("onnx").is_some());
+        assert!(registry.get("missing").is_none());
+    }
+
+    #[test]
+    fn test_registry_settles_panicking_loads() {
+        let registry = EngineRegistry::new(
+            |name| match name {
+                "panics" => panic!("logger for {name} is broken"),
+                _ => Logger::stderr(),
+            },
+            RegistryConfig { workers: 1 },
+        )
+        .unwrap();
+        registry
+            .load(ModelSpec::new("panics", ModelSource::Plan(vec![0u8; 16].into())).warmup(0))
+            .unwrap();
+        registry
+            .load(ModelSpec::new("plan", ModelSource::Plan(vec![0u8; 16].into())).warmup(0))
+            .unwrap();
+
+        let Err(Error::Runtime(message)) = registry.wait("panics") else {
+            panic!("panicking load did not fail");
+        };
+        assert!(message.contains("logger for panics is broken"));
+        // The loader thread survived and went on with the queue
+        assert!(registry.wait("plan").is_ok());
+    }
+}
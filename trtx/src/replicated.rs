@@ -0,0 +1,300 @@
+//! One model served from several GPUs
+//!
+//! A [`ReplicatedSession`] holds one [`InferenceSession`] per device, all
+//! loaded from the same plan, and sends each run to the replica with the
+//! fewest runs in flight. Replicas are created in parallel, one thread per
+//! device. Every device must be able to run the plan, which in practice
+//! means the same GPU model or at least the same compute capability.
+//!
+//! ```rust,no_run
+//! use trtx::{Logger, ReplicatedSession, SessionConfig};
+//! # fn main() -> trtx::Result<()> {
+//! let devices: Vec<i32> = (0..trtx::cuda::device_count()? as i32).collect();
+//! let session = ReplicatedSession::from_plan_file(
+//!     |_device| Logger::stderr(),
+//!     "model.engine",
+//!     &devices,
+//!     SessionConfig::default(),
+//! )?;
+//! # let inputs = Vec::new();
+//! let outputs = session.run(&inputs)?;
+//! # Ok(())
+//! # }
+//! ```
+
+use crate::error::{Error, Result};
+use crate::executor::{TensorInput, TensorOutput};
+use crate::session::{InferenceSession, OnnxSource, SessionConfig, SessionPlan};
+use crate::Logger;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+/// One replica and its count of runs in flight (queued for a context or running)
+struct Replica {
+    session: InferenceSession,
+    in_flight: AtomicUsize,
+}
+
+/// Counts a run against its replica until dropped
+struct InFlight<'a>(&'a Replica);
+
+impl Drop for InFlight<'_> {
+    fn drop(&mut self) {
+        self.0.in_flight.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// Sessions for one model on several GPUs, load-balanced by queue depth
+///
+/// Each replica has [`SessionConfig::num_contexts`] contexts of its own.
+/// The config's allocator is shared by every replica, so it must be one
+/// that keeps memory apart per device, as the default allocator does.
+/// Compiled kernels are specific to a GPU, so a
+/// [`SessionConfig::runtime_cache_path`] gets the device appended for each
+/// replica: `model.rtcache` becomes `model.rtcache.0`, `model.rtcache.1`, ….
+pub struct ReplicatedSession {
+    replicas: Vec<Replica>,
+    // Rotates the starting point of the search so ties spread across replicas
+    cursor: AtomicUsize,
+}
+
+impl ReplicatedSession {
+    /// Build an engine from ONNX once and serve it on every device in `devices`
+    ///
+    /// The plan is built on the first device, or taken from
+    /// [`SessionConfig::engine_cache`]. `logger` is called once per device;
+    /// the first device's logger also serves the build.
+    pub fn from_onnx(
+        logger: impl FnMut(i32) -> Result<Logger>,
+        onnx_bytes: &[u8],
+        devices: &[i32],
+        config: SessionConfig,
+    ) -> Result<Self> {
+        let loggers = loggers_for(logger, devices)?;
+        let build_config = SessionConfig {
+            device: Some(devices[0]),
+            ..config.clone()
+        };
+        match SessionPlan::for_onnx(&loggers[0], OnnxSource::Bytes(onnx_bytes), &build_config)? {
+            SessionPlan::Built(plan) => {
+                Self::replicate(loggers, devices, config, |logger, config| {
+                    InferenceSession::from_plan(logger, &plan, config)
+                })
+            }
+            SessionPlan::Cached(path) => {
+                Self::replicate(loggers, devices, config, |logger, config| {
+                    InferenceSession::from_plan_file(logger, &path, config)
+                })
+            }
+        }
+    }
+
+    /// Load a serialized plan on disk onto every device in `devices`
+    ///
+    /// Each replica memory-maps the file, so they share its pages through
+    /// the page cache instead of each reading a private copy.
+    pub fn from_plan_file<P: AsRef<Path>>(
+        logger: impl FnMut(i32) -> Result<Logger>,
+        path: P,
+        devices: &[i32],
+        config: SessionConfig,
+    ) -> Result<Self> {
+        let path = path.as_ref();
+        let loggers = loggers_for(logger, devices)?;
+        Self::replicate(loggers, devices, config, |logger, config| {
+            InferenceSession::from_plan_file(logger, path, config)
+        })
+    }
+
+    /// Load a serialized plan onto every device in `devices`
+    pub fn from_plan(
+        logger: impl FnMut(i32) -> Result<Logger>,
+        plan: &[u8],
+        devices: &[i32],
+        config: SessionConfig,
+    ) -> Result<Self> {
+        let loggers = loggers_for(logger, devices)?;
+        Self::replicate(loggers, devices, config, |logger, config| {
+            InferenceSession::from_plan(logger, plan, config)
+        })
+    }
+
+    /// Shared constructor; `load` creates one replica on `config.device`
+    fn replicate(
+        loggers: Vec<Logger>,
+        devices: &[i32],
+        config: SessionConfig,
+        load: impl Fn(Logger, SessionConfig) -> Result<InferenceSession> + Sync,
+    ) -> Result<Self> {
+        let sessions = std::thread::scope(|scope| {
+            let handles: Vec<_> = devices
+                .iter()
+                .zip(loggers)
+                .map(|(&device, logger)| {
+                    let config = SessionConfig {
+                        device: Some(device),
+                        runtime_cache_path: config
+                            .runtime_cache_path
+                            .as_deref()
+                            .map(|path| path_for_device(path, device)),
+                        ..config.clone()
+                    };
+                    let load = &load;
+                    scope.spawn(move || load(logger, config))
+                })
+                .collect();
+            handles
+                .into_iter()
+                .map(|handle| {
+                    handle
+                        .join()
+                        .unwrap_or_else(|panic| std::panic::resume_unwind(panic))
+                })
+                .collect::<Result<Vec<_>>>()
+        })?;
+
+        Ok(ReplicatedSession {
+            replicas: sessions
+                .into_iter()
+                .map(|session| Replica {
+                    session,
+                    in_flight: AtomicUsize::new(0),
+                })
+                .collect(),
+            cursor: AtomicUsize::new(0),
+        })
+    }
+
+    /// Get the number of replicas
+    pub fn len(&self) -> usize {
+        self.replicas.len()
+    }
+
+    /// Check whether there are no replicas (never true once constructed)
+    pub fn is_empty(&self) -> bool {
+        self.replicas.is_empty()
+    }
+
+    /// Get the session of replica `index`
+    pub fn replica(&self, index: usize) -> Option<&InferenceSession> {
+        self.replicas.get(index).map(|replica| &replica.session)
+    }
+
+    /// Iterate over the devices of the replicas, in replica order
+    pub fn devices(&self) -> impl Iterator<Item = i32> + '_ {
+        self.replicas.iter().map(|replica| replica.session.device())
+    }
+
+    /// Get the runs in flight on each replica, in replica order
+    pub fn queue_depths(&self) -> Vec<usize> {
+        self.replicas
+            .iter()
+            .map(|replica| replica.in_flight.load(Ordering::Relaxed))
+            .collect()
+    }
+
+    /// Run inference on the least loaded replica
+    pub fn run(&self, inputs: &[TensorInput]) -> Result<Vec<TensorOutput>> {
+        let in_flight = self.pick();
+        in_flight.0.session.run(inputs)
+    }
+
+    /// Run inference on the least loaded replica, reusing `outputs`
+    pub fn run_into(&self, inputs: &[TensorInput], outputs: &mut Vec<TensorOutput>) -> Result<()> {
+        let in_flight = self.pick();
+        in_flight.0.session.run_into(inputs, outputs)
+    }
+
+    /// Run inference on the least loaded replica without blocking the calling thread
+    pub async fn run_async(&self, inputs: &[TensorInput]) -> Result<Vec<TensorOutput>> {
+        let in_flight = self.pick();
+        in_flight.0.session.run_async(inputs).await
+    }
+
+    /// Claim the replica with the fewest runs in flight
+    fn pick(&self) -> InFlight<'_> {
+        let count = self.replicas.len();
+        let start = self.cursor.fetch_add(1, Ordering::Relaxed);
+        let replica = (0..count)
+            .map(|offset| &self.replicas[(start + offset) % count])
+            .min_by_key(|replica| replica.in_flight.load(Ordering::Relaxed))
+            .expect("at least one replica");
+        replica.in_flight.fetch_add(1, Ordering::Relaxed);
+        InFlight(replica)
+    }
+}
+
+/// Create the logger of every device, in device order
+fn loggers_for(
+    mut logger: impl FnMut(i32) -> Result<Logger>,
+    devices: &[i32],
+) -> Result<Vec<Logger>> {
+    if devices.is_empty() {
+        return Err(no_devices());
+    }
+    devices.iter().map(|&device| logger(device)).collect()
+}
+
+/// Append `.<device>` to the file name of `path`
+fn path_for_device(path: &Path, device: i32) -> PathBuf {
+    let mut name = path.as_os_str().to_owned();
+    name.push(format!(".{device}"));
+    PathBuf::from(name)
+}
+
+fn no_devices() -> Error {
+    Error::InvalidArgument("A replicated session needs at least one device".to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::cuda;
+
+    fn mock_input() -> TensorInput {
+        TensorInput {
+            name: "input".to_string(),
+            shape: vec![1, 3, 224, 224],
+            data: vec![0.5f32; 3 * 224 * 224].into(),
+        }
+    }
+
+    #[test]
+    fn test_replicated_session_balances_runs() {
+        let devices: Vec<i32> = (0..cuda::device_count().unwrap() as i32).collect();
+        let session = ReplicatedSession::from_onnx(
+            |_| Logger::stderr(),
+            &[0u8; 100],
+            &devices,
+            SessionConfig::default(),
+        )
+        .unwrap();
+        assert_eq!(session.devices().collect::<Vec<_>>(), devices);
+
+        {
+            let held = session.pick();
+            let next = session.pick();
+            if devices.len() > 1 {
+                // The busy replica is skipped
+                assert!(!std::ptr::eq(held.0, next.0));
+            }
+            assert_eq!(session.queue_depths().iter().sum::<usize>(), 2);
+        }
+        let outputs = session.run(&[mock_input()]).unwrap();
+        assert_eq!(outputs[0].shape, vec![1, 1000]);
+        assert!(session.queue_depths().iter().all(|&depth| depth == 0));
+        assert_eq!(cuda::current_device().unwrap(), 0);
+
+        assert_eq!(
+            path_for_device(Path::new("/tmp/model.rtcache"), 1),
+            PathBuf::from("/tmp/model.rtcache.1")
+        );
+        assert!(ReplicatedSession::from_plan(
+            |_| Logger::stderr(),
+            &[0u8; 16],
+            &[],
+            SessionConfig::default()
+        )
+        .is_err());
+    }
+}
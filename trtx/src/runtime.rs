@@ -1,16 +1,113 @@
 //! Runtime for deserializing and managing TensorRT engines
 
+use crate::cuda::{self, CudaStream, DeviceGuard};
 use crate::error::{Error, Result};
 use crate::logger::Logger;
-use std::ffi::CStr;
+use crate::profiler::{EngineInspector, Profiler, ProfilerHandle};
+use crate::runtime_cache::RuntimeCache;
+use crate::tensor::{
+    from_dims, to_dims, BindingTable, DataType, ProfileSelector, TensorFormat, TensorIOMode,
+    TensorInfo,
+};
+use std::borrow::Cow;
+use std::ffi::{CStr, CString};
+use std::path::Path;
+use std::sync::{Arc, OnceLock};
 use trtx_sys::*;
 
+/// Get the version of the linked TensorRT-RTX library
+///
+/// Encoded like `getInferLibVersion`, e.g. `10000` for 1.0.0.
+pub fn tensorrt_version() -> i32 {
+    unsafe { trtx_get_tensorrt_version() }
+}
+
+/// How an execution context gets its activation (scratch) memory
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Default)]
+#[repr(i32)]
+pub enum AllocationStrategy {
+    /// Allocated at creation, sized for the largest profile
+    #[default]
+    Static = 0,
+    /// Reallocated for the active profile when it changes
+    OnProfileChange = 1,
+    /// Supplied by the caller with [`ExecutionContext::set_device_memory`]
+    UserManaged = 2,
+}
+
+/// How many streamable weights [`CudaEngine::set_weight_streaming_budget`] keeps on the GPU
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum WeightStreamingBudget {
+    /// TensorRT's estimate of what fits alongside activations on this GPU
+    Automatic,
+    /// Every weight on the GPU, so nothing streams
+    Resident,
+    /// At most this many bytes of streamable weights on the GPU
+    Bytes(usize),
+}
+
+/// Weight streaming sizes reported by [`CudaEngine::weight_streaming`], in bytes
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub struct WeightStreamingInfo {
+    /// Weights that may live in host memory and stream in
+    pub streamable_weights_size: usize,
+    /// Streamable weights currently kept on the GPU
+    pub budget: usize,
+    /// Budget TensorRT picks for [`WeightStreamingBudget::Automatic`]
+    pub automatic_budget: usize,
+    /// Extra scratch memory each context needs at the current budget
+    pub scratch_memory_size: usize,
+}
+
 /// A CUDA engine containing optimized inference code
+///
+/// The engine lives on the device its runtime deserialized it on. Contexts
+/// are created there, but enqueueing does not switch devices: callers on
+/// several GPUs should hold a [`DeviceGuard`] for [`device`](Self::device).
 pub struct CudaEngine {
     inner: *mut TrtxCudaEngine,
+    bindings: OnceLock<BindingTable>,
+    device: i32,
 }
 
 impl CudaEngine {
+    fn from_raw(inner: *mut TrtxCudaEngine, device: i32) -> Self {
+        CudaEngine {
+            inner,
+            bindings: OnceLock::new(),
+            device,
+        }
+    }
+
+    /// Get the device the engine was deserialized on
+    pub fn device(&self) -> i32 {
+        self.device
+    }
+
+    pub(crate) fn as_ptr(&self) -> *mut TrtxCudaEngine {
+        self.inner
+    }
+
+    /// Get the IO tensor names interned for binding by index
+    ///
+    /// Built on first use and shared by every context of the engine; see
+    /// [`ExecutionContext::set_tensor_address_at`].
+    pub fn binding_table(&self) -> Result<&BindingTable> {
+        if let Some(table) = self.bindings.get() {
+            return Ok(table);
+        }
+        let entries = (0..self.get_nb_io_tensors()?)
+            .map(|i| {
+                let name = self.get_tensor_name(i)?;
+                let mode = self.get_tensor_io_mode(&name)?;
+                Ok((name, mode))
+            })
+            .collect::<Result<Vec<_>>>()?;
+        let table = BindingTable::new(entries)?;
+        // A concurrent caller may have won the race; both built the same table
+        Ok(self.bindings.get_or_init(|| table))
+    }
+
     /// Get the number of I/O tensors
     pub fn get_nb_io_tensors(&self) -> Result<i32> {
         let mut count: i32 = 0;
@@ -18,7 +115,7 @@ impl CudaEngine {
         let result = unsafe { trtx_cuda_engine_get_nb_io_tensors(self.inner, &mut count) };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &[]));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(count)
@@ -27,20 +124,19 @@ impl CudaEngine {
     /// Get the name of a tensor by index
     pub fn get_tensor_name(&self, index: i32) -> Result<String> {
         let mut name_ptr: *const i8 = std::ptr::null();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_cuda_engine_get_tensor_name(
                 self.inner,
                 index,
                 &mut name_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         let name = unsafe { CStr::from_ptr(name_ptr) }.to_str()?.to_string();
@@ -48,27 +144,409 @@ impl CudaEngine {
         Ok(name)
     }
 
+    /// Get the shape of a tensor (`-1` for dimensions set at runtime)
+    pub fn get_tensor_shape(&self, name: &str) -> Result<Vec<i64>> {
+        let name_cstr = CString::new(name)?;
+        let mut dims = TrtxDims::default();
+
+        let result = unsafe {
+            trtx_cuda_engine_get_tensor_shape(
+                self.inner,
+                name_cstr.as_ptr(),
+                &mut dims,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(from_dims(&dims))
+    }
+
+    /// Get the element type of a tensor
+    pub fn get_tensor_data_type(&self, name: &str) -> Result<DataType> {
+        let name_cstr = CString::new(name)?;
+        let mut data_type = 0;
+
+        let result = unsafe {
+            trtx_cuda_engine_get_tensor_data_type(
+                self.inner,
+                name_cstr.as_ptr(),
+                &mut data_type,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        DataType::from_raw(data_type)
+    }
+
+    /// Get whether a tensor is an input or an output
+    pub fn get_tensor_io_mode(&self, name: &str) -> Result<TensorIOMode> {
+        let name_cstr = CString::new(name)?;
+        let mut io_mode = 0;
+
+        let result = unsafe {
+            trtx_cuda_engine_get_tensor_io_mode(
+                self.inner,
+                name_cstr.as_ptr(),
+                &mut io_mode,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        TensorIOMode::from_raw(io_mode)
+    }
+
+    /// Get the layout of a tensor with its vectorized dimension and components per element
+    pub fn get_tensor_format(&self, name: &str) -> Result<(TensorFormat, i32, i32)> {
+        let name_cstr = CString::new(name)?;
+        let mut format = 0;
+        let mut vectorized_dim = -1;
+        let mut components_per_element = 1;
+
+        let result = unsafe {
+            trtx_cuda_engine_get_tensor_format(
+                self.inner,
+                name_cstr.as_ptr(),
+                &mut format,
+                &mut vectorized_dim,
+                &mut components_per_element,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok((
+            TensorFormat::from_raw(format)?,
+            vectorized_dim,
+            components_per_element,
+        ))
+    }
+
+    /// Get the number of bytes per component of a tensor
+    pub fn get_tensor_bytes_per_component(&self, name: &str) -> Result<i32> {
+        let name_cstr = CString::new(name)?;
+        let mut bytes = 0;
+
+        let result = unsafe {
+            trtx_cuda_engine_get_tensor_bytes_per_component(
+                self.inner,
+                name_cstr.as_ptr(),
+                &mut bytes,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(bytes)
+    }
+
+    /// Get the number of optimization profiles the engine was built with
+    pub fn get_nb_optimization_profiles(&self) -> Result<i32> {
+        let mut count: i32 = 0;
+
+        let result =
+            unsafe { trtx_cuda_engine_get_nb_optimization_profiles(self.inner, &mut count) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(count)
+    }
+
+    /// Get the min, opt or max shape of an input in one optimization profile
+    pub fn get_profile_shape(
+        &self,
+        input: &str,
+        profile_index: i32,
+        selector: ProfileSelector,
+    ) -> Result<Vec<i64>> {
+        let name_cstr = CString::new(input)?;
+        let mut dims = TrtxDims::default();
+
+        let result = unsafe {
+            trtx_cuda_engine_get_profile_shape(
+                self.inner,
+                name_cstr.as_ptr(),
+                profile_index,
+                selector as i32,
+                &mut dims,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(from_dims(&dims))
+    }
+
+    /// Collect everything the engine reports about one IO tensor
+    pub fn get_tensor_info(&self, name: &str) -> Result<TensorInfo> {
+        let (format, vectorized_dim, components_per_element) = self.get_tensor_format(name)?;
+        Ok(TensorInfo {
+            name: name.to_string(),
+            shape: self.get_tensor_shape(name)?,
+            data_type: self.get_tensor_data_type(name)?,
+            io_mode: self.get_tensor_io_mode(name)?,
+            format,
+            vectorized_dim,
+            components_per_element,
+            bytes_per_component: self.get_tensor_bytes_per_component(name)?,
+        })
+    }
+
+    /// Describe every IO tensor in engine order
+    pub fn io_tensors(&self) -> Result<Vec<TensorInfo>> {
+        (0..self.get_nb_io_tensors()?)
+            .map(|i| self.get_tensor_info(&self.get_tensor_name(i)?))
+            .collect()
+    }
+
+    /// Get the activation memory one context needs, over all profiles
+    pub fn get_device_memory_size(&self) -> Result<usize> {
+        let mut size: i64 = 0;
+
+        let result = unsafe { trtx_cuda_engine_get_device_memory_size(self.inner, &mut size) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(size.max(0) as usize)
+    }
+
+    /// Get the activation memory one context needs for one profile
+    pub fn get_device_memory_size_for_profile(&self, profile_index: i32) -> Result<usize> {
+        let mut size: i64 = 0;
+
+        let result = unsafe {
+            trtx_cuda_engine_get_device_memory_size_for_profile(
+                self.inner,
+                profile_index,
+                &mut size,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(size.max(0) as usize)
+    }
+
+    /// Report how much of the engine's weights can stream and how many are resident
+    ///
+    /// Everything is zero for engines built without
+    /// [`BuilderFlag::WeightStreaming`](crate::BuilderFlag::WeightStreaming).
+    pub fn weight_streaming(&self) -> Result<WeightStreamingInfo> {
+        let (mut streamable, mut budget, mut automatic, mut scratch) = (0i64, 0i64, 0i64, 0i64);
+
+        let result = unsafe {
+            trtx_cuda_engine_get_weight_streaming(
+                self.inner,
+                &mut streamable,
+                &mut budget,
+                &mut automatic,
+                &mut scratch,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(WeightStreamingInfo {
+            streamable_weights_size: streamable.max(0) as usize,
+            budget: budget.max(0) as usize,
+            automatic_budget: automatic.max(0) as usize,
+            scratch_memory_size: scratch.max(0) as usize,
+        })
+    }
+
+    /// Choose how many bytes of streamable weights stay on the GPU
+    ///
+    /// The rest is kept in host memory and streamed in during each
+    /// inference, trading throughput for VRAM. Taking `&mut self` ensures no
+    /// execution context exists, which TensorRT requires; create contexts
+    /// afterwards. Returns the budget in bytes that was applied.
+    pub fn set_weight_streaming_budget(&mut self, budget: WeightStreamingBudget) -> Result<usize> {
+        let info = self.weight_streaming()?;
+        let bytes = match budget {
+            WeightStreamingBudget::Automatic => info.automatic_budget,
+            WeightStreamingBudget::Resident => info.streamable_weights_size,
+            WeightStreamingBudget::Bytes(bytes) => bytes,
+        };
+        let bytes_i64 = i64::try_from(bytes).map_err(|_| {
+            Error::InvalidArgument(format!("Weight streaming budget {bytes} is too large"))
+        })?;
+
+        let result = unsafe {
+            trtx_cuda_engine_set_weight_streaming_budget(
+                self.inner,
+                bytes_i64,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(bytes)
+    }
+
+    /// Create an execution context with the given activation memory strategy
+    ///
+    /// With [`AllocationStrategy::UserManaged`] the context owns no scratch
+    /// memory; call [`ExecutionContext::set_device_memory`] before enqueueing.
+    /// Contexts that are rarely active at the same time can then share a few
+    /// scratch blocks instead of holding one each.
+    pub fn create_execution_context_with(
+        &self,
+        strategy: AllocationStrategy,
+    ) -> Result<ExecutionContext<'_>> {
+        let _device = DeviceGuard::new(self.device)?;
+        let mut context_ptr: *mut TrtxExecutionContext = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_engine_create_execution_context_with_strategy(
+                self.inner,
+                strategy as i32,
+                &mut context_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(ExecutionContext {
+            inner: context_ptr,
+            profiler: None,
+            engine: self,
+        })
+    }
+
+    /// Create an execution context whose JIT-compiled kernels go to `cache`
+    ///
+    /// Kernels TensorRT-RTX compiles for this GPU on first use are stored in
+    /// the cache and reused by every context sharing it, including those of
+    /// later processes once the cache is saved and reopened.
+    pub fn create_execution_context_with_cache<'c>(
+        &'c self,
+        strategy: AllocationStrategy,
+        cache: &'c RuntimeCache<'_>,
+    ) -> Result<ExecutionContext<'c>> {
+        let _device = DeviceGuard::new(self.device)?;
+        let mut context_ptr: *mut TrtxExecutionContext = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_engine_create_execution_context_with_cache(
+                self.inner,
+                strategy as i32,
+                cache.as_ptr(),
+                &mut context_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(ExecutionContext {
+            inner: context_ptr,
+            profiler: None,
+            engine: self,
+        })
+    }
+
+    /// Get the number of layers in the built engine
+    pub fn get_nb_layers(&self) -> Result<i32> {
+        let mut count: i32 = 0;
+
+        let result = unsafe { trtx_cuda_engine_get_nb_layers(self.inner, &mut count) };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(count)
+    }
+
+    /// Create an inspector describing the engine's layers
+    pub fn create_engine_inspector(&self) -> Result<EngineInspector<'_>> {
+        let mut inspector_ptr: *mut TrtxEngineInspector = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_cuda_engine_create_engine_inspector(
+                self.inner,
+                &mut inspector_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(EngineInspector::from_raw(inspector_ptr))
+    }
+
     /// Create an execution context for inference
     pub fn create_execution_context(&self) -> Result<ExecutionContext<'_>> {
+        let _device = DeviceGuard::new(self.device)?;
         let mut context_ptr: *mut TrtxExecutionContext = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_cuda_engine_create_execution_context(
                 self.inner,
                 &mut context_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(ExecutionContext {
             inner: context_ptr,
-            _engine: std::marker::PhantomData,
+            profiler: None,
+            engine: self,
         })
     }
 }
@@ -76,6 +554,7 @@ impl CudaEngine {
 impl Drop for CudaEngine {
     fn drop(&mut self) {
         if !self.inner.is_null() {
+            let _device = DeviceGuard::new(self.device);
             unsafe {
                 trtx_cuda_engine_destroy(self.inner);
             }
@@ -89,12 +568,17 @@ unsafe impl Sync for CudaEngine {}
 /// Execution context for running inference
 pub struct ExecutionContext<'a> {
     inner: *mut TrtxExecutionContext,
-    _engine: std::marker::PhantomData<&'a CudaEngine>,
+    // Dropped after the context is destroyed in `drop`
+    profiler: Option<ProfilerHandle>,
+    engine: &'a CudaEngine,
 }
 
 impl<'a> ExecutionContext<'a> {
     /// Set the address of a tensor for input or output
     ///
+    /// Names are looked up in the engine's [`BindingTable`], so known
+    /// tensors are bound without allocating.
+    ///
     /// # Safety
     ///
     /// The caller must ensure:
@@ -106,19 +590,141 @@ impl<'a> ExecutionContext<'a> {
         name: &str,
         data: *mut std::ffi::c_void,
     ) -> Result<()> {
-        let name_cstr = std::ffi::CString::new(name)?;
-        let mut error_msg = [0i8; 1024];
+        let name_cstr = self.c_name(name)?;
+        self.set_tensor_address_c(&name_cstr, data)
+    }
 
+    /// Set the address of the tensor at `index` in the engine's [`BindingTable`]
+    ///
+    /// # Safety
+    ///
+    /// Same requirements as [`set_tensor_address`](Self::set_tensor_address).
+    pub unsafe fn set_tensor_address_at(
+        &mut self,
+        index: usize,
+        data: *mut std::ffi::c_void,
+    ) -> Result<()> {
+        let name = self.engine.binding_table()?.c_name_checked(index)?;
+        self.set_tensor_address_c(name, data)
+    }
+
+    unsafe fn set_tensor_address_c(
+        &mut self,
+        name: &CStr,
+        data: *mut std::ffi::c_void,
+    ) -> Result<()> {
         let result = trtx_execution_context_set_tensor_address(
             self.inner,
-            name_cstr.as_ptr(),
+            name.as_ptr(),
             data,
-            error_msg.as_mut_ptr(),
-            error_msg.len(),
+            std::ptr::null_mut(),
+            0,
         );
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Set the concrete shape of an input with runtime dimensions
+    ///
+    /// The shape must lie within the active optimization profile. Output
+    /// shapes can be read back with [`get_tensor_shape`](Self::get_tensor_shape)
+    /// once every dynamic input has a shape.
+    pub fn set_input_shape(&mut self, name: &str, shape: &[i64]) -> Result<()> {
+        let name_cstr = self.c_name(name)?;
+        self.set_input_shape_c(&name_cstr, shape)
+    }
+
+    /// Set the shape of the input at `index` in the engine's [`BindingTable`]
+    pub fn set_input_shape_at(&mut self, index: usize, shape: &[i64]) -> Result<()> {
+        let name = self.engine.binding_table()?.c_name_checked(index)?;
+        self.set_input_shape_c(name, shape)
+    }
+
+    fn set_input_shape_c(&mut self, name: &CStr, shape: &[i64]) -> Result<()> {
+        let dims = to_dims(shape)?;
+
+        let result = unsafe {
+            trtx_execution_context_set_input_shape(
+                self.inner,
+                name.as_ptr(),
+                &dims,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get the shape of a tensor as resolved for the current input shapes
+    pub fn get_tensor_shape(&self, name: &str) -> Result<Vec<i64>> {
+        let name_cstr = self.c_name(name)?;
+        self.get_tensor_shape_c(&name_cstr)
+    }
+
+    /// Get the resolved shape of the tensor at `index` in the engine's [`BindingTable`]
+    pub fn get_tensor_shape_at(&self, index: usize) -> Result<Vec<i64>> {
+        let name = self.engine.binding_table()?.c_name_checked(index)?;
+        self.get_tensor_shape_c(name)
+    }
+
+    fn get_tensor_shape_c(&self, name: &CStr) -> Result<Vec<i64>> {
+        let mut dims = TrtxDims::default();
+
+        let result = unsafe {
+            trtx_execution_context_get_tensor_shape(
+                self.inner,
+                name.as_ptr(),
+                &mut dims,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(from_dims(&dims))
+    }
+
+    /// Interned name for engine tensors; unknown names are passed through for TensorRT to reject
+    fn c_name(&self, name: &str) -> Result<Cow<'a, CStr>> {
+        let table = self.engine.binding_table()?;
+        match table.index_of(name) {
+            Some(index) => Ok(Cow::Borrowed(table.c_name_checked(index)?)),
+            None => Ok(Cow::Owned(CString::new(name)?)),
+        }
+    }
+
+    /// Switch to another optimization profile, ordered on `stream`
+    ///
+    /// Input shapes must be set again afterwards.
+    pub fn set_optimization_profile_async(
+        &mut self,
+        profile_index: i32,
+        stream: &CudaStream,
+    ) -> Result<()> {
+        let result = unsafe {
+            trtx_execution_context_set_optimization_profile_async(
+                self.inner,
+                profile_index,
+                stream.as_raw(),
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
         }
 
         Ok(())
@@ -126,33 +732,295 @@ impl<'a> ExecutionContext<'a> {
 
     /// Enqueue inference work on a CUDA stream
     ///
+    /// The call returns as soon as the work is queued; synchronize `stream`
+    /// before reading outputs.
+    ///
     /// # Safety
     ///
     /// The caller must ensure:
-    /// - `cuda_stream` is a valid CUDA stream handle (or null for default stream)
     /// - All tensor addresses have been set
+    /// - Bound memory stays valid until `stream` has been synchronized
     /// - CUDA context is properly initialized
-    pub unsafe fn enqueue_v3(&mut self, cuda_stream: *mut std::ffi::c_void) -> Result<()> {
-        let mut error_msg = [0i8; 1024];
+    pub unsafe fn enqueue_v3(&mut self, stream: &CudaStream) -> Result<()> {
+        let result =
+            trtx_execution_context_enqueue_v3(self.inner, stream.as_ptr(), std::ptr::null_mut(), 0);
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
 
-        let result = trtx_execution_context_enqueue_v3(
+    /// Bind, upload, run and read back a request in a single FFI call
+    ///
+    /// Applies every shape in `bindings`, then every address, then queues the
+    /// host-to-device copies, the inference and the device-to-host copies on
+    /// `stream`, and with `synchronize` waits for them. This replaces one
+    /// call per tensor address, shape and copy plus the enqueue.
+    ///
+    /// # Safety
+    ///
+    /// Bound addresses must satisfy the [`set_tensor_address`](Self::set_tensor_address)
+    /// contract, and each copy must fit the tensor's device memory. Without
+    /// `synchronize` the host memory of the copies must stay valid, and the
+    /// output memory untouched, until the stream has finished.
+    pub unsafe fn bind_and_enqueue(
+        &mut self,
+        bindings: &[TensorBinding<'_>],
+        stream: &CudaStream,
+        synchronize: bool,
+    ) -> Result<()> {
+        let result = trtx_execution_context_bind_and_enqueue(
             self.inner,
-            cuda_stream,
-            error_msg.as_mut_ptr(),
-            error_msg.len(),
+            // TensorBinding is a transparent wrapper of the FFI struct
+            bindings.as_ptr() as *const TrtxTensorBinding,
+            bindings.len(),
+            stream.as_ptr(),
+            synchronize as i32,
+            std::ptr::null_mut(),
+            0,
         );
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(())
     }
+
+    /// Set the activation memory of a context created with [`AllocationStrategy::UserManaged`]
+    ///
+    /// # Safety
+    ///
+    /// `memory` must point to at least `size` bytes of device memory, with
+    /// `size` no smaller than [`CudaEngine::get_device_memory_size`] (or the
+    /// value from [`update_device_memory_size_for_shapes`](Self::update_device_memory_size_for_shapes)).
+    /// The memory must stay valid, and not be used by anything else, until
+    /// work enqueued with it has completed.
+    pub unsafe fn set_device_memory(
+        &mut self,
+        memory: *mut std::ffi::c_void,
+        size: usize,
+    ) -> Result<()> {
+        let result = trtx_execution_context_set_device_memory(
+            self.inner,
+            memory,
+            size as i64,
+            std::ptr::null_mut(),
+            0,
+        );
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get the activation memory needed for the input shapes set so far
+    ///
+    /// Usually smaller than the engine-wide size when the shapes are below
+    /// the profile's max.
+    pub fn update_device_memory_size_for_shapes(&mut self) -> Result<usize> {
+        let mut size: i64 = 0;
+
+        let result = unsafe {
+            trtx_execution_context_update_device_memory_size_for_shapes(
+                self.inner,
+                &mut size,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(size.max(0) as usize)
+    }
+
+    /// Replay [`enqueue_v3`](Self::enqueue_v3) from captured CUDA graphs
+    ///
+    /// A graph is captured per combination of optimization profile, input
+    /// shapes and tensor addresses, on the second enqueue with that
+    /// combination (the first runs normally as a warm-up). Later enqueues
+    /// with the same combination launch the graph instead of each kernel,
+    /// which removes most of the launch overhead for small models. Changing
+    /// a shape or address switches to another graph automatically; up to
+    /// `max_graphs` are kept, least recently used first out.
+    ///
+    /// Enqueues on the default stream and engines that cannot be captured
+    /// keep running normally.
+    pub fn enable_cuda_graphs(&mut self, max_graphs: usize) -> Result<()> {
+        self.set_cuda_graphs(true, max_graphs)
+    }
+
+    /// Stop using CUDA graphs and release the captured ones
+    pub fn disable_cuda_graphs(&mut self) -> Result<()> {
+        self.set_cuda_graphs(false, 1)
+    }
+
+    fn set_cuda_graphs(&mut self, enabled: bool, max_graphs: usize) -> Result<()> {
+        let max_graphs = i32::try_from(max_graphs)
+            .map_err(|_| Error::InvalidArgument(format!("Too many graphs: {max_graphs}")))?;
+
+        let result = unsafe {
+            trtx_execution_context_set_cuda_graphs(
+                self.inner,
+                enabled as i32,
+                max_graphs,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Report the time of every layer of every enqueue to `profiler`
+    ///
+    /// Profiled enqueues run eagerly even with CUDA graphs enabled, since a
+    /// graph replay would not report layers, and TensorRT waits for each
+    /// one to finish before returning, so profile with a representative
+    /// workload rather than in production.
+    pub fn set_profiler(&mut self, profiler: Arc<dyn Profiler>) -> Result<()> {
+        let handle = ProfilerHandle::new(profiler)?;
+        self.attach_profiler(handle.as_ptr())?;
+        // Replaces (and frees) any profiler attached before
+        self.profiler = Some(handle);
+        Ok(())
+    }
+
+    /// Detach the profiler set with [`set_profiler`](Self::set_profiler)
+    pub fn clear_profiler(&mut self) -> Result<()> {
+        self.attach_profiler(std::ptr::null_mut())?;
+        self.profiler = None;
+        Ok(())
+    }
+
+    fn attach_profiler(&mut self, profiler: *mut TrtxProfiler) -> Result<()> {
+        let result = unsafe {
+            trtx_execution_context_set_profiler(self.inner, profiler, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(())
+    }
+
+    /// Get the raw pointer (for internal use)
+    pub(crate) fn as_ptr(&self) -> *mut TrtxExecutionContext {
+        self.inner
+    }
+
+    /// Get counters of the CUDA graph cache
+    pub fn cuda_graph_stats(&self) -> CudaGraphStats {
+        let mut cached: i32 = 0;
+        let mut captures: i64 = 0;
+        let mut replays: i64 = 0;
+
+        unsafe {
+            trtx_execution_context_get_cuda_graph_stats(
+                self.inner,
+                &mut cached,
+                &mut captures,
+                &mut replays,
+            );
+        }
+
+        CudaGraphStats {
+            cached_graphs: cached.max(0) as usize,
+            captures: captures.max(0) as u64,
+            replays: replays.max(0) as u64,
+        }
+    }
+}
+
+/// One tensor of an [`ExecutionContext::bind_and_enqueue`] call
+///
+/// Starts out binding nothing; each builder method adds one step. `'a`
+/// ties the binding to the host memory of its copies.
+#[repr(transparent)]
+#[derive(Debug)]
+pub struct TensorBinding<'a> {
+    raw: TrtxTensorBinding,
+    _host: std::marker::PhantomData<&'a mut [u8]>,
+}
+
+impl<'a> TensorBinding<'a> {
+    /// Refer to the tensor at `index` in the engine's [`BindingTable`]
+    pub fn new(index: usize) -> Self {
+        TensorBinding {
+            raw: TrtxTensorBinding {
+                index: i32::try_from(index).unwrap_or(-1),
+                address: std::ptr::null_mut(),
+                // Negative rank keeps the current shape
+                shape: TrtxDims {
+                    nb_dims: -1,
+                    ..TrtxDims::default()
+                },
+                host_input: std::ptr::null(),
+                host_input_size: 0,
+                host_output: std::ptr::null_mut(),
+                host_output_size: 0,
+            },
+            _host: std::marker::PhantomData,
+        }
+    }
+
+    /// Bind the tensor to `address` instead of keeping its current binding
+    pub fn address(mut self, address: *mut std::ffi::c_void) -> Self {
+        self.raw.address = address;
+        self
+    }
+
+    /// Set the input's shape before anything else
+    pub fn shape(mut self, shape: &[i64]) -> Result<Self> {
+        self.raw.shape = to_dims(shape)?;
+        Ok(self)
+    }
+
+    /// Copy `host` to the tensor's device memory before the inference
+    pub fn upload(mut self, host: &'a [u8]) -> Self {
+        self.raw.host_input = host.as_ptr() as *const std::ffi::c_void;
+        self.raw.host_input_size = host.len();
+        self
+    }
+
+    /// Copy the tensor's device memory into `host` after the inference
+    pub fn download(mut self, host: &'a mut [u8]) -> Self {
+        self.raw.host_output = host.as_mut_ptr() as *mut std::ffi::c_void;
+        self.raw.host_output_size = host.len();
+        self
+    }
+}
+
+// Holds only addresses, and borrows its host memory like `&'a mut [u8]`
+unsafe impl Send for TensorBinding<'_> {}
+
+/// Counters of an execution context's CUDA graph cache
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CudaGraphStats {
+    /// Graphs currently instantiated
+    pub cached_graphs: usize,
+    /// Graphs captured so far, including evicted ones
+    pub captures: u64,
+    /// Enqueues served by launching a cached graph
+    pub replays: u64,
 }
 
 impl Drop for ExecutionContext<'_> {
     fn drop(&mut self) {
         if !self.inner.is_null() {
+            let _device = DeviceGuard::new(self.engine.device);
             unsafe {
                 trtx_execution_context_destroy(self.inner);
             }
@@ -163,40 +1031,50 @@ impl Drop for ExecutionContext<'_> {
 unsafe impl Send for ExecutionContext<'_> {}
 
 /// Runtime for deserializing engines
+///
+/// Engines are deserialized onto the runtime's device, whatever device is
+/// current when they are loaded.
 pub struct Runtime<'a> {
     inner: *mut TrtxRuntime,
+    device: i32,
     _logger: &'a Logger,
 }
 
 impl<'a> Runtime<'a> {
-    /// Create a new runtime
+    /// Create a runtime for the device current on this thread
     pub fn new(logger: &'a Logger) -> Result<Self> {
+        Self::on_device(logger, cuda::current_device()?)
+    }
+
+    /// Create a runtime that places engines on `device`
+    pub fn on_device(logger: &'a Logger, device: i32) -> Result<Self> {
+        let _device = DeviceGuard::new(device)?;
         let mut runtime_ptr: *mut TrtxRuntime = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
-            trtx_runtime_create(
-                logger.as_ptr(),
-                &mut runtime_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
-            )
+            trtx_runtime_create(logger.as_ptr(), &mut runtime_ptr, std::ptr::null_mut(), 0)
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
         Ok(Runtime {
             inner: runtime_ptr,
+            device,
             _logger: logger,
         })
     }
 
+    /// Get the device engines are deserialized on
+    pub fn device(&self) -> i32 {
+        self.device
+    }
+
     /// Deserialize a CUDA engine from serialized data
     pub fn deserialize_cuda_engine(&self, data: &[u8]) -> Result<CudaEngine> {
+        let _device = DeviceGuard::new(self.device)?;
         let mut engine_ptr: *mut TrtxCudaEngine = std::ptr::null_mut();
-        let mut error_msg = [0i8; 1024];
 
         let result = unsafe {
             trtx_runtime_deserialize_cuda_engine(
@@ -204,16 +1082,47 @@ impl<'a> Runtime<'a> {
                 data.as_ptr() as *const std::ffi::c_void,
                 data.len(),
                 &mut engine_ptr,
-                error_msg.as_mut_ptr(),
-                error_msg.len(),
+                std::ptr::null_mut(),
+                0,
             )
         };
 
         if result != TRTX_SUCCESS as i32 {
-            return Err(Error::from_ffi(result, &error_msg));
+            return Err(Error::last_ffi(result));
         }
 
-        Ok(CudaEngine { inner: engine_ptr })
+        Ok(CudaEngine::from_raw(engine_ptr, self.device))
+    }
+
+    /// Deserialize a CUDA engine from a plan file
+    ///
+    /// The file is memory-mapped and streamed to TensorRT, so the plan is
+    /// never read into a heap buffer and its pages are shared through the
+    /// page cache with other processes loading the same file.
+    pub fn deserialize_from_file<P: AsRef<Path>>(&self, path: P) -> Result<CudaEngine> {
+        let path = path.as_ref();
+        let path_str = path.to_str().ok_or_else(|| {
+            Error::InvalidArgument(format!("Plan path is not valid UTF-8: {}", path.display()))
+        })?;
+        let path_cstr = CString::new(path_str)?;
+        let _device = DeviceGuard::new(self.device)?;
+        let mut engine_ptr: *mut TrtxCudaEngine = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_runtime_deserialize_cuda_engine_from_file(
+                self.inner,
+                path_cstr.as_ptr(),
+                &mut engine_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(CudaEngine::from_raw(engine_ptr, self.device))
     }
 }
 
@@ -228,3 +1137,203 @@ impl Drop for Runtime<'_> {
 }
 
 unsafe impl Send for Runtime<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_deserialize_from_file() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+
+        let path = std::env::temp_dir().join(format!("trtx-plan-{}.plan", std::process::id()));
+        std::fs::write(&path, [0u8; 16]).unwrap();
+        let engine = runtime.deserialize_from_file(&path).unwrap();
+        assert!(engine.get_nb_io_tensors().is_ok());
+        std::fs::remove_file(&path).unwrap();
+
+        assert!(runtime.deserialize_from_file(&path).is_err());
+    }
+
+    #[test]
+    fn test_tensor_introspection() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+
+        let tensors = engine.io_tensors().unwrap();
+        assert_eq!(tensors.len(), 2);
+        assert!(tensors[0].is_input());
+        assert_eq!(tensors[0].shape, vec![-1, 3, 224, 224]);
+        assert_eq!(tensors[1].io_mode, TensorIOMode::Output);
+        assert_eq!(tensors[1].data_type, DataType::Float);
+        assert_eq!(tensors[1].size_in_bytes(), None);
+
+        match engine.get_tensor_shape("missing") {
+            Err(Error::Unknown(msg)) | Err(Error::InvalidArgument(msg)) => {
+                assert!(
+                    msg.contains("missing") || msg.contains("Unknown tensor"),
+                    "{msg}"
+                )
+            }
+            other => panic!("expected a tensor lookup error, got {other:?}"),
+        }
+        // The message is taken, so an unrelated later failure cannot repeat it
+        assert_eq!(
+            unsafe { CStr::from_ptr(trtx_get_last_error()) }.to_bytes(),
+            b""
+        );
+    }
+
+    #[test]
+    fn test_bind_by_index() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let table = engine.binding_table().unwrap();
+        assert!(std::ptr::eq(table, engine.binding_table().unwrap()));
+        let input = table.index_of("input").unwrap();
+        let output = table.index_of("output").unwrap();
+
+        let mut context = engine.create_execution_context().unwrap();
+        let mut out = [0u8; 4];
+        context
+            .set_input_shape_at(input, &[2, 3, 224, 224])
+            .unwrap();
+        assert_eq!(context.get_tensor_shape_at(output).unwrap(), vec![2, 1000]);
+        unsafe {
+            context
+                .set_tensor_address_at(output, out.as_mut_ptr() as *mut _)
+                .unwrap();
+            assert!(context
+                .set_tensor_address_at(table.len(), out.as_mut_ptr() as *mut _)
+                .is_err());
+        }
+    }
+
+    #[test]
+    fn test_bind_and_enqueue() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let mut context = engine.create_execution_context().unwrap();
+        let stream = CudaStream::new().unwrap();
+
+        // Mock device memory is host memory, so the output reads back what was uploaded
+        let mut device = [0u8; 4];
+        let host_in = [1u8, 2, 3, 4];
+        let mut host_out = [0u8; 4];
+        let device_ptr = device.as_mut_ptr() as *mut std::ffi::c_void;
+        {
+            let bindings = [
+                TensorBinding::new(0)
+                    .shape(&[2, 3, 224, 224])
+                    .unwrap()
+                    .address(device_ptr)
+                    .upload(&host_in),
+                TensorBinding::new(1)
+                    .address(device_ptr)
+                    .download(&mut host_out),
+            ];
+            unsafe {
+                context.bind_and_enqueue(&bindings, &stream, true).unwrap();
+            }
+        }
+        assert_eq!(host_out, host_in);
+        assert_eq!(context.get_tensor_shape("output").unwrap(), vec![2, 1000]);
+
+        let out_of_range = [TensorBinding::new(2)];
+        assert!(unsafe { context.bind_and_enqueue(&out_of_range, &stream, true) }.is_err());
+    }
+
+    #[test]
+    fn test_weight_streaming_budget() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let mut engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+
+        let info = engine.weight_streaming().unwrap();
+        assert_eq!(info.budget, info.streamable_weights_size);
+        assert_eq!(info.scratch_memory_size, 0);
+
+        let applied = engine
+            .set_weight_streaming_budget(WeightStreamingBudget::Automatic)
+            .unwrap();
+        assert_eq!(applied, info.automatic_budget);
+        let info = engine.weight_streaming().unwrap();
+        assert_eq!(info.budget, applied);
+        assert!(info.scratch_memory_size > 0);
+
+        let too_large = WeightStreamingBudget::Bytes(info.streamable_weights_size + 1);
+        assert!(engine.set_weight_streaming_budget(too_large).is_err());
+        engine
+            .set_weight_streaming_budget(WeightStreamingBudget::Resident)
+            .unwrap();
+        assert_eq!(engine.weight_streaming().unwrap().scratch_memory_size, 0);
+    }
+
+    #[test]
+    fn test_dynamic_input_shape() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        assert_eq!(engine.get_nb_optimization_profiles().unwrap(), 1);
+        assert_eq!(
+            engine
+                .get_profile_shape("input", 0, ProfileSelector::Max)
+                .unwrap(),
+            vec![8, 3, 224, 224]
+        );
+
+        let mut context = engine.create_execution_context().unwrap();
+        let stream = CudaStream::new().unwrap();
+        context.set_optimization_profile_async(0, &stream).unwrap();
+        context.set_input_shape("input", &[4, 3, 224, 224]).unwrap();
+        assert_eq!(context.get_tensor_shape("output").unwrap(), vec![4, 1000]);
+
+        // Outside the profile's range
+        assert!(context.set_input_shape("input", &[9, 3, 224, 224]).is_err());
+    }
+
+    #[test]
+    fn test_cuda_graph_replay() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let mut context = engine.create_execution_context().unwrap();
+        let stream = CudaStream::new().unwrap();
+        let mut a = [0u8; 4];
+        let mut b = [0u8; 4];
+
+        context.enable_cuda_graphs(4).unwrap();
+        let bind_and_run = |context: &mut ExecutionContext, out: *mut u8| unsafe {
+            context.set_tensor_address("output", out as *mut _).unwrap();
+            context.enqueue_v3(&stream).unwrap();
+        };
+
+        // Warm-up, capture, replay
+        for _ in 0..3 {
+            bind_and_run(&mut context, a.as_mut_ptr());
+        }
+        let stats = context.cuda_graph_stats();
+        assert_eq!(
+            (stats.cached_graphs, stats.captures, stats.replays),
+            (1, 1, 1)
+        );
+
+        // A new output address needs its own graph; the old one is kept
+        for _ in 0..2 {
+            bind_and_run(&mut context, b.as_mut_ptr());
+        }
+        bind_and_run(&mut context, a.as_mut_ptr());
+        let stats = context.cuda_graph_stats();
+        assert_eq!(
+            (stats.cached_graphs, stats.captures, stats.replays),
+            (2, 2, 2)
+        );
+
+        context.disable_cuda_graphs().unwrap();
+        assert_eq!(context.cuda_graph_stats().cached_graphs, 0);
+    }
+}
@@ -0,0 +1,195 @@
+//! Persisting the kernels TensorRT-RTX compiles just in time
+//!
+//! TensorRT-RTX plans are portable across GPUs and compile their kernels for
+//! the GPU at hand the first time each shape runs, so a fresh process pays
+//! that JIT latency again. A [`RuntimeCache`] collects the compiled kernels
+//! of every context created with it and can be saved to disk, letting the
+//! next process start at steady-state speed:
+//!
+//! ```rust,no_run
+//! use trtx::{AllocationStrategy, Logger, Runtime, RuntimeCache};
+//! # fn main() -> trtx::Result<()> {
+//! let logger = Logger::stderr()?;
+//! let runtime = Runtime::new(&logger)?;
+//! let engine = runtime.deserialize_from_file("model.engine")?;
+//!
+//! // Loaded if the file exists, and saved again when dropped
+//! let cache = RuntimeCache::open(&engine, "model.rtcache")?;
+//! let context = engine.create_execution_context_with_cache(AllocationStrategy::Static, &cache)?;
+//! # let _ = context;
+//! # Ok(())
+//! # }
+//! ```
+//!
+//! [`SessionConfig::runtime_cache_path`](crate::SessionConfig::runtime_cache_path)
+//! does the same for every context of an [`InferenceSession`](crate::InferenceSession).
+
+use crate::builder::HostMemory;
+use crate::engine_cache::write_atomically;
+use crate::error::{Error, Result};
+use crate::runtime::CudaEngine;
+use std::marker::PhantomData;
+use std::path::{Path, PathBuf};
+use trtx_sys::*;
+
+/// JIT kernel cache shared by the execution contexts of one engine (IRuntimeCache)
+///
+/// Contexts keep using the cache while they run, so it has to outlive them,
+/// and it belongs to the engine it was created for. Kernels are compiled for
+/// one GPU and TensorRT-RTX version; a cache written for others is rejected.
+pub struct RuntimeCache<'a> {
+    inner: *mut TrtxRuntimeCache,
+    // Saved to on drop, if set
+    path: Option<PathBuf>,
+    _engine: PhantomData<&'a CudaEngine>,
+}
+
+impl<'a> RuntimeCache<'a> {
+    /// Create an empty cache for `engine`'s contexts
+    pub fn new(engine: &'a CudaEngine) -> Result<Self> {
+        Self::from_bytes(engine, &[])
+    }
+
+    /// Restore a cache serialized by [`serialize`](Self::serialize)
+    ///
+    /// Fails if TensorRT-RTX rejects the blob, e.g. because it was written on
+    /// another GPU or by another version.
+    pub fn from_bytes(engine: &'a CudaEngine, blob: &[u8]) -> Result<Self> {
+        let mut cache_ptr: *mut TrtxRuntimeCache = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_runtime_cache_create(
+                engine.as_ptr(),
+                blob.as_ptr() as *const std::ffi::c_void,
+                blob.len(),
+                &mut cache_ptr,
+                std::ptr::null_mut(),
+                0,
+            )
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(RuntimeCache {
+            inner: cache_ptr,
+            path: None,
+            _engine: PhantomData,
+        })
+    }
+
+    /// Load the cache stored at `path` and save it back there when dropped
+    ///
+    /// A missing file, or one TensorRT-RTX rejects after a driver or GPU
+    /// change, gives an empty cache that then replaces it. Use one file per
+    /// engine.
+    pub fn open<P: AsRef<Path>>(engine: &'a CudaEngine, path: P) -> Result<Self> {
+        let path = path.as_ref();
+        let blob = match std::fs::read(path) {
+            Ok(blob) => blob,
+            Err(e) if e.kind() == std::io::ErrorKind::NotFound => Vec::new(),
+            Err(e) => return Err(e.into()),
+        };
+
+        let mut cache = match Self::from_bytes(engine, &blob) {
+            Ok(cache) => cache,
+            Err(Error::InvalidArgument(_)) if !blob.is_empty() => Self::new(engine)?,
+            Err(e) => return Err(e),
+        };
+        cache.path = Some(path.to_path_buf());
+        Ok(cache)
+    }
+
+    /// Get the file the cache is saved to on drop, if it was opened from one
+    pub fn path(&self) -> Option<&Path> {
+        self.path.as_deref()
+    }
+
+    /// Serialize the kernels compiled so far
+    pub fn serialize(&self) -> Result<HostMemory> {
+        let mut memory_ptr: *mut TrtxHostMemory = std::ptr::null_mut();
+
+        let result = unsafe {
+            trtx_runtime_cache_serialize(self.inner, &mut memory_ptr, std::ptr::null_mut(), 0)
+        };
+
+        if result != TRTX_SUCCESS as i32 {
+            return Err(Error::last_ffi(result));
+        }
+
+        Ok(unsafe { HostMemory::from_raw(memory_ptr) })
+    }
+
+    /// Write the cache to `path`, replacing the file atomically
+    pub fn save_to<P: AsRef<Path>>(&self, path: P) -> Result<()> {
+        write_atomically(path.as_ref(), &self.serialize()?)
+    }
+
+    /// Write the cache to the file it was opened from
+    ///
+    /// Does nothing for caches not created with [`open`](Self::open).
+    /// Dropping the cache saves it too, but ignores errors.
+    pub fn save(&self) -> Result<()> {
+        match &self.path {
+            Some(path) => self.save_to(path),
+            None => Ok(()),
+        }
+    }
+
+    pub(crate) fn as_ptr(&self) -> *mut TrtxRuntimeCache {
+        self.inner
+    }
+}
+
+impl Drop for RuntimeCache<'_> {
+    fn drop(&mut self) {
+        if !self.inner.is_null() {
+            let _ = self.save();
+            unsafe {
+                trtx_runtime_cache_destroy(self.inner);
+            }
+        }
+    }
+}
+
+// TensorRT-RTX synchronizes the contexts filling one cache
+unsafe impl Send for RuntimeCache<'_> {}
+unsafe impl Sync for RuntimeCache<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::cuda::CudaStream;
+    use crate::runtime::AllocationStrategy;
+    use crate::{Logger, Runtime};
+
+    #[test]
+    fn test_runtime_cache_persists_across_opens() {
+        let logger = Logger::stderr().unwrap();
+        let runtime = Runtime::new(&logger).unwrap();
+        let engine = runtime.deserialize_cuda_engine(&[0u8; 16]).unwrap();
+        let path = std::env::temp_dir().join(format!("trtx-rtcache-{}", std::process::id()));
+        std::fs::write(&path, b"stale").unwrap();
+
+        let compiled = {
+            // A rejected file starts over with an empty cache
+            let cache = RuntimeCache::open(&engine, &path).unwrap();
+            let empty = cache.serialize().unwrap().to_vec();
+            let mut context = engine
+                .create_execution_context_with_cache(AllocationStrategy::Static, &cache)
+                .unwrap();
+            let stream = CudaStream::new().unwrap();
+            unsafe { context.enqueue_v3(&stream).unwrap() };
+            let compiled = cache.serialize().unwrap().to_vec();
+            assert_ne!(compiled, empty);
+            compiled
+        };
+
+        let reopened = RuntimeCache::open(&engine, &path).unwrap();
+        assert_eq!(reopened.serialize().unwrap().to_vec(), compiled);
+        assert!(RuntimeCache::from_bytes(&engine, b"stale").is_err());
+        drop(reopened);
+        std::fs::remove_file(&path).unwrap();
+    }
+}
@@ -0,0 +1,1433 @@
+//! Reusable inference sessions
+//!
+//! An [`InferenceSession`] is built once from ONNX bytes or a serialized plan
+//! and then serves any number of [`InferenceSession::run`] calls. It owns the
+//! logger, runtime, engine, a pool of execution contexts and their IO
+//! buffers, so a warm call does not build, deserialize or allocate anything
+//! on the device.
+
+use crate::bench;
+use crate::builder::{network_flags, BuilderConfig, BuilderFlag, HostMemory, MemoryPoolType};
+use crate::cuda::{self, CudaStream, DeviceBuffer, DeviceGuard, PinnedHostBuffer};
+use crate::data::{self, TensorData};
+use crate::engine_cache::EngineCache;
+use crate::error::{Error, Result};
+use crate::executor::{TensorInput, TensorOutput};
+use crate::memory::{default_device_allocator, DeviceAllocator};
+use crate::pool::SlotPool;
+use crate::refit::Refitter;
+use crate::runtime::{
+    AllocationStrategy, CudaEngine, ExecutionContext, Runtime, TensorBinding, WeightStreamingBudget,
+};
+use crate::runtime_cache::RuntimeCache;
+use crate::tensor::{ProfileSelector, TensorInfo};
+use crate::view::{TensorView, TensorViewMut};
+use crate::{Builder, Logger, OnnxParser};
+use std::collections::HashMap;
+use std::path::{Path, PathBuf};
+use std::sync::{Arc, Mutex};
+
+/// Shape range of one input within an optimization profile
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ShapeRange {
+    /// Input tensor name
+    pub input: String,
+    /// Smallest accepted shape
+    pub min: Vec<i64>,
+    /// Shape the kernels are tuned for
+    pub opt: Vec<i64>,
+    /// Largest accepted shape
+    pub max: Vec<i64>,
+}
+
+/// Configuration for [`InferenceSession`]
+#[derive(Clone)]
+pub struct SessionConfig {
+    /// Number of execution contexts (concurrent in-flight runs)
+    pub num_contexts: usize,
+    /// Builder workspace limit used when building from ONNX
+    pub workspace_size: usize,
+    /// Allocator for per-context device buffers
+    pub allocator: Arc<dyn DeviceAllocator>,
+    /// Reuse plans built by earlier processes instead of rebuilding from ONNX
+    pub engine_cache: Option<EngineCache>,
+    /// Optimization profiles for dynamic inputs when building from ONNX; one entry per profile
+    pub optimization_profiles: Vec<Vec<ShapeRange>>,
+    /// Distinct input-shape sets each context keeps buffers for before evicting the oldest
+    pub max_shape_buckets: usize,
+    /// Replay enqueues from captured CUDA graphs (see [`ExecutionContext::enable_cuda_graphs`])
+    pub cuda_graphs: bool,
+    /// Keep only this much of the weights on the GPU, streaming the rest from host memory
+    ///
+    /// Engines built from ONNX are then built strongly typed with
+    /// [`BuilderFlag::WeightStreaming`]; loaded plans must have been built that way.
+    pub weight_streaming: Option<WeightStreamingBudget>,
+    /// Build engines from ONNX with [`BuilderFlag::Refit`], for [`InferenceSession::refit_from_onnx`]
+    pub refittable: bool,
+    /// GPU to build and serve on; the device current on the constructing thread if None
+    pub device: Option<i32>,
+    /// File to load JIT-compiled kernels from and save them to when the session is dropped
+    ///
+    /// See [`RuntimeCache::open`]; use one file per model.
+    pub runtime_cache_path: Option<PathBuf>,
+}
+
+impl Default for SessionConfig {
+    fn default() -> Self {
+        SessionConfig {
+            num_contexts: 1,
+            workspace_size: 1 << 30,
+            allocator: Arc::clone(default_device_allocator()),
+            engine_cache: None,
+            optimization_profiles: Vec::new(),
+            max_shape_buckets: 8,
+            cuda_graphs: false,
+            weight_streaming: None,
+            refittable: false,
+            device: None,
+            runtime_cache_path: None,
+        }
+    }
+}
+
+/// Device buffer and pinned staging area for one IO tensor
+struct IoBinding {
+    device: DeviceBuffer,
+    staging: PinnedHostBuffer,
+}
+
+impl IoBinding {
+    fn new(size: usize, allocator: &Arc<dyn DeviceAllocator>) -> Result<Self> {
+        // Zero-element tensors still need a distinct, non-null address
+        let size = size.max(1);
+        Ok(IoBinding {
+            device: DeviceBuffer::new_in(size, allocator)?,
+            staging: PinnedHostBuffer::new(size)?,
+        })
+    }
+}
+
+/// Min and max shape of a dynamic input within one profile
+type ShapeBounds = (Vec<i64>, Vec<i64>);
+
+/// Identifies one set of concrete input shapes on one optimization profile
+#[derive(Debug, Clone, Default, PartialEq, Eq, Hash)]
+struct BucketKey {
+    profile: i32,
+    // Shapes of the engine inputs, in engine order
+    input_shapes: Vec<Vec<i64>>,
+}
+
+/// Exactly-sized buffers for one [`BucketKey`]
+struct ShapeBucket {
+    // Indexed like `InferenceSession::tensors`
+    bindings: Vec<IoBinding>,
+    // Resolved shape and byte size of every tensor
+    shapes: Vec<Vec<i64>>,
+    sizes: Vec<usize>,
+    last_used: u64,
+}
+
+impl ShapeBucket {
+    /// Allocate buffers for the shapes currently set on `context`
+    fn new(
+        tensors: &[TensorInfo],
+        context: &ExecutionContext<'_>,
+        allocator: &Arc<dyn DeviceAllocator>,
+    ) -> Result<Self> {
+        let mut bindings = Vec::with_capacity(tensors.len());
+        let mut shapes = Vec::with_capacity(tensors.len());
+        let mut sizes = Vec::with_capacity(tensors.len());
+
+        for info in tensors {
+            let shape = context.get_tensor_shape(&info.name)?;
+            let size = info.size_in_bytes_for(&shape).ok_or_else(|| {
+                Error::Runtime(format!(
+                    "Shape of '{}' is unresolved ({shape:?}) after setting input shapes",
+                    info.name
+                ))
+            })?;
+            bindings.push(IoBinding::new(size, allocator)?);
+            shapes.push(shape);
+            sizes.push(size);
+        }
+
+        Ok(ShapeBucket {
+            bindings,
+            shapes,
+            sizes,
+            last_used: 0,
+        })
+    }
+}
+
+/// One execution context with its own stream and per-shape IO buffers
+struct SessionSlot {
+    context: ExecutionContext<'static>,
+    stream: CudaStream,
+    // Active optimization profile
+    profile: i32,
+    // Input shapes last set on the context (for the active profile)
+    context_shapes: Option<Vec<Vec<i64>>>,
+    // Bucket whose buffers are currently bound on the context
+    bound: Option<BucketKey>,
+    buckets: HashMap<BucketKey, ShapeBucket>,
+    clock: u64,
+    scratch: RunScratch,
+}
+
+/// Per-run working state, kept in the slot so warm runs do not allocate
+#[derive(Default)]
+struct RunScratch {
+    // Position in the caller's inputs of each engine tensor (None for outputs)
+    inputs: Vec<Option<usize>>,
+    // Input shapes in engine tensor order (None for outputs)
+    shapes: Vec<Option<Vec<i64>>>,
+    // Bucket of the shapes set up by the last `prepare_shapes`
+    key: BucketKey,
+    // Always empty between runs; only the allocation is kept
+    bindings: Vec<TensorBinding<'static>>,
+}
+
+/// Where a session's ONNX model comes from
+#[derive(Clone, Copy)]
+pub(crate) enum OnnxSource<'a> {
+    Bytes(&'a [u8]),
+    // Parsed memory-mapped, with external data resolved next to the file
+    File(&'a Path),
+}
+
+/// Plan for a session built from ONNX: freshly built, or found in the engine cache
+pub(crate) enum SessionPlan {
+    Built(HostMemory),
+    Cached(PathBuf),
+}
+
+impl SessionPlan {
+    /// Build `source` with the settings of `config`, unless the cache has a plan
+    pub(crate) fn for_onnx(
+        logger: &Logger,
+        source: OnnxSource<'_>,
+        config: &SessionConfig,
+    ) -> Result<Self> {
+        // Build for (and key the cache on) the GPU the session will run on
+        let _device = match config.device {
+            Some(device) => Some(DeviceGuard::new(device)?),
+            None => None,
+        };
+        let builder = Builder::new(logger)?;
+        let builder_config = create_builder_config(&builder, config)?;
+
+        match &config.engine_cache {
+            Some(cache) => {
+                // Files are keyed on the model file alone, not its external data
+                let key = match source {
+                    OnnxSource::Bytes(bytes) => cache.key(bytes, &builder_config)?,
+                    OnnxSource::File(path) => cache.key(&std::fs::read(path)?, &builder_config)?,
+                };
+                if let Some(path) = cache.lookup(&key) {
+                    return Ok(SessionPlan::Cached(path));
+                }
+                let plan = build_plan(&builder, logger, source, &builder_config)?;
+                cache.store(&key, &plan)?;
+                Ok(SessionPlan::Built(plan))
+            }
+            None => Ok(SessionPlan::Built(build_plan(
+                &builder,
+                logger,
+                source,
+                &builder_config,
+            )?)),
+        }
+    }
+}
+
+/// A compiled model ready to serve inference requests
+///
+/// Runs may be issued concurrently from several threads; each takes one of
+/// the session's execution contexts from a lock-free pool and waits only if
+/// they are all busy.
+///
+/// Engines with dynamic inputs are served without padding: each run sets
+/// the actual input shapes, switching optimization profile if needed, and
+/// uses buffers sized for exactly those shapes. Each context keeps buffers
+/// for up to [`SessionConfig::max_shape_buckets`] shape sets, so alternating
+/// between a few request sizes does not reallocate.
+pub struct InferenceSession {
+    // Field order is drop order: contexts borrow the engine, the engine must
+    // be destroyed before the runtime, and the runtime borrows the logger.
+    slots: SlotPool<SessionSlot>,
+    // Used by the contexts, and borrows the engine
+    runtime_cache: Option<Box<RuntimeCache<'static>>>,
+    tensors: Vec<TensorInfo>,
+    // [profile][tensor] min/max shapes of dynamic inputs, None elsewhere
+    profile_ranges: Vec<Vec<Option<ShapeBounds>>>,
+    max_shape_buckets: usize,
+    cuda_graphs: bool,
+    // Made current for every run, so sessions on several GPUs can share threads
+    device: i32,
+    // Serializes refits and warm-ups, which each hold every slot
+    exclusive: Mutex<()>,
+    allocator: Arc<dyn DeviceAllocator>,
+    engine: Box<CudaEngine>,
+    _runtime: Runtime<'static>,
+    _logger: Box<Logger>,
+}
+
+impl InferenceSession {
+    /// Build an engine from ONNX bytes and create a session for it
+    ///
+    /// With [`SessionConfig::engine_cache`] set, a plan cached for the same
+    /// model, GPU, TensorRT-RTX version and builder settings is loaded
+    /// instead, and a freshly built plan is stored for the next process.
+    pub fn from_onnx(logger: Logger, onnx_bytes: &[u8], config: SessionConfig) -> Result<Self> {
+        Self::from_source(logger, OnnxSource::Bytes(onnx_bytes), config)
+    }
+
+    /// Build an engine from an ONNX file and create a session for it
+    ///
+    /// The model and its external data files are memory-mapped and the
+    /// initializers loaded in parallel (see [`OnnxParser::parse_mapped`]),
+    /// so models over 2 GB build without being read into memory. With
+    /// [`SessionConfig::engine_cache`] set, the cache key covers the model
+    /// file but not its external data: give changed weights a new file.
+    pub fn from_onnx_file<P: AsRef<Path>>(
+        logger: Logger,
+        path: P,
+        config: SessionConfig,
+    ) -> Result<Self> {
+        Self::from_source(logger, OnnxSource::File(path.as_ref()), config)
+    }
+
+    fn from_source(logger: Logger, source: OnnxSource<'_>, config: SessionConfig) -> Result<Self> {
+        match SessionPlan::for_onnx(&logger, source, &config)? {
+            SessionPlan::Built(plan) => Self::from_plan(logger, &plan, config),
+            SessionPlan::Cached(path) => Self::from_plan_file(logger, path, config),
+        }
+    }
+
+    /// Create a session from a serialized plan on disk
+    ///
+    /// The plan is memory-mapped rather than read into memory first.
+    pub fn from_plan_file<P: AsRef<Path>>(
+        logger: Logger,
+        path: P,
+        config: SessionConfig,
+    ) -> Result<Self> {
+        Self::with_engine(logger, config, |runtime| {
+            runtime.deserialize_from_file(path)
+        })
+    }
+
+    /// Create a session from a serialized plan
+    pub fn from_plan(logger: Logger, plan: &[u8], config: SessionConfig) -> Result<Self> {
+        Self::with_engine(logger, config, |runtime| {
+            runtime.deserialize_cuda_engine(plan)
+        })
+    }
+
+    /// Shared constructor; `load` deserializes the engine with the session's runtime
+    fn with_engine(
+        logger: Logger,
+        config: SessionConfig,
+        load: impl FnOnce(&Runtime<'static>) -> Result<CudaEngine>,
+    ) -> Result<Self> {
+        if config.num_contexts == 0 {
+            return Err(Error::InvalidArgument(
+                "Session needs at least one execution context".to_string(),
+            ));
+        }
+
+        let device = match config.device {
+            Some(device) => device,
+            None => cuda::current_device()?,
+        };
+        // Streams and buffers below are created on the current device
+        let _device = DeviceGuard::new(device)?;
+
+        let logger = Box::new(logger);
+        // SAFETY: the logger is boxed, never moved out, and dropped last
+        let logger_ref: &'static Logger = unsafe { &*(logger.as_ref() as *const Logger) };
+        let runtime = Runtime::on_device(logger_ref, device)?;
+
+        let mut engine = load(&runtime)?;
+        if let Some(budget) = config.weight_streaming {
+            // Has to happen before any context exists
+            engine.set_weight_streaming_budget(budget)?;
+        }
+        let engine = Box::new(engine);
+        // SAFETY: the engine is boxed and dropped after every context
+        let engine_ref: &'static CudaEngine = unsafe { &*(engine.as_ref() as *const CudaEngine) };
+
+        let tensors = engine.io_tensors()?;
+        // Built once here so binding by index never fails later
+        engine.binding_table()?;
+        let allocator = config.allocator;
+
+        let profile_ranges = (0..engine.get_nb_optimization_profiles()?)
+            .map(|profile| {
+                tensors
+                    .iter()
+                    .map(|info| {
+                        if !info.is_input() || info.is_static() {
+                            return Ok(None);
+                        }
+                        let min =
+                            engine.get_profile_shape(&info.name, profile, ProfileSelector::Min)?;
+                        let max =
+                            engine.get_profile_shape(&info.name, profile, ProfileSelector::Max)?;
+                        Ok(Some((min, max)))
+                    })
+                    .collect::<Result<Vec<_>>>()
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        let runtime_cache = match &config.runtime_cache_path {
+            Some(path) => Some(Box::new(RuntimeCache::open(engine_ref, path)?)),
+            None => None,
+        };
+        // SAFETY: the cache is boxed and dropped after every context, before the engine
+        let cache_ref: Option<&'static RuntimeCache<'static>> = runtime_cache
+            .as_deref()
+            .map(|cache| unsafe { &*(cache as *const RuntimeCache<'static>) });
+
+        let all_static = tensors.iter().all(TensorInfo::is_static);
+        let slots = (0..config.num_contexts)
+            .map(|_| {
+                let mut context = match cache_ref {
+                    Some(cache) => engine_ref
+                        .create_execution_context_with_cache(AllocationStrategy::Static, cache)?,
+                    None => engine_ref.create_execution_context()?,
+                };
+                if config.cuda_graphs {
+                    // One graph per shape bucket, since each bucket has its own addresses
+                    context.enable_cuda_graphs(config.max_shape_buckets.max(1))?;
+                }
+                let mut buckets = HashMap::new();
+
+                // Fully static engines get their only bucket up front
+                if all_static {
+                    let key = BucketKey {
+                        profile: 0,
+                        input_shapes: tensors
+                            .iter()
+                            .filter(|t| t.is_input())
+                            .map(|t| t.shape.clone())
+                            .collect(),
+                    };
+                    buckets.insert(key, ShapeBucket::new(&tensors, &context, &allocator)?);
+                }
+
+                Ok(SessionSlot {
+                    context,
+                    stream: CudaStream::new()?,
+                    profile: 0,
+                    context_shapes: None,
+                    bound: None,
+                    buckets,
+                    clock: 0,
+                    scratch: RunScratch::default(),
+                })
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        Ok(InferenceSession {
+            slots: SlotPool::new(slots),
+            runtime_cache,
+            tensors,
+            profile_ranges,
+            max_shape_buckets: config.max_shape_buckets.max(1),
+            cuda_graphs: config.cuda_graphs,
+            device,
+            exclusive: Mutex::new(()),
+            allocator,
+            engine,
+            _runtime: runtime,
+            _logger: logger,
+        })
+    }
+
+    /// Get the engine served by this session
+    pub fn engine(&self) -> &CudaEngine {
+        &self.engine
+    }
+
+    /// Get the GPU this session runs on
+    pub fn device(&self) -> i32 {
+        self.device
+    }
+
+    /// Write the JIT kernel cache to [`SessionConfig::runtime_cache_path`] now
+    ///
+    /// Dropping the session saves it as well; call this to keep the kernels
+    /// of a long-running process safe from a crash. Does nothing without a path.
+    pub fn save_runtime_cache(&self) -> Result<()> {
+        match &self.runtime_cache {
+            Some(cache) => cache.save(),
+            None => Ok(()),
+        }
+    }
+
+    /// Get the number of execution contexts
+    pub fn num_contexts(&self) -> usize {
+        self.slots.len()
+    }
+
+    /// Run zero-filled inferences on every context so the first real run is fast
+    ///
+    /// A context's first enqueue loads kernels lazily (and on TensorRT-RTX
+    /// JIT-compiles them for the GPU), allocates its shape bucket and
+    /// captures its CUDA graph. Each of the `iterations` rounds runs every
+    /// context once, concurrently. Dynamic inputs use `input_shapes`, or the
+    /// opt shape of profile 0 if unlisted.
+    pub fn warm_up(&self, input_shapes: &[(String, Vec<i64>)], iterations: usize) -> Result<()> {
+        let inputs = bench::resolve_input_shapes(&self.engine, &self.tensors, input_shapes)?
+            .into_iter()
+            .map(|(name, shape)| {
+                let info = &self.tensors[self.index_of(&name).expect("resolved input")];
+                let shape = shape
+                    .iter()
+                    .map(|&d| usize::try_from(d))
+                    .collect::<std::result::Result<Vec<_>, _>>()
+                    .map_err(|_| {
+                        Error::InvalidArgument(format!(
+                            "Warm-up shape {shape:?} of '{name}' is unresolved"
+                        ))
+                    })?;
+                let data = TensorData::zeroed(info.data_type, shape.iter().product())?;
+                Ok(TensorInput { name, shape, data })
+            })
+            .collect::<Result<Vec<_>>>()?;
+        self.validate_inputs(&inputs)?;
+
+        let _exclusive = self.exclusive.lock().unwrap_or_else(|e| e.into_inner());
+        let _device = DeviceGuard::new(self.device)?;
+        let mut slots: Vec<_> = (0..self.slots.len())
+            .map(|_| self.slots.acquire())
+            .collect();
+        for _ in 0..iterations {
+            let enqueued = slots
+                .iter_mut()
+                .try_for_each(|slot| self.enqueue(slot, &inputs));
+            // Wait for whatever was queued, even after a failure
+            for slot in &slots {
+                slot.stream.synchronize()?;
+            }
+            enqueued?;
+        }
+        Ok(())
+    }
+
+    /// Describe the IO tensors in engine order
+    pub fn tensors(&self) -> &[TensorInfo] {
+        &self.tensors
+    }
+
+    /// Iterate over the engine inputs
+    pub fn inputs(&self) -> impl Iterator<Item = &TensorInfo> {
+        self.tensors.iter().filter(|t| t.is_input())
+    }
+
+    /// Iterate over the engine outputs
+    pub fn outputs(&self) -> impl Iterator<Item = &TensorInfo> {
+        self.tensors.iter().filter(|t| !t.is_input())
+    }
+
+    /// Run inference and return freshly allocated outputs
+    pub fn run(&self, inputs: &[TensorInput]) -> Result<Vec<TensorOutput>> {
+        let mut outputs = Vec::new();
+        self.run_into(inputs, &mut outputs)?;
+        Ok(outputs)
+    }
+
+    /// Run inference, reusing the allocations already held by `outputs`
+    ///
+    /// Once a context has seen a given set of input shapes, a run with the
+    /// same shapes allocates nothing on the device or host apart from
+    /// growing `outputs` if it is too small.
+    pub fn run_into(&self, inputs: &[TensorInput], outputs: &mut Vec<TensorOutput>) -> Result<()> {
+        self.validate_inputs(inputs)?;
+
+        let _device = DeviceGuard::new(self.device)?;
+        let mut slot = self.slots.acquire();
+        let slot = &mut *slot;
+        let enqueued = self.enqueue(slot, inputs);
+        // Uploads queued before a failure may still read the staging
+        let synced = slot.stream.synchronize();
+        enqueued?;
+        synced?;
+        self.collect_outputs(slot, outputs)
+    }
+
+    /// Run inference without blocking the calling thread
+    ///
+    /// Waiting for a free execution context and for the GPU both happen
+    /// asynchronously; the future is woken by a host function queued behind
+    /// the run on the context's stream, so many runs can be in flight from a
+    /// few executor threads. Dropping the future after the work has been
+    /// queued blocks until that work is done, so its buffers are never
+    /// reused while the GPU still uses them.
+    pub async fn run_async(&self, inputs: &[TensorInput]) -> Result<Vec<TensorOutput>> {
+        self.validate_inputs(inputs)?;
+
+        let mut slot = self.slots.acquire_async().await;
+        let slot = &mut *slot;
+        {
+            // Not held across the await: the future may resume on another thread
+            let _device = DeviceGuard::new(self.device)?;
+            if let Err(e) = self.enqueue(slot, inputs) {
+                // Uploads queued before the failure may still read the staging
+                let _ = slot.stream.synchronize();
+                return Err(e);
+            }
+        }
+        {
+            let in_flight = SyncOnDrop(&slot.stream);
+            slot.stream.completion()?.await;
+            std::mem::forget(in_flight);
+        }
+        // Already complete; this only surfaces errors from the queued work
+        slot.stream.synchronize()?;
+
+        let mut outputs = Vec::new();
+        self.collect_outputs(slot, &mut outputs)?;
+        Ok(outputs)
+    }
+
+    /// Run inference directly on caller-owned memory
+    ///
+    /// Every engine input and output is bound by name to the memory behind
+    /// its view, so nothing is staged or copied: device buffers filled by a
+    /// decoder or preprocessing kernel are read in place, and mapped pinned
+    /// memory lets integrated GPUs work on host memory directly. Output
+    /// views must hold at least the bytes the outputs need at these input
+    /// shapes. Returns once the run is complete, so the views may be reused
+    /// right away.
+    pub fn run_views(
+        &self,
+        inputs: &[(&str, TensorView<'_>)],
+        outputs: &mut [(&str, TensorViewMut<'_>)],
+    ) -> Result<()> {
+        let shapes = self.validate_views(inputs, outputs)?;
+
+        let _device = DeviceGuard::new(self.device)?;
+        let mut slot = self.slots.acquire();
+        let slot = &mut *slot;
+        self.prepare_shapes(slot, &shapes)?;
+
+        // The staged buffers are unbound from here on
+        slot.bound = None;
+        for (name, view) in inputs {
+            let index = self.index_of(name).expect("validated above");
+            unsafe {
+                slot.context
+                    .set_tensor_address_at(index, view.as_ptr() as *mut std::ffi::c_void)?;
+            }
+        }
+        for (name, view) in outputs.iter() {
+            let index = self.index_of(name).expect("validated above");
+            let info = &self.tensors[index];
+            let shape = slot.context.get_tensor_shape_at(index)?;
+            let needed = info.size_in_bytes_for(&shape).unwrap_or(0);
+            if view.capacity() < needed {
+                return Err(Error::InvalidArgument(format!(
+                    "Output '{name}' of shape {shape:?} needs {needed} bytes, view holds {}",
+                    view.capacity()
+                )));
+            }
+            unsafe {
+                slot.context.set_tensor_address_at(index, view.as_ptr())?;
+            }
+        }
+
+        let in_flight = SyncOnDrop(&slot.stream);
+        unsafe {
+            slot.context.enqueue_v3(&slot.stream)?;
+        }
+        std::mem::forget(in_flight);
+        slot.stream.synchronize()
+    }
+
+    /// Swap in the weights of an ONNX model with the same graph, keeping the engine warm
+    ///
+    /// The session must have been built with [`SessionConfig::refittable`]
+    /// (or loaded from a refittable plan). Waits for the runs in flight and
+    /// holds every context while the weights change, so no run sees a mix
+    /// of old and new weights; captured CUDA graphs are dropped and
+    /// recaptured on later runs.
+    pub fn refit_from_onnx(&self, onnx_bytes: &[u8]) -> Result<()> {
+        let _exclusive = self.exclusive.lock().unwrap_or_else(|e| e.into_inner());
+        let mut slots: Vec<_> = (0..self.slots.len())
+            .map(|_| self.slots.acquire())
+            .collect();
+
+        let mut refitter = Refitter::new(&self.engine, &self._logger)?;
+        refitter.set_weights_from_onnx(onnx_bytes)?;
+        refitter.refit()?;
+
+        if self.cuda_graphs {
+            for slot in &mut slots {
+                slot.context.disable_cuda_graphs()?;
+                slot.context.enable_cuda_graphs(self.max_shape_buckets)?;
+            }
+        }
+        Ok(())
+    }
+
+    /// Prepare `slot` for the shapes of `inputs` and queue copies, inference and readback
+    ///
+    /// The run's buffers are those of the bucket `slot.scratch.key`; its
+    /// output staging is valid once the slot's stream has been synchronized.
+    fn enqueue(&self, slot: &mut SessionSlot, inputs: &[TensorInput]) -> Result<()> {
+        let scratch = &mut slot.scratch;
+        scratch.inputs.clear();
+        scratch.inputs.resize(self.tensors.len(), None);
+        for (position, input) in inputs.iter().enumerate() {
+            scratch.inputs[self.index_of(&input.name).expect("validated")] = Some(position);
+        }
+        scratch.shapes.resize_with(self.tensors.len(), || None);
+        for (shape, input) in scratch.shapes.iter_mut().zip(&scratch.inputs) {
+            match input {
+                Some(position) => {
+                    let shape = shape.get_or_insert_with(Vec::new);
+                    shape.clear();
+                    shape.extend(inputs[*position].shape.iter().map(|&d| d as i64));
+                }
+                None => *shape = None,
+            }
+        }
+
+        let shapes = std::mem::take(&mut slot.scratch.shapes);
+        let prepared = self.prepare_shapes(slot, &shapes);
+        slot.scratch.shapes = shapes;
+        prepared?;
+
+        let key = std::mem::take(&mut slot.scratch.key);
+        let enqueued = self.enqueue_bucket(slot, &key, inputs);
+        slot.scratch.key = key;
+        enqueued
+    }
+
+    /// Queue the run of `inputs` on the buffers of the bucket `key`
+    fn enqueue_bucket(
+        &self,
+        slot: &mut SessionSlot,
+        key: &BucketKey,
+        inputs: &[TensorInput],
+    ) -> Result<()> {
+        self.ensure_bucket(slot, key)?;
+        slot.clock += 1;
+        let bucket = slot.buckets.get_mut(key).expect("inserted above");
+        bucket.last_used = slot.clock;
+
+        // Rebinding is only needed when the bucket changed since the last run
+        let rebind = slot.bound.as_ref() != Some(key);
+        let mut batch = recycle_bindings(std::mem::take(&mut slot.scratch.bindings));
+        for (index, (((info, binding), input), &size)) in self
+            .tensors
+            .iter()
+            .zip(bucket.bindings.iter_mut())
+            .zip(&slot.scratch.inputs)
+            .zip(&bucket.sizes)
+            .enumerate()
+        {
+            let mut tensor = TensorBinding::new(index);
+            if rebind {
+                tensor = tensor.address(binding.device.as_ptr());
+            }
+            let staged = &mut binding.staging.as_mut_slice()[..size];
+            if let Some(position) = input {
+                let input = &inputs[*position];
+                // Converts in the same pass if the caller's float type differs
+                data::convert_into(&input.data, info.data_type, staged, input.data.len())?;
+                tensor = tensor.upload(staged);
+            } else if !info.is_input() {
+                tensor = tensor.download(staged);
+            }
+            batch.push(tensor);
+        }
+
+        // The context may hold part of the new addresses even if the call
+        // fails, so the slot only counts as bound once it succeeds
+        if rebind {
+            slot.bound = None;
+        }
+        // SAFETY: the device buffers and staging are owned by the slot and
+        // outlive the sync the callers do before touching them again
+        let enqueued = unsafe { slot.context.bind_and_enqueue(&batch, &slot.stream, false) };
+        slot.scratch.bindings = recycle_bindings(batch);
+        enqueued?;
+        if rebind {
+            slot.bound = Some(key.clone());
+        }
+
+        Ok(())
+    }
+
+    /// Switch `slot` to a profile covering `shapes` and set them on its context
+    ///
+    /// `shapes` holds the input shapes in engine tensor order (None for
+    /// outputs). Leaves the profile and the input shapes alone in
+    /// `slot.scratch.key`.
+    fn prepare_shapes(&self, slot: &mut SessionSlot, shapes: &[Option<Vec<i64>>]) -> Result<()> {
+        let profile = self.select_profile(slot.profile, shapes)?;
+        if profile != slot.profile {
+            slot.context
+                .set_optimization_profile_async(profile, &slot.stream)?;
+            slot.profile = profile;
+            slot.context_shapes = None;
+            slot.bound = None;
+        }
+
+        let key = &mut slot.scratch.key;
+        key.profile = profile;
+        let input_shapes = shapes.iter().flatten();
+        key.input_shapes
+            .resize_with(input_shapes.clone().count(), Vec::new);
+        for (dst, src) in key.input_shapes.iter_mut().zip(input_shapes) {
+            dst.clone_from(src);
+        }
+
+        if slot.context_shapes.as_ref() != Some(&slot.scratch.key.input_shapes) {
+            for (index, (info, shape)) in self.tensors.iter().zip(shapes).enumerate() {
+                if let (Some(shape), false) = (shape, info.is_static()) {
+                    slot.context.set_input_shape_at(index, shape)?;
+                }
+            }
+            match &mut slot.context_shapes {
+                Some(context_shapes) => context_shapes.clone_from(&slot.scratch.key.input_shapes),
+                None => slot.context_shapes = Some(slot.scratch.key.input_shapes.clone()),
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Copy a finished run's results out of the staging buffers into `outputs`
+    fn collect_outputs(&self, slot: &SessionSlot, outputs: &mut Vec<TensorOutput>) -> Result<()> {
+        let bucket = &slot.buckets[&slot.scratch.key];
+        let mut num_outputs = 0;
+        for ((info, binding), shape) in self
+            .tensors
+            .iter()
+            .zip(&bucket.bindings)
+            .zip(&bucket.shapes)
+        {
+            if info.is_input() {
+                continue;
+            }
+            let volume: usize = shape.iter().map(|&d| d as usize).product();
+
+            if num_outputs == outputs.len() {
+                outputs.push(TensorOutput {
+                    name: String::new(),
+                    shape: Vec::new(),
+                    data: TensorData::zeroed(info.data_type, 0)?,
+                });
+            }
+            let output = &mut outputs[num_outputs];
+            output.name.clone_from(&info.name);
+            output.shape.clear();
+            output.shape.extend(shape.iter().map(|&d| d as usize));
+            output
+                .data
+                .assign_from_bytes(info.data_type, binding.staging.as_slice(), volume)?;
+            num_outputs += 1;
+        }
+        outputs.truncate(num_outputs);
+        Ok(())
+    }
+
+    /// Pick the optimization profile for a run, preferring the active one
+    fn select_profile(&self, current: i32, shapes: &[Option<Vec<i64>>]) -> Result<i32> {
+        if self.profile_ranges.len() <= 1 {
+            return Ok(0);
+        }
+
+        let covers = |profile: usize| {
+            self.profile_ranges[profile]
+                .iter()
+                .zip(shapes)
+                .all(|(range, shape)| match (range, shape) {
+                    (Some((min, max)), Some(shape)) => shape
+                        .iter()
+                        .zip(min.iter().zip(max))
+                        .all(|(d, (lo, hi))| (lo..=hi).contains(&d)),
+                    _ => true,
+                })
+        };
+
+        if covers(current as usize) {
+            return Ok(current);
+        }
+        (0..self.profile_ranges.len())
+            .find(|&profile| covers(profile))
+            .map(|profile| profile as i32)
+            .ok_or_else(|| {
+                Error::InvalidArgument(
+                    "No optimization profile covers the given input shapes".to_string(),
+                )
+            })
+    }
+
+    /// Make sure `slot` has buffers for `key`, evicting its least recently used bucket if full
+    fn ensure_bucket(&self, slot: &mut SessionSlot, key: &BucketKey) -> Result<()> {
+        if slot.buckets.contains_key(key) {
+            return Ok(());
+        }
+
+        if slot.buckets.len() >= self.max_shape_buckets {
+            let oldest = slot
+                .buckets
+                .iter()
+                .min_by_key(|(_, bucket)| bucket.last_used)
+                .map(|(key, _)| key.clone());
+            if let Some(oldest) = oldest {
+                if slot.bound.as_ref() == Some(&oldest) {
+                    slot.bound = None;
+                }
+                slot.buckets.remove(&oldest);
+            }
+        }
+
+        let bucket = ShapeBucket::new(&self.tensors, &slot.context, &self.allocator)?;
+        slot.buckets.insert(key.clone(), bucket);
+        Ok(())
+    }
+
+    /// Look up the engine order index of a tensor by name
+    fn index_of(&self, name: &str) -> Option<usize> {
+        // Built in `with_engine`, so this is a hash lookup
+        self.engine.binding_table().ok()?.index_of(name)
+    }
+
+    /// Look up an engine tensor by name
+    fn tensor(&self, name: &str) -> Option<&TensorInfo> {
+        self.index_of(name).map(|index| &self.tensors[index])
+    }
+
+    /// Check views against the engine's tensors, returning input shapes in engine order
+    fn validate_views(
+        &self,
+        inputs: &[(&str, TensorView<'_>)],
+        outputs: &[(&str, TensorViewMut<'_>)],
+    ) -> Result<Vec<Option<Vec<i64>>>> {
+        let bound = inputs
+            .iter()
+            .map(|(name, view)| (*name, view.shape(), view.data_type(), true))
+            .chain(
+                outputs
+                    .iter()
+                    .map(|(name, view)| (*name, view.shape(), view.data_type(), false)),
+            );
+
+        for (name, shape, data_type, is_input) in bound {
+            let info = self
+                .tensor(name)
+                .filter(|t| t.is_input() == is_input)
+                .ok_or_else(|| {
+                    let role = if is_input { "input" } else { "output" };
+                    Error::InvalidArgument(format!("'{name}' is not an engine {role}"))
+                })?;
+            if data_type != info.data_type {
+                return Err(Error::InvalidArgument(format!(
+                    "View for '{name}' is {data_type:?}, engine expects {:?}",
+                    info.data_type
+                )));
+            }
+            let shape_matches = !is_input
+                || (shape.len() == info.shape.len()
+                    && shape
+                        .iter()
+                        .zip(&info.shape)
+                        .all(|(&given, &expected)| expected < 0 || given == expected));
+            if !shape_matches {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{name}' has shape {shape:?}, engine expects {:?}",
+                    info.shape
+                )));
+            }
+        }
+
+        // Every name was found above, so these index the engine's tensors
+        let mut input_views = vec![None; self.tensors.len()];
+        for (name, view) in inputs {
+            input_views[self.index_of(name).expect("validated above")] = Some(view);
+        }
+        let mut has_output = vec![false; self.tensors.len()];
+        for (name, _) in outputs {
+            has_output[self.index_of(name).expect("validated above")] = true;
+        }
+
+        self.tensors
+            .iter()
+            .enumerate()
+            .map(|(index, info)| {
+                if info.is_input() {
+                    let view = input_views[index].ok_or_else(|| {
+                        Error::InvalidArgument(format!("Missing input '{}'", info.name))
+                    })?;
+                    Ok(Some(view.shape().to_vec()))
+                } else if has_output[index] {
+                    Ok(None)
+                } else {
+                    Err(Error::InvalidArgument(format!(
+                        "Missing output '{}'",
+                        info.name
+                    )))
+                }
+            })
+            .collect()
+    }
+
+    /// Check caller inputs against the engine's tensor descriptions
+    fn validate_inputs(&self, inputs: &[TensorInput]) -> Result<()> {
+        for input in inputs {
+            let index = self.index_of(&input.name);
+            let info = index
+                .map(|index| &self.tensors[index])
+                .filter(|t| t.is_input())
+                .ok_or_else(|| {
+                    Error::InvalidArgument(format!("'{}' is not an engine input", input.name))
+                })?;
+
+            let shape_matches = input.shape.len() == info.shape.len()
+                && input
+                    .shape
+                    .iter()
+                    .zip(&info.shape)
+                    .all(|(&given, &expected)| expected < 0 || given as i64 == expected);
+            if !shape_matches {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{}' has shape {:?}, engine expects {:?}",
+                    input.name, input.shape, info.shape
+                )));
+            }
+            if input.data.len() != input.shape.iter().product::<usize>() {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{}' has {} values for shape {:?}",
+                    input.name,
+                    input.data.len(),
+                    input.shape
+                )));
+            }
+            if !data::can_convert(input.data.data_type(), info.data_type) {
+                return Err(Error::InvalidArgument(format!(
+                    "Input '{}' holds {:?} values, engine expects {:?}",
+                    input.name,
+                    input.data.data_type(),
+                    info.data_type
+                )));
+            }
+        }
+
+        if let Some(info) = self
+            .tensors
+            .iter()
+            .find(|info| info.is_input() && !inputs.iter().any(|input| input.name == info.name))
+        {
+            return Err(Error::InvalidArgument(format!(
+                "Missing input '{}'",
+                info.name
+            )));
+        }
+
+        for info in self.outputs() {
+            data::check_host_type(info.data_type)?;
+        }
+
+        Ok(())
+    }
+}
+
+/// Reuse the allocation of an emptied binding list for bindings of another lifetime
+fn recycle_bindings<'b>(mut bindings: Vec<TensorBinding<'_>>) -> Vec<TensorBinding<'b>> {
+    bindings.clear();
+    let mut bindings = std::mem::ManuallyDrop::new(bindings);
+    // SAFETY: the vector is empty, and the element types differ only in lifetime
+    unsafe {
+        Vec::from_raw_parts(
+            bindings.as_mut_ptr() as *mut TensorBinding<'b>,
+            0,
+            bindings.capacity(),
+        )
+    }
+}
+
+// The runtime is only used during construction; every other field is Sync
+unsafe impl Sync for InferenceSession {}
+
+/// Blocks until a stream is idle when dropped; forgotten once the work is known to be done
+struct SyncOnDrop<'a>(&'a CudaStream);
+
+impl Drop for SyncOnDrop<'_> {
+    fn drop(&mut self) {
+        let _ = self.0.synchronize();
+    }
+}
+
+/// Create a builder config carrying the session's build settings
+fn create_builder_config(builder: &Builder<'_>, config: &SessionConfig) -> Result<BuilderConfig> {
+    let mut builder_config = builder.create_config()?;
+    builder_config.set_memory_pool_limit(MemoryPoolType::Workspace, config.workspace_size)?;
+    if config.weight_streaming.is_some() {
+        builder_config.set_flag(BuilderFlag::WeightStreaming, true)?;
+    }
+    if config.refittable {
+        builder_config.set_flag(BuilderFlag::Refit, true)?;
+    }
+
+    for ranges in &config.optimization_profiles {
+        let mut profile = builder.create_optimization_profile()?;
+        for range in ranges {
+            profile.set_shape_range(&range.input, &range.min, &range.opt, &range.max)?;
+        }
+        builder_config.add_optimization_profile(&profile)?;
+    }
+
+    Ok(builder_config)
+}
+
+/// Parse ONNX bytes and build a serialized plan with `builder_config`
+fn build_plan(
+    builder: &Builder<'_>,
+    logger: &Logger,
+    source: OnnxSource<'_>,
+    builder_config: &BuilderConfig,
+) -> Result<HostMemory> {
+    // Create network with explicit batch; weight streaming needs a strongly typed one
+    let mut flags = network_flags::EXPLICIT_BATCH;
+    if builder_config.get_flag(BuilderFlag::WeightStreaming) {
+        flags |= network_flags::STRONGLY_TYPED;
+    }
+    let network = builder.create_network(flags)?;
+
+    // Parse ONNX model
+    let parser = OnnxParser::new(&network, logger)?;
+    match source {
+        OnnxSource::Bytes(bytes) => parser.parse(bytes)?,
+        OnnxSource::File(path) => parser.parse_mapped(path, 0)?,
+    }
+
+    builder.build_serialized_network(&network, builder_config)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::tensor::DataType;
+
+    fn mock_input() -> TensorInput {
+        TensorInput {
+            name: "input".to_string(),
+            shape: vec![1, 3, 224, 224],
+            data: vec![0.5f32; 3 * 224 * 224].into(),
+        }
+    }
+
+    #[test]
+    fn test_session_reuses_outputs() {
+        let logger = Logger::stderr().unwrap();
+        let session =
+            InferenceSession::from_onnx(logger, &[0u8; 100], SessionConfig::default()).unwrap();
+        assert_eq!(session.inputs().count(), 1);
+        assert_eq!(session.outputs().next().unwrap().shape, vec![-1, 1000]);
+
+        let inputs = vec![mock_input()];
+        let mut outputs = session.run(&inputs).unwrap();
+        assert_eq!(outputs.len(), 1);
+        assert_eq!(outputs[0].name, "output");
+
+        let data_ptr = outputs[0].data.as_bytes().as_ptr();
+        session.run_into(&inputs, &mut outputs).unwrap();
+        assert_eq!(outputs[0].data.as_bytes().as_ptr(), data_ptr);
+    }
+
+    #[test]
+    fn test_session_concurrent_runs() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            num_contexts: 2,
+            ..SessionConfig::default()
+        };
+        let session = InferenceSession::from_plan(logger, &[0u8; 16], config).unwrap();
+
+        std::thread::scope(|scope| {
+            for _ in 0..4 {
+                scope.spawn(|| {
+                    let outputs = session.run(&[mock_input()]).unwrap();
+                    assert_eq!(outputs.len(), 1);
+                });
+            }
+        });
+    }
+
+    #[test]
+    fn test_session_engine_cache() {
+        let dir = std::env::temp_dir().join(format!("trtx-session-cache-{}", std::process::id()));
+        let _ = std::fs::remove_dir_all(&dir);
+        let config = SessionConfig {
+            engine_cache: Some(EngineCache::new(&dir).unwrap()),
+            ..SessionConfig::default()
+        };
+
+        let session =
+            InferenceSession::from_onnx(Logger::stderr().unwrap(), &[1u8; 100], config.clone())
+                .unwrap();
+        drop(session);
+        let cached: Vec<_> = std::fs::read_dir(&dir).unwrap().collect();
+        assert_eq!(cached.len(), 1);
+
+        // Second start deserializes the cached plan
+        let session =
+            InferenceSession::from_onnx(Logger::stderr().unwrap(), &[1u8; 100], config).unwrap();
+        assert_eq!(session.tensors().len(), 2);
+        assert_eq!(std::fs::read_dir(&dir).unwrap().count(), 1);
+
+        std::fs::remove_dir_all(&dir).unwrap();
+    }
+
+    #[test]
+    fn test_session_validates_inputs() {
+        let logger = Logger::stderr().unwrap();
+        let session =
+            InferenceSession::from_plan(logger, &[0u8; 16], SessionConfig::default()).unwrap();
+
+        assert!(session.run(&[]).is_err());
+
+        let mut wrong_shape = mock_input();
+        wrong_shape.shape = vec![1, 3, 224, 225];
+        assert!(session.run(&[wrong_shape]).is_err());
+
+        let mut short_data = mock_input();
+        short_data.data = TensorData::Float(vec![0.5; 3 * 224 * 224 - 1]);
+        assert!(session.run(&[short_data]).is_err());
+
+        let mut int_data = mock_input();
+        int_data.data = TensorData::Int64(vec![1; 3 * 224 * 224]);
+        assert!(session.run(&[int_data]).is_err());
+
+        // Half-precision data for a float input is widened on the host
+        let mut half_data = mock_input();
+        half_data.data = half_data.data.to_type(DataType::Half).unwrap();
+        let outputs = session.run(&[half_data]).unwrap();
+        assert_eq!(outputs[0].data.data_type(), DataType::Float);
+
+        let outputs = session.run(&[mock_input()]).unwrap();
+        assert_eq!(outputs[0].shape, vec![1, 1000]);
+        assert_eq!(outputs[0].data.len(), 1000);
+    }
+
+    #[test]
+    fn test_session_dynamic_batch() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            max_shape_buckets: 2,
+            optimization_profiles: vec![vec![ShapeRange {
+                input: "input".to_string(),
+                min: vec![1, 3, 224, 224],
+                opt: vec![4, 3, 224, 224],
+                max: vec![8, 3, 224, 224],
+            }]],
+            ..SessionConfig::default()
+        };
+        let session = InferenceSession::from_onnx(logger, &[0u8; 100], config).unwrap();
+
+        let batch = |n: usize| TensorInput {
+            name: "input".to_string(),
+            shape: vec![n, 3, 224, 224],
+            data: vec![0.5f32; n * 3 * 224 * 224].into(),
+        };
+
+        for n in [1, 4, 2, 4, 1] {
+            let outputs = session.run(&[batch(n)]).unwrap();
+            assert_eq!(outputs[0].shape, vec![n, 1000]);
+            assert_eq!(outputs[0].data.len(), n * 1000);
+        }
+        assert!(session.slots.acquire().buckets.len() <= 2);
+
+        // Beyond the profile's max batch
+        assert!(session.run(&[batch(9)]).is_err());
+    }
+
+    #[test]
+    fn test_session_run_views() {
+        let logger = Logger::stderr().unwrap();
+        let session =
+            InferenceSession::from_onnx(logger, &[0u8; 100], SessionConfig::default()).unwrap();
+
+        let input = DeviceBuffer::new(2 * 3 * 224 * 224 * 4).unwrap();
+        let mut output = PinnedHostBuffer::mapped(2 * 1000 * 4).unwrap();
+        let input_view =
+            TensorView::from_device_buffer(&input, &[2, 3, 224, 224], DataType::Float).unwrap();
+        let output_view =
+            TensorViewMut::from_mapped(&mut output, &[2, 1000], DataType::Float).unwrap();
+
+        let mut outputs = [("output", output_view)];
+        session
+            .run_views(&[("input", input_view.clone())], &mut outputs)
+            .unwrap();
+
+        // Staged runs still work on the same context afterwards
+        let staged = session.run(&[mock_input()]).unwrap();
+        assert_eq!(staged[0].shape, vec![1, 1000]);
+
+        // Too small for a batch of 8, wrong type, missing output
+        let input = DeviceBuffer::new(8 * 3 * 224 * 224 * 4).unwrap();
+        let big_input =
+            TensorView::from_device_buffer(&input, &[8, 3, 224, 224], DataType::Float).unwrap();
+        assert!(session
+            .run_views(&[("input", big_input)], &mut outputs)
+            .is_err());
+        let half =
+            TensorView::from_device_buffer(&input, &[2, 3, 224, 224], DataType::Half).unwrap();
+        assert!(session.run_views(&[("input", half)], &mut outputs).is_err());
+        assert!(session
+            .run_views(&[("input", input_view)], &mut [])
+            .is_err());
+    }
+
+    /// Minimal executor for driving session futures in tests
+    fn block_on<F: std::future::Future>(future: F) -> F::Output {
+        struct ThreadWaker(std::thread::Thread);
+        impl std::task::Wake for ThreadWaker {
+            fn wake(self: Arc<Self>) {
+                self.0.unpark();
+            }
+        }
+
+        let waker = Arc::new(ThreadWaker(std::thread::current())).into();
+        let mut cx = std::task::Context::from_waker(&waker);
+        let mut future = std::pin::pin!(future);
+        loop {
+            if let std::task::Poll::Ready(output) = future.as_mut().poll(&mut cx) {
+                return output;
+            }
+            std::thread::park();
+        }
+    }
+
+    #[test]
+    fn test_session_run_async() {
+        let logger = Logger::stderr().unwrap();
+        let session = Arc::new(
+            InferenceSession::from_onnx(logger, &[0u8; 100], SessionConfig::default()).unwrap(),
+        );
+        let inputs = vec![TensorInput {
+            name: "input".to_string(),
+            shape: vec![2, 3, 224, 224],
+            data: vec![0.5f32; 2 * 3 * 224 * 224].into(),
+        }];
+
+        fn assert_send<T: Send>(_: &T) {}
+        let future = session.run_async(&inputs);
+        assert_send(&future);
+
+        let outputs = block_on(future).unwrap();
+        assert_eq!(outputs[0].shape, vec![2, 1000]);
+
+        // More runs in flight than contexts: the rest wait asynchronously
+        let runs = (0..4)
+            .map(|_| session.run_async(&inputs))
+            .collect::<Vec<_>>();
+        for run in runs {
+            assert_eq!(block_on(run).unwrap()[0].data.len(), 2000);
+        }
+    }
+
+    #[test]
+    fn test_session_weight_streaming() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            weight_streaming: Some(WeightStreamingBudget::Automatic),
+            ..SessionConfig::default()
+        };
+        let session = InferenceSession::from_onnx(logger, &[0u8; 100], config).unwrap();
+        let info = session.engine().weight_streaming().unwrap();
+        assert_eq!(info.budget, info.automatic_budget);
+        session.run(&[mock_input()]).unwrap();
+    }
+
+    #[test]
+    fn test_session_from_onnx_file() {
+        let path = std::env::temp_dir().join(format!("trtx-session-{}.onnx", std::process::id()));
+        std::fs::write(&path, [0u8; 100]).unwrap();
+        let logger = Logger::stderr().unwrap();
+        let session =
+            InferenceSession::from_onnx_file(logger, &path, SessionConfig::default()).unwrap();
+        std::fs::remove_file(&path).unwrap();
+        assert_eq!(
+            session.run(&[mock_input()]).unwrap()[0].shape,
+            vec![1, 1000]
+        );
+    }
+
+    #[test]
+    fn test_session_saves_runtime_cache() {
+        let path =
+            std::env::temp_dir().join(format!("trtx-session-{}.rtcache", std::process::id()));
+        let config = SessionConfig {
+            num_contexts: 2,
+            runtime_cache_path: Some(path.clone()),
+            ..SessionConfig::default()
+        };
+        let session =
+            InferenceSession::from_plan(Logger::stderr().unwrap(), &[0u8; 16], config).unwrap();
+        session.save_runtime_cache().unwrap();
+        let empty = std::fs::read(&path).unwrap();
+        session.run(&[mock_input()]).unwrap();
+        drop(session);
+
+        let saved = std::fs::read(&path).unwrap();
+        std::fs::remove_file(&path).unwrap();
+        assert_ne!(saved, empty);
+    }
+
+    #[test]
+    fn test_session_refit_from_onnx() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            num_contexts: 2,
+            refittable: true,
+            ..SessionConfig::default()
+        };
+        let session = InferenceSession::from_onnx(logger, &[0u8; 100], config).unwrap();
+        session.run(&[mock_input()]).unwrap();
+        session.refit_from_onnx(&[1u8; 100]).unwrap();
+        session.run(&[mock_input()]).unwrap();
+        assert!(session.refit_from_onnx(&[]).is_err());
+    }
+
+    #[test]
+    fn test_session_cuda_graphs() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            cuda_graphs: true,
+            ..SessionConfig::default()
+        };
+        let session = InferenceSession::from_onnx(logger, &[0u8; 100], config).unwrap();
+
+        let inputs = [TensorInput {
+            name: "input".to_string(),
+            shape: vec![1, 3, 224, 224],
+            data: vec![0.5f32; 3 * 224 * 224].into(),
+        }];
+        let mut outputs = Vec::new();
+        for _ in 0..4 {
+            session.run_into(&inputs, &mut outputs).unwrap();
+        }
+
+        let stats = session.slots.acquire().context.cuda_graph_stats();
+        assert_eq!((stats.captures, stats.replays), (1, 2));
+    }
+
+    #[test]
+    fn test_session_rejects_zero_contexts() {
+        let logger = Logger::stderr().unwrap();
+        let config = SessionConfig {
+            num_contexts: 0,
+            ..SessionConfig::default()
+        };
+        assert!(InferenceSession::from_plan(logger, &[0u8; 16], config).is_err());
+    }
+}
@@ -0,0 +1,388 @@
+//! Tensor metadata reported by engines
+
+use crate::error::{Error, Result};
+use std::collections::HashMap;
+use std::ffi::{CStr, CString};
+use trtx_sys::TrtxDims;
+
+/// Which end of an optimization profile's shape range to query or set
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum ProfileSelector {
+    /// Smallest shape the profile accepts
+    Min = 0,
+    /// Shape the kernels are tuned for
+    Opt = 1,
+    /// Largest shape the profile accepts
+    Max = 2,
+}
+
+/// Element type of a tensor
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum DataType {
+    /// 32-bit float
+    Float = 0,
+    /// IEEE 16-bit float
+    Half = 1,
+    /// Signed 8-bit integer
+    Int8 = 2,
+    /// Signed 32-bit integer
+    Int32 = 3,
+    /// 8-bit boolean
+    Bool = 4,
+    /// Unsigned 8-bit integer
+    Uint8 = 5,
+    /// 8-bit float (E4M3)
+    Fp8 = 6,
+    /// Brain float 16
+    Bf16 = 7,
+    /// Signed 64-bit integer
+    Int64 = 8,
+    /// Signed 4-bit integer, packed two per byte
+    Int4 = 9,
+    /// 4-bit float (E2M1), packed two per byte
+    Fp4 = 10,
+    /// 8-bit exponent-only scale
+    E8m0 = 11,
+}
+
+impl DataType {
+    /// Convert from the raw `TRTX_DATA_TYPE_*` value
+    pub fn from_raw(value: i32) -> Result<Self> {
+        Ok(match value {
+            0 => DataType::Float,
+            1 => DataType::Half,
+            2 => DataType::Int8,
+            3 => DataType::Int32,
+            4 => DataType::Bool,
+            5 => DataType::Uint8,
+            6 => DataType::Fp8,
+            7 => DataType::Bf16,
+            8 => DataType::Int64,
+            9 => DataType::Int4,
+            10 => DataType::Fp4,
+            11 => DataType::E8m0,
+            _ => return Err(Error::Runtime(format!("Unknown data type: {value}"))),
+        })
+    }
+
+    /// Size of one element in bits
+    pub fn size_in_bits(self) -> usize {
+        match self {
+            DataType::Int4 | DataType::Fp4 => 4,
+            DataType::Int8 | DataType::Bool | DataType::Uint8 | DataType::Fp8 | DataType::E8m0 => 8,
+            DataType::Half | DataType::Bf16 => 16,
+            DataType::Float | DataType::Int32 => 32,
+            DataType::Int64 => 64,
+        }
+    }
+}
+
+/// Whether a tensor is fed to or produced by the engine
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum TensorIOMode {
+    /// Not an IO tensor
+    None = 0,
+    /// Engine input
+    Input = 1,
+    /// Engine output
+    Output = 2,
+}
+
+impl TensorIOMode {
+    /// Convert from the raw `TRTX_TENSOR_IO_MODE_*` value
+    pub fn from_raw(value: i32) -> Result<Self> {
+        Ok(match value {
+            0 => TensorIOMode::None,
+            1 => TensorIOMode::Input,
+            2 => TensorIOMode::Output,
+            _ => return Err(Error::Runtime(format!("Unknown tensor IO mode: {value}"))),
+        })
+    }
+}
+
+/// Memory layout of a tensor
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(i32)]
+pub enum TensorFormat {
+    /// Row-major, no padding
+    Linear = 0,
+    /// Channels vectorized by 2
+    Chw2 = 1,
+    /// Channels-last, channels padded to 8
+    Hwc8 = 2,
+    /// Channels vectorized by 4
+    Chw4 = 3,
+    /// Channels vectorized by 16
+    Chw16 = 4,
+    /// Channels vectorized by 32
+    Chw32 = 5,
+    /// 3D channels-last, channels padded to 8
+    Dhwc8 = 6,
+    /// 3D channels vectorized by 32
+    Cdhw32 = 7,
+    /// Channels-last
+    Hwc = 8,
+    /// DLA row-major
+    DlaLinear = 9,
+    /// DLA channels-last, channels padded to 4
+    DlaHwc4 = 10,
+    /// Channels-last, channels padded to 16
+    Hwc16 = 11,
+    /// 3D channels-last
+    Dhwc = 12,
+}
+
+impl TensorFormat {
+    /// Convert from the raw `TRTX_TENSOR_FORMAT_*` value
+    pub fn from_raw(value: i32) -> Result<Self> {
+        Ok(match value {
+            0 => TensorFormat::Linear,
+            1 => TensorFormat::Chw2,
+            2 => TensorFormat::Hwc8,
+            3 => TensorFormat::Chw4,
+            4 => TensorFormat::Chw16,
+            5 => TensorFormat::Chw32,
+            6 => TensorFormat::Dhwc8,
+            7 => TensorFormat::Cdhw32,
+            8 => TensorFormat::Hwc,
+            9 => TensorFormat::DlaLinear,
+            10 => TensorFormat::DlaHwc4,
+            11 => TensorFormat::Hwc16,
+            12 => TensorFormat::Dhwc,
+            _ => return Err(Error::Runtime(format!("Unknown tensor format: {value}"))),
+        })
+    }
+}
+
+/// Everything an engine reports about one IO tensor
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct TensorInfo {
+    /// Tensor name
+    pub name: String,
+    /// Dimensions; `-1` marks a dimension only known once input shapes are set
+    pub shape: Vec<i64>,
+    /// Element type
+    pub data_type: DataType,
+    /// Input or output
+    pub io_mode: TensorIOMode,
+    /// Memory layout
+    pub format: TensorFormat,
+    /// Dimension that is vectorized, or `-1` for scalar formats
+    pub vectorized_dim: i32,
+    /// Components packed per vector element (1 for scalar formats)
+    pub components_per_element: i32,
+    /// Bytes per component as reported by the engine
+    pub bytes_per_component: i32,
+}
+
+impl TensorInfo {
+    /// Whether this tensor is an engine input
+    pub fn is_input(&self) -> bool {
+        self.io_mode == TensorIOMode::Input
+    }
+
+    /// Whether every dimension is known without setting input shapes
+    pub fn is_static(&self) -> bool {
+        self.shape.iter().all(|&d| d >= 0)
+    }
+
+    /// Number of elements, or `None` if the shape has runtime dimensions
+    pub fn volume(&self) -> Option<usize> {
+        volume(&self.shape)
+    }
+
+    /// Bytes needed to hold the tensor in its engine layout
+    ///
+    /// Returns `None` if the shape has runtime dimensions.
+    pub fn size_in_bytes(&self) -> Option<usize> {
+        self.size_in_bytes_for(&self.shape)
+    }
+
+    /// Bytes needed to hold the tensor with the concrete `shape`
+    ///
+    /// The vectorized dimension is padded up to a whole vector, as the
+    /// engine expects for formats such as `Chw32`.
+    pub fn size_in_bytes_for(&self, shape: &[i64]) -> Option<usize> {
+        let mut dims = shape
+            .iter()
+            .map(|&d| usize::try_from(d).ok())
+            .collect::<Option<Vec<_>>>()?;
+
+        let components = usize::try_from(self.components_per_element).unwrap_or(1);
+        if let Ok(vectorized) = usize::try_from(self.vectorized_dim) {
+            if components > 1 && vectorized < dims.len() {
+                dims[vectorized] = dims[vectorized].div_ceil(components) * components;
+            }
+        }
+
+        let elements: usize = dims.iter().product();
+        Some((elements * self.data_type.size_in_bits()).div_ceil(8))
+    }
+}
+
+/// IO tensor names of an engine, interned once for binding by index
+///
+/// Built by [`CudaEngine::binding_table`](crate::CudaEngine::binding_table).
+/// Indices follow engine order, as in [`CudaEngine::io_tensors`](crate::CudaEngine::io_tensors),
+/// and the index-based context calls pass the stored NUL-terminated names
+/// straight to TensorRT, so binding a run allocates nothing and never scans
+/// the tensor list.
+#[derive(Debug, Clone)]
+pub struct BindingTable {
+    names: Vec<CString>,
+    modes: Vec<TensorIOMode>,
+    lookup: HashMap<String, usize>,
+}
+
+impl BindingTable {
+    pub(crate) fn new(entries: Vec<(String, TensorIOMode)>) -> Result<Self> {
+        let mut names = Vec::with_capacity(entries.len());
+        let mut modes = Vec::with_capacity(entries.len());
+        let mut lookup = HashMap::with_capacity(entries.len());
+        for (index, (name, mode)) in entries.into_iter().enumerate() {
+            names.push(CString::new(name.as_str())?);
+            modes.push(mode);
+            lookup.insert(name, index);
+        }
+        Ok(BindingTable {
+            names,
+            modes,
+            lookup,
+        })
+    }
+
+    /// Number of IO tensors
+    pub fn len(&self) -> usize {
+        self.names.len()
+    }
+
+    /// Whether the engine has no IO tensors
+    pub fn is_empty(&self) -> bool {
+        self.names.is_empty()
+    }
+
+    /// Index of the tensor called `name`
+    pub fn index_of(&self, name: &str) -> Option<usize> {
+        self.lookup.get(name).copied()
+    }
+
+    /// Name of the tensor at `index`
+    pub fn name(&self, index: usize) -> Option<&str> {
+        // Built from a String, so always valid UTF-8
+        self.names.get(index).and_then(|name| name.to_str().ok())
+    }
+
+    /// NUL-terminated name of the tensor at `index`
+    pub fn c_name(&self, index: usize) -> Option<&CStr> {
+        self.names.get(index).map(CString::as_c_str)
+    }
+
+    /// Whether the tensor at `index` is an input or an output
+    pub fn io_mode(&self, index: usize) -> Option<TensorIOMode> {
+        self.modes.get(index).copied()
+    }
+
+    /// Indices of the engine inputs
+    pub fn inputs(&self) -> impl Iterator<Item = usize> + '_ {
+        (0..self.len()).filter(|&i| self.modes[i] == TensorIOMode::Input)
+    }
+
+    /// Indices of the engine outputs
+    pub fn outputs(&self) -> impl Iterator<Item = usize> + '_ {
+        (0..self.len()).filter(|&i| self.modes[i] == TensorIOMode::Output)
+    }
+
+    /// NUL-terminated name at `index`, or an error if it is out of range
+    pub(crate) fn c_name_checked(&self, index: usize) -> Result<&CStr> {
+        self.c_name(index).ok_or_else(|| {
+            Error::InvalidArgument(format!(
+                "Tensor index {index} out of range for {} IO tensors",
+                self.len()
+            ))
+        })
+    }
+}
+
+/// Convert a shape to the FFI dims struct
+pub(crate) fn to_dims(shape: &[i64]) -> Result<TrtxDims> {
+    let mut dims = TrtxDims::default();
+    if shape.len() > dims.d.len() {
+        return Err(Error::InvalidArgument(format!(
+            "Shape {shape:?} has more than {} dimensions",
+            dims.d.len()
+        )));
+    }
+    dims.nb_dims = shape.len() as i32;
+    dims.d[..shape.len()].copy_from_slice(shape);
+    Ok(dims)
+}
+
+/// Convert the FFI dims struct to a shape
+pub(crate) fn from_dims(dims: &TrtxDims) -> Vec<i64> {
+    let rank = (dims.nb_dims.max(0) as usize).min(dims.d.len());
+    dims.d[..rank].to_vec()
+}
+
+/// Number of elements in `shape`, or `None` if any dimension is negative
+pub(crate) fn volume(shape: &[i64]) -> Option<usize> {
+    shape
+        .iter()
+        .map(|&d| usize::try_from(d).ok())
+        .product::<Option<usize>>()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn info(shape: Vec<i64>, data_type: DataType) -> TensorInfo {
+        TensorInfo {
+            name: "t".to_string(),
+            shape,
+            data_type,
+            io_mode: TensorIOMode::Output,
+            format: TensorFormat::Linear,
+            vectorized_dim: -1,
+            components_per_element: 1,
+            bytes_per_component: (data_type.size_in_bits() / 8) as i32,
+        }
+    }
+
+    #[test]
+    fn test_tensor_size_in_bytes() {
+        assert_eq!(
+            info(vec![1, 1000], DataType::Float).size_in_bytes(),
+            Some(4000)
+        );
+        assert_eq!(info(vec![2, 3], DataType::Half).size_in_bytes(), Some(12));
+        assert_eq!(info(vec![3], DataType::Int4).size_in_bytes(), Some(2));
+        assert_eq!(info(vec![-1, 1000], DataType::Float).size_in_bytes(), None);
+
+        // Channels padded to a multiple of 32
+        let mut chw32 = info(vec![1, 3, 2, 2], DataType::Int8);
+        chw32.format = TensorFormat::Chw32;
+        chw32.vectorized_dim = 1;
+        chw32.components_per_element = 32;
+        assert_eq!(chw32.size_in_bytes(), Some(32 * 4));
+    }
+
+    #[test]
+    fn test_binding_table() {
+        let table = BindingTable::new(vec![
+            ("input".to_string(), TensorIOMode::Input),
+            ("output".to_string(), TensorIOMode::Output),
+        ])
+        .unwrap();
+        assert_eq!(table.len(), 2);
+        assert_eq!(table.index_of("output"), Some(1));
+        assert_eq!(table.index_of("missing"), None);
+        assert_eq!(table.name(0), Some("input"));
+        assert_eq!(table.c_name(1).unwrap().to_bytes_with_nul(), b"output\0");
+        assert_eq!(table.inputs().collect::<Vec<_>>(), vec![0]);
+        assert_eq!(table.outputs().collect::<Vec<_>>(), vec![1]);
+        assert!(table.c_name_checked(2).is_err());
+    }
+}
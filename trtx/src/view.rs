@@ -0,0 +1,252 @@
+//! Borrowed device memory bound straight to engine tensors
+//!
+//! A [`TensorView`] or [`TensorViewMut`] describes memory the caller already
+//! owns: a [`DeviceBuffer`], mapped pinned host memory, or a raw device
+//! pointer produced by another library such as a video decoder. Runs that
+//! take views hand the address to the execution context as is, so nothing is
+//! staged or copied. The lifetime ties the view to the memory it borrows.
+
+use crate::cuda::{DeviceBuffer, PinnedHostBuffer};
+use crate::error::{Error, Result};
+use crate::tensor::{volume, DataType};
+use std::ffi::c_void;
+use std::marker::PhantomData;
+
+/// Read-only tensor in caller-owned device-accessible memory
+#[derive(Debug, Clone)]
+pub struct TensorView<'a> {
+    ptr: *const c_void,
+    capacity: usize,
+    shape: Vec<i64>,
+    data_type: DataType,
+    _memory: PhantomData<&'a [u8]>,
+}
+
+/// Writable tensor in caller-owned device-accessible memory
+#[derive(Debug)]
+pub struct TensorViewMut<'a> {
+    ptr: *mut c_void,
+    capacity: usize,
+    shape: Vec<i64>,
+    data_type: DataType,
+    _memory: PhantomData<&'a mut [u8]>,
+}
+
+/// Bytes a densely packed tensor of `shape` and `data_type` occupies
+fn dense_size(shape: &[i64], data_type: DataType) -> Result<usize> {
+    let elements = volume(shape).ok_or_else(|| {
+        Error::InvalidArgument(format!("View shape {shape:?} has negative dimensions"))
+    })?;
+    Ok((elements * data_type.size_in_bits()).div_ceil(8))
+}
+
+fn check_capacity(shape: &[i64], data_type: DataType, capacity: usize) -> Result<()> {
+    let needed = dense_size(shape, data_type)?;
+    if needed > capacity {
+        return Err(Error::InvalidArgument(format!(
+            "{data_type:?} tensor of shape {shape:?} needs {needed} bytes, memory holds {capacity}"
+        )));
+    }
+    Ok(())
+}
+
+impl<'a> TensorView<'a> {
+    /// View a device buffer as a tensor
+    pub fn from_device_buffer(
+        buffer: &'a DeviceBuffer,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, buffer.size())?;
+        Ok(TensorView {
+            ptr: buffer.as_ptr(),
+            capacity: buffer.size(),
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// View mapped pinned host memory as a tensor the GPU reads in place
+    ///
+    /// The buffer must have been created with
+    /// [`PinnedHostBuffer::mapped`] or a `MAPPED` flag.
+    pub fn from_mapped(
+        buffer: &'a PinnedHostBuffer,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, buffer.size())?;
+        Ok(TensorView {
+            ptr: buffer.device_ptr()?,
+            capacity: buffer.size(),
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// View memory behind a raw device pointer
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must be a device-accessible address holding at least `capacity`
+    /// bytes that stay valid and unmodified for `'a`.
+    pub unsafe fn from_raw(
+        ptr: *const c_void,
+        capacity: usize,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, capacity)?;
+        Ok(TensorView {
+            ptr,
+            capacity,
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// Get the device address
+    pub fn as_ptr(&self) -> *const c_void {
+        self.ptr
+    }
+
+    /// Get the shape
+    pub fn shape(&self) -> &[i64] {
+        &self.shape
+    }
+
+    /// Get the element type
+    pub fn data_type(&self) -> DataType {
+        self.data_type
+    }
+
+    /// Get the number of bytes the viewed memory holds
+    pub fn capacity(&self) -> usize {
+        self.capacity
+    }
+}
+
+impl<'a> TensorViewMut<'a> {
+    /// View a device buffer as a writable tensor
+    pub fn from_device_buffer(
+        buffer: &'a mut DeviceBuffer,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, buffer.size())?;
+        Ok(TensorViewMut {
+            ptr: buffer.as_ptr(),
+            capacity: buffer.size(),
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// View mapped pinned host memory as a tensor the GPU writes in place
+    ///
+    /// The buffer must have been created with
+    /// [`PinnedHostBuffer::mapped`] or a `MAPPED` flag.
+    pub fn from_mapped(
+        buffer: &'a mut PinnedHostBuffer,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, buffer.size())?;
+        Ok(TensorViewMut {
+            ptr: buffer.device_ptr()?,
+            capacity: buffer.size(),
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// View memory behind a raw device pointer
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must be a device-accessible address holding at least `capacity`
+    /// bytes that stay valid for `'a` and are not accessed elsewhere meanwhile.
+    pub unsafe fn from_raw(
+        ptr: *mut c_void,
+        capacity: usize,
+        shape: &[i64],
+        data_type: DataType,
+    ) -> Result<Self> {
+        check_capacity(shape, data_type, capacity)?;
+        Ok(TensorViewMut {
+            ptr,
+            capacity,
+            shape: shape.to_vec(),
+            data_type,
+            _memory: PhantomData,
+        })
+    }
+
+    /// Get the device address
+    pub fn as_ptr(&self) -> *mut c_void {
+        self.ptr
+    }
+
+    /// Get the shape
+    pub fn shape(&self) -> &[i64] {
+        &self.shape
+    }
+
+    /// Get the element type
+    pub fn data_type(&self) -> DataType {
+        self.data_type
+    }
+
+    /// Get the number of bytes the viewed memory holds
+    pub fn capacity(&self) -> usize {
+        self.capacity
+    }
+
+    /// Reborrow as a read-only view, e.g. to feed one run's output to another
+    pub fn as_view(&self) -> TensorView<'_> {
+        TensorView {
+            ptr: self.ptr,
+            capacity: self.capacity,
+            shape: self.shape.clone(),
+            data_type: self.data_type,
+            _memory: PhantomData,
+        }
+    }
+}
+
+// Views are plain descriptors; the borrow they carry governs access
+unsafe impl Send for TensorView<'_> {}
+unsafe impl Sync for TensorView<'_> {}
+unsafe impl Send for TensorViewMut<'_> {}
+unsafe impl Sync for TensorViewMut<'_> {}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_view_capacity_checks() {
+        let mut buffer = DeviceBuffer::new(16).unwrap();
+        let view = TensorView::from_device_buffer(&buffer, &[2, 2], DataType::Float).unwrap();
+        assert_eq!(view.as_ptr(), buffer.as_ptr() as *const c_void);
+        assert_eq!(view.shape(), &[2, 2]);
+
+        assert!(TensorView::from_device_buffer(&buffer, &[5], DataType::Float).is_err());
+        assert!(TensorView::from_device_buffer(&buffer, &[-1, 4], DataType::Float).is_err());
+        assert!(TensorViewMut::from_device_buffer(&mut buffer, &[8], DataType::Half).is_ok());
+    }
+
+    #[test]
+    fn test_mapped_view() {
+        let mut pinned = PinnedHostBuffer::mapped(64).unwrap();
+        let device_ptr = pinned.device_ptr().unwrap();
+        let view = TensorViewMut::from_mapped(&mut pinned, &[16], DataType::Float).unwrap();
+        assert_eq!(view.as_ptr(), device_ptr);
+        assert_eq!(view.as_view().capacity(), 64);
+    }
+}